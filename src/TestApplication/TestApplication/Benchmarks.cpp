@@ -0,0 +1,151 @@
+///////////////////////////////////////////////////////////////////
+//: Title        : Benchmarks.cpp
+//: Product:     : Cpp.Include.Windows
+//: Date         : 2020-05-01
+//: Author       : "Kjetil Kristoffer Solberg" <post@ikjetil.no>
+//: Version      : 1.0.0.0
+//: Descriptions : Benchmark suite for Cpp.Include.Windows headers.
+//
+// #include
+//
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../../include/itsoftware.h"
+
+namespace ItSoftware::CppIncludeWindows::TestApplication
+{
+	//
+	// using
+	//
+	using std::wcout;
+	using std::endl;
+	using std::string;
+	using std::wstring;
+	using std::vector;
+	using ItSoftware::ItsBench;
+	using ItSoftware::ItsString;
+	using ItSoftware::ItsConvert;
+	using ItSoftware::ItsRandom;
+	using ItSoftware::ItsID;
+	using ItSoftware::ItsCreateIDOptions;
+	using ItSoftware::ItsDateTime;
+	using ItSoftware::ItsClockMode;
+	using ItSoftware::ItsDateTimeFormat;
+	using ItSoftware::ItsTimeZone;
+	using ItSoftware::ItsLog;
+	using ItSoftware::Encoding::UTF8;
+
+	//
+	// function prototypes
+	//
+	void RunBenchmarks(const wstring& output);
+
+	//
+	// Function: RunBenchmarks
+	//
+	// (i): Runs the benchmark suite. output is "table", "json" or "csv".
+	//
+	void RunBenchmarks(const wstring& output)
+	{
+		ItsBench bench;
+		bench.EnableCounters();
+
+		//
+		// ItsString
+		//
+		wstring csvLine(L"alpha,beta,gamma,delta,epsilon,zeta,eta,theta,iota,kappa");
+		wstring mixedCase(L"The Quick Brown Fox Jumps Over The Lazy Dog");
+		wstring padded(L"   \t padded text with surrounding white space \r\n");
+		bench.Run(L"ItsString::Split", [&]() { ItsBench::DoNotOptimize(ItsString::Split(csvLine, L",")); });
+		bench.Run(L"ItsString::ToLowerCase", [&]() { ItsBench::DoNotOptimize(ItsString::ToLowerCase(mixedCase)); });
+		bench.Run(L"ItsString::Trim", [&]() { ItsBench::DoNotOptimize(ItsString::Trim(padded)); });
+		bench.Run(L"ItsString::Replace", [&]() { ItsBench::DoNotOptimize(ItsString::Replace(mixedCase, L"The", L"A")); });
+
+		//
+		// ItsConvert
+		//
+		wstring numberText(L"1234567890");
+		vector<uint8_t> payload(4096);
+		for (size_t i = 0; i < payload.size(); i++) {
+			payload[i] = static_cast<uint8_t>(i * 31);
+		}
+		string payloadB64 = ItsConvert::Base64Encode(payload);
+		vector<uint8_t> decoded;
+		bench.Run(L"ItsConvert::ToNumber<int64_t>", [&]() { ItsBench::DoNotOptimize(ItsConvert::ToNumber<int64_t>(numberText)); });
+		bench.Run(L"ItsConvert::ToString<int64_t>", [&]() { ItsBench::DoNotOptimize(ItsConvert::ToString<int64_t>(1234567890)); });
+		bench.Run(L"ItsConvert::Base64Encode 4 KB", [&]() { ItsBench::DoNotOptimize(ItsConvert::Base64Encode(payload)); });
+		bench.Run(L"ItsConvert::Base64Decode 4 KB", [&]() { ItsBench::DoNotOptimize(ItsConvert::Base64Decode(payloadB64, decoded)); });
+
+		//
+		// ItsRandom
+		//
+		bench.Run(L"ItsRandom<int>", [&]() { ItsBench::DoNotOptimize(ItsRandom<int>(0, 1000)); });
+		bench.Run(L"ItsRandom<double>", [&]() { ItsBench::DoNotOptimize(ItsRandom<double>(0.0, 1.0)); });
+
+		//
+		// ItsID
+		//
+		bench.Run(L"ItsID::CreateID 16", [&]() { ItsBench::DoNotOptimize(ItsID::CreateID(16, ItsCreateIDOptions::LowerAndUpperCase, true)); });
+		bench.Run(L"ItsID::CreateULID", [&]() { ItsBench::DoNotOptimize(ItsID::CreateULID()); });
+		bench.Run(L"ItsID::CreateSnowflake", [&]() { ItsBench::DoNotOptimize(ItsID::CreateSnowflake()); });
+
+		//
+		// ItsDateTime
+		//
+		ItsDateTime dateTime = ItsDateTime::Now();
+		bench.Run(L"ItsDateTime::Now", [&]() { ItsBench::DoNotOptimize(ItsDateTime::Now()); });
+		bench.Run(L"ItsDateTime::Now Coarse", [&]() { ItsBench::DoNotOptimize(ItsDateTime::Now(ItsClockMode::Coarse)); });
+		bench.Run(L"ItsDateTime::ToString", [&]() { ItsBench::DoNotOptimize(dateTime.ToString()); });
+		bench.Run(L"ItsDateTime::ToString(pattern)", [&]() { ItsBench::DoNotOptimize(dateTime.ToString(L"dd.MM.yyyy HH:mm:ss")); });
+		static constexpr ItsDateTimeFormat dateTimeFormat(L"dd.MM.yyyy HH:mm:ss");
+		wchar_t dateTimeBuffer[ItsDateTimeFormat::MaxLength];
+		bench.Run(L"ItsDateTime::Format(compiled)", [&]() { ItsBench::DoNotOptimize(dateTime.Format(dateTimeFormat, dateTimeBuffer)); });
+
+		//
+		// ItsTimeZone
+		//
+		ItsTimeZone timeZone;
+		if (ItsTimeZone::Load("Europe/Oslo", &timeZone)) {
+			// About a year of instants, so the lookups cross the DST transitions.
+			vector<ItsDateTime> instants(1024, ItsDateTime::UtcNow());
+			for (size_t i = 1; i < instants.size(); i++) {
+				instants[i] = instants[i - 1];
+				instants[i].AddSeconds(30'817);
+			}
+			size_t next = 0;
+			bench.Run(L"ItsTimeZone::ToLocal", [&]() { ItsBench::DoNotOptimize(timeZone.ToLocal(instants[next++ % instants.size()])); });
+			bench.Run(L"ItsTimeZone::FromLocal", [&]() { ItsBench::DoNotOptimize(timeZone.FromLocal(2024, 10, 27, 2, 30)); });
+		}
+		bench.Run(L"ItsDateTime::AddDays", [&]() { ItsDateTime copy = dateTime; copy.AddDays(1); ItsBench::DoNotOptimize(copy); });
+
+		//
+		// ItsLog
+		//
+		ItsLog log(L"Benchmarks", false);
+		bench.Run(L"ItsLog::LogInformation", [&]() {
+			log.LogInformation(L"Benchmark log entry");
+			if (log.Count() >= 10'000) {
+				log.Clear();
+			}
+		});
+
+		//
+		// Encoding::UTF8
+		//
+		wstring wideText(L"Bl\u00E5b\u00E6rsyltet\u00F8y og \u20AC 100 in a wide string of moderate length");
+		string narrowText = UTF8::ToString(wideText);
+		bench.Run(L"UTF8::ToString(wstring)", [&]() { ItsBench::DoNotOptimize(UTF8::ToString(wideText)); });
+		bench.Run(L"UTF8::ToString(string)", [&]() { ItsBench::DoNotOptimize(UTF8::ToString(narrowText)); });
+
+		if (output == L"json") {
+			wcout << bench.ToJson();
+		}
+		else if (output == L"csv") {
+			wcout << bench.ToCsv();
+		}
+		else {
+			wcout << bench.ToString();
+		}
+	}
+}
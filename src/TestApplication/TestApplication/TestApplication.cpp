@@ -5,6 +5,11 @@
 //: Author       : "Kjetil Kristoffer Solberg" <post@ikjetil.no>
 //: Version      : 1.0.0.0
 //: Descriptions : Implementation of Cpp.Include.Windows Test Application.
+//
+// #define
+//
+#define ITS_PROFILE
+
 //
 // #include
 //
@@ -17,6 +22,7 @@
 #include <io.h>
 #include <fcntl.h>
 #include <chrono>
+#include <unordered_map>
 #include "../../include/itsoftware.h"
 #include "../../include/itsoftware-com.h"
 #include "../../include/itsoftware-exceptions.h"
@@ -32,13 +38,13 @@ namespace ItSoftware::CppIncludeWindows::TestApplication
     using std::endl;
     using std::thread;
     using std::vector;
+    using std::string;
     using std::wstring;
     using std::wstringstream;
     using std::unique_ptr;
     using std::make_unique;
     using std::mutex;
     using std::lock_guard;
-    using ItSoftware::Win::Core::ItsTimer;
     using ItSoftware::Win::Core::ItsTextFile;
     using ItSoftware::Win::Core::ItsFileOpenCreation;
     using ItSoftware::Win::Core::ItsFileTextType;
@@ -49,20 +55,51 @@ namespace ItSoftware::CppIncludeWindows::TestApplication
     using ItSoftware::Win::Core::ItsGuid;
     using ItSoftware::Win::Core::ItsError;
     using ItSoftware::Win::Core::ItsGuidFormat;
+    using ItSoftware::Win::Core::ItsGuidMap;
+    using ItSoftware::Win::Core::ItsGuidSet;
     using ItSoftware::Win::Core::ItsFileMonitor;
     using ItSoftware::Win::Core::ItsFileMonitorMask;
     using ItSoftware::Win::Core::ItsFileMonitorEvent;
     using ItSoftware::ItsTime;
+    using ItSoftware::ItsDuration;
+    using ItSoftware::ItsDurationFormat;
+    using ItSoftware::ItsTimer;
+    using ItSoftware::ItsTimerMode;
+    using ItSoftware::ItsTsc;
+    using ItSoftware::ItsHistogram;
+    using ItSoftware::ItsConcurrentHistogram;
+    using ItSoftware::ItsProfiler;
     using ItSoftware::ItsConvert;
     using ItSoftware::ItsString;
     using ItSoftware::ItsExpandDirection;
     using ItSoftware::ItsRandom;
+    using ItSoftware::ItsRandomEngine;
+    using ItSoftware::ItsRandomRange;
+    using ItSoftware::ItsRandomFill;
+    using ItSoftware::ItsRandomBytes;
+    using ItSoftware::ItsRandomStream;
+    using ItSoftware::ItsReservoirSampler;
+    using ItSoftware::ItsWeightedReservoirSampler;
+    using ItSoftware::ItsShuffle;
+    using ItSoftware::ItsXoshiro256;
+    using ItSoftware::ItsPCG64;
+    using ItSoftware::ItsWyRand;
     using ItSoftware::ItsDateTime;
+    using ItSoftware::ItsClockMode;
+    using ItSoftware::ItsDateTimeFormat;
+    using ItSoftware::ItsTimeZone;
     using ItSoftware::ItsLog;
     using ItSoftware::ItsLogType;
     using ItSoftware::ItsDataSizeStringType;
     using ItSoftware::ItsID;
     using ItSoftware::ItsCreateIDOptions;    
+    using ItSoftware::ItsBase64Variant;
+    using ItSoftware::ItsTimestamp;
+    using ItSoftware::ItsISO8601;
+    using ItSoftware::ItsColor;
+    using ItSoftware::ItsColorFormat;
+    using ItSoftware::ItsHSV;
+    using ItSoftware::ItsPixels;
     using ItSoftware::Exceptions::ItsException;
 
     //
@@ -70,6 +107,7 @@ namespace ItSoftware::CppIncludeWindows::TestApplication
     //
     extern void TestCOM1();
     extern void TestCOM2();
+    extern void RunBenchmarks(const wstring& output);
 
     //
     // Function Prototypes
@@ -80,6 +118,7 @@ namespace ItSoftware::CppIncludeWindows::TestApplication
     void TestItsString();
     void TestItsTimerStart();
     void TestItsTimerStop();
+    void TestItsProfiler();
     void TestItsTextFile();
     void TestItsFile();
     void TestItsEventStart();
@@ -144,6 +183,11 @@ namespace ItSoftware::CppIncludeWindows::TestApplication
     {
         _setmode(_fileno(stdout), _O_U16TEXT);
 
+        if (argc > 1 && wstring(argv[1]) == L"--bench") {
+            RunBenchmarks((argc > 2) ? argv[2] : L"table");
+            return EXIT_SUCCESS;
+        }
+
         atexit(ExitFn);
 
         PrintTestApplicationEvent(L"Started");
@@ -168,6 +212,7 @@ namespace ItSoftware::CppIncludeWindows::TestApplication
         TestItsFileMonitorStop();
         TestItsEventStop();
         TestException();
+        TestItsProfiler();
 
         if (g_eventThread.joinable()) { g_eventThread.join(); }
         TestItsTimerStop();
@@ -260,6 +305,25 @@ namespace ItSoftware::CppIncludeWindows::TestApplication
         wcout << LR"(ItsConvert::ToNumber<unsigned short>(L"40001"))" << endl;
         wcout << L"> " << ItsConvert::ToNumber<unsigned short>(L"40001") << endl;
 
+        PrintTestSubHeader(L"TryToNumber/ParseColumn");
+        double number = 0;
+        wcout << LR"(ItsConvert::TryToNumber(L"1e-5", &number))" << endl;
+        wcout << L"> " << ItsConvert::ToString(ItsConvert::TryToNumber(std::wstring_view(L"1e-5"), &number)) << L" " << number << endl;
+        wcout << LR"(ItsConvert::TryToNumber("-12.34x", &number))" << endl;
+        wcout << L"> " << ItsConvert::ToString(ItsConvert::TryToNumber(std::string_view("-12.34x"), &number)) << endl;
+        vector<std::string_view> column{ "-12.34", "1e-5", "n/a", "6.02214076e23" };
+        vector<double> columnValues(column.size());
+        vector<size_t> failedRows;
+        wcout << LR"(ItsConvert::ParseColumn<double>({ "-12.34", "1e-5", "n/a", "6.02214076e23" }, values, &failedRows))" << endl;
+        wcout << L"> failed: " << ItsConvert::ParseColumn<double>(column, columnValues, &failedRows) << L" row: " << failedRows[0] << L" last: " << columnValues[3] << endl;
+        vector<std::string_view> bigColumn(10'000, "3.25");
+        bigColumn[7'777] = "n/a";
+        vector<double> bigValues(bigColumn.size());
+        vector<size_t> bigFailedRows;
+        size_t bigFailed = ItSoftware::ItsDecimal::ParseColumn(std::span<const std::string_view>(bigColumn), std::span<double>(bigValues), &bigFailedRows, 16);
+        wcout << LR"(ItsDecimal::ParseColumn(10'000 rows, row 7'777 = "n/a", parallelThreshold = 16))" << endl;
+        wcout << L"> failed: " << bigFailed << L" row: " << bigFailedRows[0] << L" last: " << bigValues.back() << endl;
+
         PrintTestSubHeader(L"ToString");
         wcout << LR"(ItsConvert::ToString<int>(-1234))" << endl;
         wcout << LR"(> ")" << ItsConvert::ToString<int>(-1234) << LR"(")" << endl;
@@ -310,9 +374,117 @@ namespace ItSoftware::CppIncludeWindows::TestApplication
         wcout << LR"(ItsConvert::ToLongFromHex("0xFF3333"))" << endl;
         wcout << L"> " << ItsConvert::ToLongFromHex(L"0xFF3333") << endl;
 
+        PrintTestSubHeader(L"ToTM/ToTimestamp");
+        wcout << LR"(ItsConvert::ToString(ItsConvert::ToTM(L"2024-02-29T23:59:58")))" << endl;
+        wcout << LR"(> ")" << ItsConvert::ToString(ItsConvert::ToTM(L"2024-02-29T23:59:58")) << LR"(")" << endl;
+        ItsTimestamp timestamp;
+        wcout << LR"(ItsConvert::ToTimestamp(L"2024-06-01T12:34:56.123456789+05:30", &timestamp))" << endl;
+        wcout << LR"(> )" << ItsConvert::ToString(ItsConvert::ToTimestamp(std::wstring_view(L"2024-06-01T12:34:56.123456789+05:30"), &timestamp)) << LR"( ")" << ItsConvert::ToString(timestamp, 3) << LR"(")" << endl;
+        wcout << LR"(ItsConvert::ToTimestamp(L"2023-02-29T00:00:00", &timestamp))" << endl;
+        wcout << LR"(> )" << ItsConvert::ToString(ItsConvert::ToTimestamp(std::wstring_view(L"2023-02-29T00:00:00"), &timestamp)) << endl;
+        wstring longest(L"2024-06-01T12:34:56.123456789+05:30");
+        wstring tooLong(L"2024-06-01T12:34:56.1234567890+05:30");
+        string longestNarrow(longest.begin(), longest.end());
+        string tooLongNarrow(tooLong.begin(), tooLong.end());
+        wcout << L"ToTimestamp at ItsISO8601::MaxLength (" << ItsISO8601::MaxLength << L") and one past, wide and narrow" << endl;
+        wcout << L"> " << ItsConvert::ToString(ItsConvert::ToTimestamp(std::wstring_view(longest), &timestamp)) << L" " << ItsConvert::ToString(ItsConvert::ToTimestamp(std::string_view(longestNarrow), &timestamp));
+        wcout << L" " << ItsConvert::ToString(ItsConvert::ToTimestamp(std::wstring_view(tooLong), &timestamp)) << L" " << ItsConvert::ToString(ItsConvert::ToTimestamp(std::string_view(tooLongNarrow), &timestamp)) << endl;
+
+        PrintTestSubHeader(L"ToRGB/ItsColor");
+        wcout << LR"(ItsConvert::ToRGB(L"255,128,0"))" << endl;
+        wcout << L"> " << ItsConvert::ToRGB(L"255,128,0") << endl;
+        ItsColor color;
+        wcout << LR"(ItsColor::Parse(L"hsl(210, 50%, 40%)", &color))" << endl;
+        wcout << L"> " << ItsConvert::ToString(ItsColor::Parse(std::wstring_view(L"hsl(210, 50%, 40%)"), &color)) << LR"( ")" << color.ToString() << LR"(" ")" << color.ToString(ItsColorFormat::Hex) << LR"(" ")" << color.ToString(ItsColorFormat::HSL) << LR"(")" << endl;
+        vector<ItsColor> pixels{ ItsColor(255, 0, 0, 128), ItsColor(0, 255, 0), ItsColor(51, 102, 153, 0) };
+        vector<ItsHSV> pixelsHSV(pixels.size());
+        ItsPixels::ToHSV(pixels, pixelsHSV);
+        ItsPixels::Premultiply(pixels, pixels);
+        wcout << L"ItsPixels::ToHSV + ItsPixels::Premultiply" << endl;
+        for (size_t i = 0; i < pixels.size(); i++) {
+            wcout << L"> H=" << pixelsHSV[i].H << L" S=" << pixelsHSV[i].S << L" V=" << pixelsHSV[i].V << L" premultiplied=" << pixels[i].ToString(ItsColorFormat::Hex) << endl;
+        }
+
+        PrintTestSubHeader(L"ToPK/ToString");
+        auto pks = ItsConvert::ToPK(L"1001;1002;;-7;9223372036854775807");
+        wcout << LR"(ItsConvert::ToString(ItsConvert::ToPK(L"1001;1002;;-7;9223372036854775807")))" << endl;
+        wcout << LR"(> ")" << ItsConvert::ToString(pks) << LR"(")" << endl;
+        vector<uint8_t> pkBinary = ItsConvert::ToPKBinary(pks);
+        vector<long long> pksBack;
+        wcout << LR"(ItsConvert::FromPKBinary(ItsConvert::ToPKBinary(pks), pksBack))" << endl;
+        wcout << LR"(> )" << ItsConvert::ToString(ItsConvert::FromPKBinary(pkBinary, pksBack)) << L" " << pkBinary.size() << L" bytes" << endl;
+
+        PrintTestSubHeader(L"Base64Encode/Base64Decode");
+        string b64 = ItsConvert::Base64Encode("Many hands make light work.", 27);
+        wcout << LR"(ItsConvert::Base64Encode("Many hands make light work.", 27))" << endl;
+        wcout << LR"(> ")" << wstring(b64.begin(), b64.end()) << LR"(")" << endl;
+        vector<uint8_t> b64Data;
+        wcout << LR"(ItsConvert::Base64Decode(")" << wstring(b64.begin(), b64.end()) << LR"(", data))" << endl;
+        wcout << LR"(> )" << ItsConvert::ToString(ItsConvert::Base64Decode(b64, b64Data)) << LR"( ")" << wstring(b64Data.begin(), b64Data.end()) << LR"(")" << endl;
+        wcout << LR"(ItsConvert::Base64Decode("TWFu*A==", data))" << endl;
+        wcout << LR"(> )" << ItsConvert::ToString(ItsConvert::Base64Decode("TWFu*A==", b64Data)) << endl;
+        string b64Url = ItsConvert::Base64Encode("\xfb\xff\xbf", 3, ItsBase64Variant::UrlSafeNoPadding);
+        wcout << LR"(ItsConvert::Base64Encode("\xfb\xff\xbf", 3, ItsBase64Variant::UrlSafeNoPadding))" << endl;
+        wcout << LR"(> ")" << wstring(b64Url.begin(), b64Url.end()) << LR"(")" << endl;
+
+        PrintTestSubHeader(L"Base32Encode/Base32Decode");
+        string b32 = ItsConvert::Base32Encode("foobar", 6);
+        wcout << LR"(ItsConvert::Base32Encode("foobar", 6))" << endl;
+        wcout << LR"(> ")" << wstring(b32.begin(), b32.end()) << LR"(")" << endl;
+        vector<uint8_t> b32Data;
+        wcout << LR"(ItsConvert::Base32Decode(")" << wstring(b32.begin(), b32.end()) << LR"(", data))" << endl;
+        wcout << LR"(> )" << ItsConvert::ToString(ItsConvert::Base32Decode(b32, b32Data)) << LR"( ")" << wstring(b32Data.begin(), b32Data.end()) << LR"(")" << endl;
+        wcout << LR"(ItsConvert::Base32Decode("MZXW6===", data), ("MZXW6YQ=========", data), ("========", data))" << endl;
+        wcout << LR"(> )" << ItsConvert::ToString(ItsConvert::Base32Decode("MZXW6===", b32Data)) << L" " << ItsConvert::ToString(ItsConvert::Base32Decode("MZXW6YQ=========", b32Data)) << L" " << ItsConvert::ToString(ItsConvert::Base32Decode("========", b32Data)) << endl;
+
+        PrintTestSubHeader(L"Base64/Base32 Throughput");
+        vector<uint8_t> payload(64 * 1024 * 1024);
+        for (auto& b : payload) {
+            b = static_cast<uint8_t>(ItsRandom<int>(0, 255));
+        }
+        ItsTimer timer;
+        timer.Start();
+        string payloadB64 = ItsConvert::Base64Encode(payload);
+        timer.Stop();
+        wcout << L"Base64Encode 64 MB: " << ItsConvert::ToDataSizeString(payload.size() * 1000 / (timer.GetMilliseconds().count() + 1), 2) << L"/s" << endl;
+        timer.Start();
+        ItsConvert::Base64Decode(payloadB64, payload);
+        timer.Stop();
+        wcout << L"Base64Decode 64 MB: " << ItsConvert::ToDataSizeString(payload.size() * 1000 / (timer.GetMilliseconds().count() + 1), 2) << L"/s" << endl;
+        timer.Start();
+        string payloadB32 = ItsConvert::Base32Encode(payload);
+        timer.Stop();
+        wcout << L"Base32Encode 64 MB: " << ItsConvert::ToDataSizeString(payload.size() * 1000 / (timer.GetMilliseconds().count() + 1), 2) << L"/s" << endl;
+        timer.Start();
+        ItsConvert::Base32Decode(payloadB32, payload);
+        timer.Stop();
+        wcout << L"Base32Decode 64 MB: " << ItsConvert::ToDataSizeString(payload.size() * 1000 / (timer.GetMilliseconds().count() + 1), 2) << L"/s" << endl;
+
         wcout << endl;
     }
 
+    //
+    // Function: TestItsRandomGenerator
+    //
+    // (i): Time raw draws from the per-thread Generator.
+    //
+    template<typename Generator>
+    void TestItsRandomGenerator(const wstring& name)
+    {
+        const size_t count = 100'000'000;
+        auto& gen = ItsRandomEngine<Generator>();
+        uint64_t sum = 0;
+
+        ItsTimer timer;
+        timer.Start();
+        for (size_t i = 0; i < count; i++) {
+            sum += gen();
+        }
+        timer.Stop();
+
+        wcout << name << L": " << static_cast<double>(timer.GetNanoseconds().count()) / count << L" ns/draw (" << (sum & 0xFF) << L")" << endl;
+    }
+
     //
     // Function: TestRandom
     //
@@ -335,6 +507,153 @@ namespace ItSoftware::CppIncludeWindows::TestApplication
         wcout << L"ItsRandom<double>(1, 2)" << endl;
         wcout << L"> " << ItsRandom<double>(1, 2) << endl;
 
+        PrintTestSubHeader(L"Generators");
+        wcout << L"ItsRandom<int, ItsXoshiro256>(1, 6)" << endl;
+        wcout << L"> " << ItsRandom<int, ItsXoshiro256>(1, 6) << endl;
+        wcout << L"ItsRandom<double, ItsPCG64>(0, 1)" << endl;
+        wcout << L"> " << ItsRandom<double, ItsPCG64>(0, 1) << endl;
+        wcout << L"ItsRandom<long long, ItsWyRand>(-100, 100)" << endl;
+        wcout << L"> " << ItsRandom<long long, ItsWyRand>(-100, 100) << endl;
+        wcout << L"ItsRandom<int, std::minstd_rand>(1, 6)" << endl;
+        wcout << L"> " << ItsRandom<int, std::minstd_rand>(1, 6) << endl;
+        wcout << L"ItsRandom<int, std::default_random_engine>(1, 6)" << endl;
+        wcout << L"> " << ItsRandom<int, std::default_random_engine>(1, 6) << endl;
+
+        ItsXoshiro256 a(42);
+        ItsXoshiro256 b(42);
+        b.Jump();
+        wcout << L"ItsXoshiro256(42)() / after Jump()" << endl;
+        wcout << L"> " << a() << L" / " << b() << endl;
+
+        PrintTestSubHeader(L"ItsRandomRange");
+        ItsRandomRange<int> dice(1, 6);
+        wcout << L"ItsRandomRange<int> dice(1, 6); dice() x 10" << endl;
+        wcout << L"> ";
+        for (int i = 0; i < 10; i++) {
+            wcout << dice() << L" ";
+        }
+        wcout << endl;
+
+        PrintTestSubHeader(L"ItsRandomFill/ItsRandomBytes");
+        vector<int> fillInts(8);
+        ItsRandomFill<int>(fillInts, 1, 100, 42);
+        wcout << L"ItsRandomFill<int>(fillInts, 1, 100, 42)" << endl;
+        wcout << L"> ";
+        for (int v : fillInts) {
+            wcout << v << L" ";
+        }
+        wcout << endl;
+
+        bool fillBools[16]{};
+        ItsRandomFill<bool>(fillBools, false, true, 42);
+        wcout << L"ItsRandomFill<bool>(fillBools, false, true, 42)" << endl;
+        wcout << L"> ";
+        for (bool v : fillBools) {
+            wcout << (v ? L"1" : L"0");
+        }
+        wcout << endl;
+
+        vector<std::byte> fillBytes(64 * 1024 * 1024);
+        ItsTimer fillTimer;
+        fillTimer.Start();
+        ItsRandomBytes(fillBytes);
+        fillTimer.Stop();
+        wcout << L"ItsRandomBytes 64 MB: " << ItsConvert::ToDataSizeString(fillBytes.size() * 1000 / (fillTimer.GetMilliseconds().count() + 1), 2) << L"/s" << endl;
+
+        vector<double> fillDoubles(8 * 1024 * 1024);
+        fillTimer.Start();
+        ItsRandomFill<double>(fillDoubles, 0.0, 1.0);
+        fillTimer.Stop();
+        wcout << L"ItsRandomFill<double> 64 MB: " << ItsConvert::ToDataSizeString(fillDoubles.size() * sizeof(double) * 1000 / (fillTimer.GetMilliseconds().count() + 1), 2) << L"/s" << endl;
+
+        PrintTestSubHeader(L"ItsRandomStream");
+        wcout << L"ItsRandomStream(42, 7).Next<int>(1, 100) x 2" << endl;
+        ItsRandomStream s1(42, 7);
+        ItsRandomStream s2(42, 7);
+        wcout << L"> " << s1.Next<int>(1, 100) << L" " << s2.Next<int>(1, 100) << endl;
+        wcout << L"Monte-Carlo pi, 64 work items, one stream each" << endl;
+        const size_t threadCounts[] = { 1, 4 };
+        for (size_t threads : threadCounts) {
+            vector<double> hits(64);
+            vector<thread> workers;
+            for (size_t t = 0; t < threads; t++) {
+                workers.emplace_back([&hits, t, threads]() {
+                    for (size_t item = t; item < hits.size(); item += threads) {
+                        ItsRandomStream stream(2024, item);
+                        for (int i = 0; i < 10'000; i++) {
+                            double x = stream.Next<double>(0, 1);
+                            double y = stream.Next<double>(0, 1);
+                            hits[item] += (x * x + y * y < 1.0) ? 1.0 : 0.0;
+                        }
+                    }
+                });
+            }
+            for (auto& w : workers) {
+                w.join();
+            }
+            double total = 0;
+            for (double h : hits) {
+                total += h;
+            }
+            wcout << L"> " << threads << L" thread(s): " << 4.0 * total / (hits.size() * 10'000.0) << endl;
+        }
+
+        PrintTestSubHeader(L"ItsReservoirSampler/ItsShuffle");
+        ItsReservoirSampler<int> reservoir(5, 42);
+        for (int i = 0; i < 1'000'000; i++) {
+            reservoir.Add(i);
+        }
+        wcout << L"ItsReservoirSampler<int>(5, 42), 1'000'000 items" << endl;
+        wcout << L"> ";
+        for (int v : reservoir.Sample()) {
+            wcout << v << L" ";
+        }
+        wcout << endl;
+
+        ItsWeightedReservoirSampler<wstring> weighted(2, 42);
+        weighted.Add(L"rare", 1.0);
+        weighted.Add(L"common", 50.0);
+        weighted.Add(L"frequent", 100.0);
+        wcout << L"ItsWeightedReservoirSampler<wstring>(2, 42): rare=1, common=50, frequent=100" << endl;
+        wcout << L"> ";
+        for (const auto& v : weighted.Sample()) {
+            wcout << v << L" ";
+        }
+        wcout << endl;
+
+        ItsReservoirSampler<int, std::minstd_rand> narrowReservoir(1'000, 42);
+        for (int i = 0; i < 1'000'000; i++) {
+            narrowReservoir.Add(i);
+        }
+        double narrowMean = 0;
+        for (int v : narrowReservoir.Sample()) {
+            narrowMean += v;
+        }
+        std::minstd_rand unitGen(42);
+        double unitMean = 0;
+        for (int i = 0; i < 1'000'000; i++) {
+            unitMean += ItSoftware::ItsRandomUnit(unitGen);
+        }
+        wcout << L"ItsReservoirSampler<int, std::minstd_rand>(1'000, 42), 1'000'000 items: mean " << narrowMean / 1'000.0 << L" (expected ~500000)" << endl;
+        wcout << L"ItsRandomUnit(std::minstd_rand) x 1'000'000: mean " << unitMean / 1'000'000.0 << L" (expected ~0.5)" << endl;
+
+        vector<uint32_t> indexes(16 * 1024 * 1024);
+        for (size_t i = 0; i < indexes.size(); i++) {
+            indexes[i] = static_cast<uint32_t>(i);
+        }
+        ItsTimer shuffleTimer;
+        shuffleTimer.Start();
+        ItsShuffle<uint32_t>(indexes, 42);
+        shuffleTimer.Stop();
+        wcout << L"ItsShuffle<uint32_t>(16M indexes, 42): " << shuffleTimer.GetMilliseconds().count() << L" ms, first " << indexes[0] << L" " << indexes[1] << L" " << indexes[2] << endl;
+
+        PrintTestSubHeader(L"Generator Throughput");
+        TestItsRandomGenerator<std::mt19937>(L"std::mt19937");
+        TestItsRandomGenerator<std::mt19937_64>(L"std::mt19937_64");
+        TestItsRandomGenerator<ItsXoshiro256>(L"ItsXoshiro256");
+        TestItsRandomGenerator<ItsPCG64>(L"ItsPCG64");
+        TestItsRandomGenerator<ItsWyRand>(L"ItsWyRand");
+
         wcout << endl;
     }
 
@@ -353,6 +672,18 @@ namespace ItSoftware::CppIncludeWindows::TestApplication
         wcout << L"ItsTime::RenderMsToFullString(92481379, true)" << endl;
         wcout << LR"(> ")" << ItsTime::RenderMsToFullString(92481379, true) << LR"(")" << endl;
 
+        PrintTestSubHeader(L"ItsDuration");
+        ItsDuration duration = ItsDuration::FromMilliseconds(92481379);
+        wcout << L"ItsDuration::FromMilliseconds(92481379).ToString(ItsDurationFormat::FullMilliseconds)" << endl;
+        wcout << LR"(> ")" << duration.ToString(ItsDurationFormat::FullMilliseconds) << LR"(")" << endl;
+        wcout << L"ItsDuration::FromMilliseconds(92481379).ToString()" << endl;
+        wcout << LR"(> ")" << duration.ToString() << LR"(")" << endl;
+        wcout << L"ItsDuration::FromMilliseconds(92481379).ToString(ItsDurationFormat::ISO8601)" << endl;
+        wcout << LR"(> ")" << duration.ToString(ItsDurationFormat::ISO8601) << LR"(")" << endl;
+        ItsDuration parsed;
+        wcout << LR"(ItsDuration::Parse(L"1h30m2.5s", &parsed))" << endl;
+        wcout << L"> " << ItsConvert::ToString(ItsDuration::Parse(L"1h30m2.5s", &parsed)) << L" " << parsed.TotalMilliseconds() << L" ms" << endl;
+
         PrintTestSubHeader(L"Now + ToString");
         wcout << L"ItsDateTime::Now().ToString()" << endl;
         wcout << LR"(> ")" << ItsDateTime::Now().ToString() << LR"(")" << endl;
@@ -437,7 +768,88 @@ namespace ItSoftware::CppIncludeWindows::TestApplication
 
         g_timer.Stop();
 
-        wcout << L"Time elapsed: " << ItsTime::RenderMsToFullString(g_timer.GetMilliseconds(), true) << endl;
+        wcout << L"Time elapsed: " << ItsTime::RenderMsToFullString(static_cast<size_t>(g_timer.GetMilliseconds().count()), true) << endl;
+        wcout << endl;
+
+        PrintTestSubHeader(L"Pause and Resume");
+        ItsTimer timer;
+        timer.Start();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        timer.Pause();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        timer.Resume();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        timer.Stop();
+        wcout << L"Run 20 ms, pause 50 ms, run 20 ms" << endl;
+        wcout << L"> " << timer.GetMicroseconds().count() << L" us" << endl;
+
+        PrintTestSubHeader(L"Tsc mode");
+        ItsTimer tscTimer(ItsTimerMode::Tsc);
+        wcout << L"Mode: " << ((tscTimer.Mode() == ItsTimerMode::Tsc) ? L"Tsc" : L"Steady") << L", " << ItsTsc::NanosecondsPerTick() << L" ns/tick" << endl;
+        tscTimer.Start();
+        tscTimer.Stop();
+        wcout << L"Empty Start/Stop" << endl;
+        wcout << L"> " << tscTimer.GetNanoseconds().count() << L" ns" << endl;
+
+        PrintTestSubHeader(L"ItsHistogram");
+        ItsHistogram histogram;
+        tscTimer.Start();
+        for (size_t i = 0; i < 100'000; i++) {
+            tscTimer.Record(histogram);
+        }
+        tscTimer.Stop();
+        wcout << L"100 000 empty laps recorded with ItsTimer::Record (ns)" << endl;
+        wcout << L"> " << histogram.ToString() << endl;
+
+        ItsConcurrentHistogram concurrent;
+        vector<thread> recorders;
+        for (size_t t = 0; t < 4; t++) {
+            recorders.emplace_back([&concurrent, t]() {
+                for (uint64_t i = 0; i < 1'000'000; i++) {
+                    concurrent.Record(i % 10'000 + t);
+                }
+            });
+        }
+        for (auto& recorder : recorders) {
+            recorder.join();
+        }
+        wcout << L"ItsConcurrentHistogram, 4 threads x 1 000 000 values 0-10 002" << endl;
+        wcout << L"> " << concurrent.Snapshot().ToString() << endl;
+        wcout << endl;
+    }
+
+    //
+    // Function: TestItsProfiler
+    //
+    // (i): Tests ITS_PROFILE_SCOPE and ItsProfiler
+    //
+    void TestItsProfiler()
+    {
+        PrintTestHeader(L"ItsProfiler");
+
+        ItsProfiler::Clear();
+        {
+            ITS_PROFILE_SCOPE("TestItsProfiler");
+            for (size_t i = 0; i < 10; i++)
+            {
+                ITS_PROFILE_SCOPE("Base64 1 MB");
+                vector<uint8_t> payload(1024 * 1024, static_cast<uint8_t>(i));
+                string encoded;
+                {
+                    ITS_PROFILE_SCOPE("Encode");
+                    encoded = ItsConvert::Base64Encode(payload);
+                }
+                {
+                    ITS_PROFILE_SCOPE("Decode");
+                    ItsConvert::Base64Decode(encoded, payload);
+                }
+            }
+        }
+
+        wcout << ItsProfiler::Report();
+
+        string trace = ItsProfiler::ToChromeTrace();
+        wcout << L"Chrome trace: " << ItsProfiler::Events().size() << L" events, " << trace.size() << L" bytes" << endl;
         wcout << endl;
     }
 
@@ -801,6 +1213,62 @@ namespace ItSoftware::CppIncludeWindows::TestApplication
             wcout << L"> FAILED: " << ItsError::GetLastErrorDescription() << endl;
         }
 
+        PrintTestSubHeader(L"Parse/FromLiteral");
+        GUID parsed{ 0 };
+        wcout << LR"(ItsGuid::Parse(L"6b29fc40-ca47-1067-b31d-00dd010662da", &parsed))" << endl;
+        wcout << L"> " << ItsConvert::ToString(ItsGuid::Parse(L"6b29fc40-ca47-1067-b31d-00dd010662da", &parsed)) << L" " << ItsGuid::ToString(parsed) << endl;
+        wcout << LR"(ItsGuid::Parse(L"{ 0x6b29fc40, 0xca47, 0x1067, { 0xb1, 0x1d, 0x0, 0xdd, 0x1, 0x6, 0x62, 0xda } }", &parsed))" << endl;
+        wcout << L"> " << ItsConvert::ToString(ItsGuid::Parse(L"{ 0x6b29fc40, 0xca47, 0x1067, { 0xb1, 0x1d, 0x0, 0xdd, 0x1, 0x6, 0x62, 0xda } }", &parsed)) << L" " << ItsGuid::ToString(parsed) << endl;
+        wcout << LR"(ItsGuid::Parse(L"not-a-guid", &parsed))" << endl;
+        wcout << L"> " << ItsConvert::ToString(ItsGuid::Parse(L"not-a-guid", &parsed)) << endl;
+        constexpr GUID literal = ItsGuid::FromLiteral("{6B29FC40-CA47-1067-B31D-00DD010662DA}");
+        wcout << LR"(constexpr GUID literal = ItsGuid::FromLiteral("{6B29FC40-CA47-1067-B31D-00DD010662DA}"))" << endl;
+        wcout << L"> " << ItsGuid::ToString(literal, ItsGuidFormat::ConstFormat) << endl;
+
+        PrintTestSubHeader(L"CreateGuids");
+        vector<GUID> guids(1'000'000);
+        ItsTimer guidTimer;
+        guidTimer.Start();
+        bool guidsCreated = ItsGuid::CreateGuids(guids);
+        guidTimer.Stop();
+        wcout << L"ItsGuid::CreateGuids(1'000'000 guids)" << endl;
+        wcout << L"> " << ItsConvert::ToString(guidsCreated) << L", " << guidTimer.GetMilliseconds().count() << L" ms, last " << ItsGuid::ToString(guids.back()) << endl;
+
+        PrintTestSubHeader(L"ItsGuidMap vs unordered_map<wstring, size_t>");
+        ItsGuidMap<size_t> guidMap;
+        guidTimer.Start();
+        for (size_t i = 0; i < guids.size(); i++) {
+            guidMap.Insert(guids[i], i);
+        }
+        guidTimer.Stop();
+        auto guidMapInsert = guidTimer.GetMilliseconds().count();
+        size_t found = 0;
+        guidTimer.Start();
+        for (size_t i = 0; i < guids.size(); i++) {
+            found += *guidMap.Find(guids[(i * 7919) % guids.size()]);
+        }
+        guidTimer.Stop();
+        wcout << L"ItsGuidMap<size_t>: insert " << guidMapInsert << L" ms, find " << guidTimer.GetMilliseconds().count() << L" ms" << endl;
+
+        std::unordered_map<wstring, size_t> stringMap;
+        guidTimer.Start();
+        for (size_t i = 0; i < guids.size(); i++) {
+            stringMap.emplace(ItsGuid::ToString(guids[i]), i);
+        }
+        guidTimer.Stop();
+        auto stringMapInsert = guidTimer.GetMilliseconds().count();
+        guidTimer.Start();
+        for (size_t i = 0; i < guids.size(); i++) {
+            found += stringMap.find(ItsGuid::ToString(guids[(i * 7919) % guids.size()]))->second;
+        }
+        guidTimer.Stop();
+        wcout << L"unordered_map<wstring, size_t>: insert " << stringMapInsert << L" ms, find " << guidTimer.GetMilliseconds().count() << L" ms (" << (found & 1) << L")" << endl;
+
+        ItsGuidSet guidSet;
+        guidSet.Insert(guids[0]);
+        wcout << L"ItsGuidSet::Contains(guids[0]) / Contains(guids[1])" << endl;
+        wcout << L"> " << ItsConvert::ToString(guidSet.Contains(guids[0])) << L" / " << ItsConvert::ToString(guidSet.Contains(guids[1])) << endl;
+
         wcout << endl;
     }
 
@@ -852,6 +1320,68 @@ namespace ItSoftware::CppIncludeWindows::TestApplication
 
         wcout << L"Custom: " << now.ToString(L"dd.MM.yyyy HH:mm:ss") << endl;
 
+        ItsDateTime endOfJanuary(2024, 1, 31, 12, 0, 0);
+        endOfJanuary.AddMonths(1);
+        wcout << L"ItsDateTime(2024, 1, 31, 12, 0, 0).AddMonths(1): " << endOfJanuary.ToString() << endl;
+
+        ItsDateTime oslo(2024, 6, 1, 12, 0, 0, 0, 2 * 3600);
+        wcout << L"2024-06-01 12:00:00 +02:00 in UTC: " << oslo.ToUtc().ToString() << endl;
+        wcout << L"Same instant at other offsets compare equal: " << ((oslo == oslo.ToUtc()) ? L"true" : L"false") << endl;
+        wcout << L"Now - 2024-06-01 12:00:00 +02:00: " << (ItsDateTime::Now() - oslo).ToString() << endl;
+        wcout << L"sizeof(ItsDateTime): " << sizeof(ItsDateTime) << endl;
+
+        PrintTestSubHeader(L"Range 1677-09-22 to 2262-04-10");
+        ItsDateTime lastDay(2262, 4, 10, 23, 59, 59, 999'999'999);
+        wcout << L"ItsDateTime(2262, 4, 10, 23, 59, 59, 999'999'999): " << lastDay.ToString(L"yyyy-MM-dd HH:mm:ss.fffffffff") << endl;
+        try
+        {
+            lastDay.AddSeconds(1);
+            wcout << L"> AddSeconds(1): no exception" << endl;
+        }
+        catch (const std::overflow_error&) {
+            wcout << L"> AddSeconds(1): std::overflow_error, value kept " << lastDay.ToString() << endl;
+        }
+        try
+        {
+            ItsDateTime(9999, 12, 31);
+            wcout << L"> ItsDateTime(9999, 12, 31): no exception" << endl;
+        }
+        catch (const std::invalid_argument&) {
+            wcout << L"> ItsDateTime(9999, 12, 31): std::invalid_argument" << endl;
+        }
+        ItsDateTime firstDay(1677, 9, 22);
+        firstDay.AddDays(1);
+        firstDay.SubtractDays(1);
+        wcout << L"ItsDateTime(1677, 9, 22).AddDays(1).SubtractDays(1): " << firstDay.ToString() << endl;
+
+        auto precise = ItsDateTime::Now(ItsClockMode::Precise);
+        auto coarse = ItsDateTime::Now(ItsClockMode::Coarse);
+        constexpr ItsDateTimeFormat nanosecondFormat(L"yyyy-MM-dd HH:mm:ss.fffffffff");
+        wcout << L"ItsDateTime::Now(ItsClockMode::Precise): " << precise.ToString(nanosecondFormat) << endl;
+        wcout << L"ItsDateTime::Now(ItsClockMode::Coarse): " << coarse.ToString(nanosecondFormat) << endl;
+        wcout << L"ItsDateTime::UtcNow(): " << ItsDateTime::UtcNow().ToString() << endl;
+
+        constexpr ItsDateTimeFormat isoFormat(L"yyyy-MM-dd'T'HH:mm:ss.fffzzz");
+        wcout << LR"(ItsDateTime::Now().ToString(ItsDateTimeFormat(L"yyyy-MM-dd'T'HH:mm:ss.fffzzz")))" << endl;
+        wcout << L"> " << ItsDateTime::Now().ToString(isoFormat) << endl;
+        wcout << LR"(ToString(L"HH 'hours' mm 'minutes'"))" << endl;
+        wcout << L"> " << ItsDateTime::Now().ToString(L"HH 'hours' mm 'minutes'") << endl;
+        ItsDateTime parsed;
+        bool parsedOk = ItsDateTime::Parse(isoFormat, L"2024-02-29T13:05:09.123+05:30", &parsed);
+        wcout << LR"(ItsDateTime::Parse(isoFormat, L"2024-02-29T13:05:09.123+05:30", &parsed))" << endl;
+        wcout << L"> " << (parsedOk ? L"true " : L"false ") << parsed.ToString(isoFormat) << L" (UTC " << parsed.ToUtc().ToString() << L")" << endl;
+
+        ItsTimeZone newYork;
+        if (ItsTimeZone::Load("America/New_York", &newYork)) {
+            auto abbreviation = newYork.Abbreviation(ItsDateTime::UtcNow());
+            wcout << L"ItsTimeZone(America/New_York).Now(): " << newYork.Now().ToString(isoFormat) << L" " << wstring(abbreviation.begin(), abbreviation.end()) << endl;
+            wcout << L"FromLocal(2024, 3, 10, 2, 30) (in the gap): " << newYork.FromLocal(2024, 3, 10, 2, 30).ToString(isoFormat) << endl;
+            wcout << L"FromLocal(2024, 11, 3, 1, 30) (in the fold): " << newYork.FromLocal(2024, 11, 3, 1, 30).ToString(isoFormat) << endl;
+        }
+        else {
+            wcout << L"ItsTimeZone: no zoneinfo under " << wstring(ItsTimeZone::Directory().begin(), ItsTimeZone::Directory().end()) << endl;
+        }
+
         wcout << endl;
     }
 
@@ -880,6 +1410,27 @@ namespace ItSoftware::CppIncludeWindows::TestApplication
         wcout << LR"(> ")" << ItsID::CreateID(64, ItsCreateIDOptions::LowerAndUpperCase, false) << LR"(")" << endl;
         wcout << L"ItsID::CreateID(64, ItsCreateIDOptions::LowerAndUpperCase, true)" << endl;
         wcout << LR"(> ")" << ItsID::CreateID(64, ItsCreateIDOptions::LowerAndUpperCase, true) << LR"(")" << endl;
+        wcout << L"ItsID::CreateID<string>(12, ItsCreateIDOptions::UpperCase, true)" << endl;
+        string narrowId = ItsID::CreateID<string>(12, ItsCreateIDOptions::UpperCase, true);
+        wcout << LR"(> ")" << wstring(narrowId.begin(), narrowId.end()) << LR"(")" << endl;
+        wcout << L"ItsID::CreateFixedID<8, wchar_t>(ItsCreateIDOptions::LowerCase, true)" << endl;
+        auto fixedId = ItsID::CreateFixedID<8, wchar_t>(ItsCreateIDOptions::LowerCase, true);
+        wcout << LR"(> ")" << wstring(fixedId.begin(), fixedId.end()) << LR"(")" << endl;
+        wcout << L"ItsID::CreateIDs<wstring>(10, ids, ItsCreateIDOptions::LowerAndUpperCase, true), 3 ids" << endl;
+        vector<wstring> ids(3);
+        ItsID::CreateIDs<wstring>(10, ids, ItsCreateIDOptions::LowerAndUpperCase, true);
+        wcout << LR"(> ")" << ids[0] << LR"(" ")" << ids[1] << LR"(" ")" << ids[2] << LR"(")" << endl;
+
+        PrintTestSubHeader(L"Time-ordered IDs");
+        wcout << L"ItsID::CreateULID() x 2" << endl;
+        wcout << LR"(> ")" << ItsID::CreateULID() << LR"(" ")" << ItsID::CreateULID() << LR"(")" << endl;
+        wcout << L"ItsID::CreateUUIDv7()" << endl;
+        GUID uuid7 = ItsID::CreateUUIDv7();
+        wcout << LR"(> ")" << ItsGuid::ToString(uuid7) << LR"(")" << endl;
+        ItsID::SetSnowflakeWorker(7);
+        uint64_t snowflake = ItsID::CreateSnowflake();
+        wcout << L"ItsID::SetSnowflakeWorker(7); ItsID::CreateSnowflake()" << endl;
+        wcout << L"> " << snowflake << L" (time " << ItsID::SnowflakeTime(snowflake) << L")" << endl;
 
         wcout << endl;
     }
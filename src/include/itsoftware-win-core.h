@@ -23,6 +23,7 @@
 #include "itsoftware-exceptions.h"
 #include <time.h>
 #include <map>
+#include <utility>
 
 //
 // #pragma
@@ -45,166 +46,890 @@ namespace ItSoftware::Win::Core
 	using std::thread;
 	using std::map;
 	using ItSoftware::ItsString;
+	using ItSoftware::ItsSecureRandom;
+	using ItSoftware::ItsCpu;
+	using ItSoftware::ItsUInt128;
+	using ItSoftware::ItsTimer;
+	using ItSoftware::ItsTimerMode;
 
 	//
-	// struct: ItsTimer
+	// struct: ItsGuidFormat
+	//
+	// (i): Container for premade Guid format strings.
 	//
-	// (i): Timer wrapper.
+	struct ItsGuidFormat {
+		inline static constexpr const wchar_t* RegistryFormat{ L"{%08lX-%04X-%04x-%02X%02X-%02X%02X%02X%02X%02X%02X}" };
+		inline static constexpr const wchar_t* RegistryFormatStripped{ L"%08lX-%04X-%04x-%02X%02X-%02X%02X%02X%02X%02X%02X" };
+		inline static constexpr const wchar_t* ConstFormat{ L"{ 0x%lx, 0x%x, 0x%x, { 0x%x, 0x%x, 0x%x, 0x%x, 0x%x, 0x%x, 0x%x, 0x%x } }" };
+		inline static constexpr const wchar_t* CompactFormat{ L"%08lX%04X%04x%02X%02X%02X%02X%02X%02X%02X%02X" };
+		inline static constexpr const wchar_t* PrefixedCompactFormat{ L"GUID%08lX%04X%04x%02X%02X%02X%02X%02X%02X%02X%02X" };
+	};
+
 	//
-	struct ItsTimer
+	// struct: ItsGuid
+	//
+	// (i): Wrapper for Guid generation and rendering.
+	//
+	struct ItsGuid
 	{
 	private:
-		size_t m_start = 0;
-		size_t m_end = 0;
-		bool m_isRunning = false;
-	public:
-		void Start()
+		//
+		// Stamp RFC 4122 version 4 and variant 10 onto random bits.
+		//
+		static void SetVersion4(GUID& guid)
 		{
-			if (!this->IsRunning())
+			guid.Data3 = static_cast<unsigned short>((guid.Data3 & 0x0FFF) | 0x4000);
+			guid.Data4[0] = static_cast<unsigned char>((guid.Data4[0] & 0x3F) | 0x80);
+		}
+
+		static constexpr char HexUpper[] = "0123456789ABCDEF";
+		static constexpr char HexLower[] = "0123456789abcdef";
+
+		//
+		// The 16 GUID bytes in text order (Data1..Data3 big-endian, then Data4).
+		//
+		static constexpr std::array<uint8_t, 16> ToBytes(const GUID& guid)
+		{
+			return {
+				static_cast<uint8_t>(guid.Data1 >> 24), static_cast<uint8_t>(guid.Data1 >> 16), static_cast<uint8_t>(guid.Data1 >> 8), static_cast<uint8_t>(guid.Data1),
+				static_cast<uint8_t>(guid.Data2 >> 8), static_cast<uint8_t>(guid.Data2),
+				static_cast<uint8_t>(guid.Data3 >> 8), static_cast<uint8_t>(guid.Data3),
+				guid.Data4[0], guid.Data4[1], guid.Data4[2], guid.Data4[3], guid.Data4[4], guid.Data4[5], guid.Data4[6], guid.Data4[7]
+			};
+		}
+
+		static constexpr GUID FromBytes(const uint8_t* b)
+		{
+			GUID guid{};
+			guid.Data1 = (static_cast<unsigned long>(b[0]) << 24) | (static_cast<unsigned long>(b[1]) << 16) | (static_cast<unsigned long>(b[2]) << 8) | b[3];
+			guid.Data2 = static_cast<unsigned short>((b[4] << 8) | b[5]);
+			guid.Data3 = static_cast<unsigned short>((b[6] << 8) | b[7]);
+			for (int i = 0; i < 8; i++) {
+				guid.Data4[i] = b[8 + i];
+			}
+			return guid;
+		}
+
+		//
+		// Writes bytes [from, to) of the text order as hex. Data3 (bytes 6 and 7) is lower
+		// case in the registry layouts, matching the "%04x" of ItsGuidFormat.
+		//
+		template<typename Char>
+		static Char* WriteHex(Char* out, const std::array<uint8_t, 16>& bytes, int from, int to)
+		{
+			for (int i = from; i < to; i++)
 			{
-				this->m_start = GetTickCount64();
-				this->m_end = m_start;
-				this->m_isRunning = true;
+				const char* hex = (i == 6 || i == 7) ? ItsGuid::HexLower : ItsGuid::HexUpper;
+				*out++ = static_cast<Char>(hex[bytes[i] >> 4]);
+				*out++ = static_cast<Char>(hex[bytes[i] & 0x0F]);
 			}
+			return out;
 		}
 
-		void Stop()
+		//
+		// Lower case hex without leading zeros, as "%x".
+		//
+		template<typename Char>
+		static Char* WriteConstHex(Char* out, uint32_t v)
 		{
-			this->m_end = GetTickCount64();
-			this->m_isRunning = false;
+			*out++ = static_cast<Char>('0');
+			*out++ = static_cast<Char>('x');
+			int shift = (v == 0) ? 0 : ((31 - std::countl_zero(v)) & ~3);
+			for (; shift >= 0; shift -= 4) {
+				*out++ = static_cast<Char>(ItsGuid::HexLower[(v >> shift) & 0x0F]);
+			}
+			return out;
 		}
 
-		bool IsRunning()
+		template<typename Char>
+		static Char* WriteText(Char* out, const char* text)
 		{
-			return this->m_isRunning;
+			while (*text) {
+				*out++ = static_cast<Char>(*text++);
+			}
+			return out;
 		}
 
-		size_t LapSeconds()
+		static constexpr int HexValue(int c)
 		{
-			if (!this->IsRunning()) {
-				return 0;
+			if (c >= '0' && c <= '9') {
+				return c - '0';
 			}
+			c |= 0x20;
+			if (c >= 'a' && c <= 'f') {
+				return c - 'a' + 10;
+			}
+			return -1;
+		}
 
-			return (size_t)((GetTickCount64() - this->m_start) / CLOCKS_PER_SEC);
+		//
+		// Offsets of the 32 hex digits in the hyphenated layout.
+		//
+		static constexpr int HyphenatedDigit(int i)
+		{
+			return i + ((i >= 8) ? 1 : 0) + ((i >= 12) ? 1 : 0) + ((i >= 16) ? 1 : 0) + ((i >= 20) ? 1 : 0);
 		}
 
-		size_t LapMilliseconds()
+		//
+		// Scalar core shared by the constexpr literal parser and non-SIMD builds.
+		// digits is 32 hex characters, or 36 with hyphens at 8, 13, 18 and 23.
+		//
+		template<typename Char>
+		static constexpr bool ParseDigits(const Char* digits, bool hyphenated, uint8_t* bytes)
 		{
-			if (!this->IsRunning()) {
-				return 0;
+			if (hyphenated && (digits[8] != '-' || digits[13] != '-' || digits[18] != '-' || digits[23] != '-')) {
+				return false;
 			}
+			for (int i = 0; i < 16; i++)
+			{
+				const int hi = ItsGuid::HexValue(static_cast<int>(digits[hyphenated ? ItsGuid::HyphenatedDigit(i * 2) : i * 2]));
+				const int lo = ItsGuid::HexValue(static_cast<int>(digits[hyphenated ? ItsGuid::HyphenatedDigit(i * 2 + 1) : i * 2 + 1]));
+				if (hi < 0 || lo < 0) {
+					return false;
+				}
+				bytes[i] = static_cast<uint8_t>((hi << 4) | lo);
+			}
+			return true;
+		}
 
-			return (size_t)((GetTickCount64() - this->m_start) / (size_t)(CLOCKS_PER_SEC / 1'000));
+		//
+		// "{ 0x1, 0x2, 0x3, { 0x4, ... } }" with any spacing.
+		//
+		template<typename Char>
+		static constexpr bool ParseConst(const Char* p, const Char* end, GUID* guid)
+		{
+			uint32_t values[11]{};
+			int n = 0;
+			int braces = 0;
+			while (p < end)
+			{
+				if (*p == ' ' || *p == ',') {
+					p++;
+				}
+				else if (*p == '{') {
+					braces++;
+					p++;
+				}
+				else if (*p == '}') {
+					braces--;
+					p++;
+				}
+				else if (*p == '0' && p + 1 < end && (p[1] == 'x' || p[1] == 'X') && n < 11)
+				{
+					p += 2;
+					uint64_t v = 0;
+					int digits = 0;
+					for (; p < end && ItsGuid::HexValue(static_cast<int>(*p)) >= 0; p++, digits++) {
+						v = (v << 4) | static_cast<uint64_t>(ItsGuid::HexValue(static_cast<int>(*p)));
+					}
+					const uint64_t limit = (n == 0) ? 0xFFFFFFFFull : (n < 3) ? 0xFFFFull : 0xFFull;
+					if (digits == 0 || digits > 8 || v > limit) {
+						return false;
+					}
+					values[n++] = static_cast<uint32_t>(v);
+				}
+				else {
+					return false;
+				}
+			}
+			if (n != 11 || braces != 0) {
+				return false;
+			}
+			guid->Data1 = values[0];
+			guid->Data2 = static_cast<unsigned short>(values[1]);
+			guid->Data3 = static_cast<unsigned short>(values[2]);
+			for (int i = 0; i < 8; i++) {
+				guid->Data4[i] = static_cast<unsigned char>(values[3 + i]);
+			}
+			return true;
 		}
 
-		size_t LapMicroseconds()
+#if defined(ITS_X86)
+		//
+		// Decodes 32 hex characters held in two registers into 16 bytes. Returns false on
+		// any non-hex character.
+		//
+		ITS_TARGET("ssse3")
+		static bool DecodeHexSSSE3(__m128i a, __m128i b, uint8_t* bytes)
 		{
-			if (!this->IsRunning()) {
-				return 0;
+			const __m128i digit0 = _mm_set1_epi8('0');
+			const __m128i letterA = _mm_set1_epi8('a');
+			const __m128i nine = _mm_set1_epi8(9);
+			const __m128i five = _mm_set1_epi8(5);
+			const __m128i ten = _mm_set1_epi8(10);
+			const __m128i lowerBit = _mm_set1_epi8(0x20);
+			const __m128i weights = _mm_set1_epi16(0x0110);	// 16 * high + low
+
+			__m128i values[2];
+			__m128i in[2] = { a, b };
+			for (int i = 0; i < 2; i++)
+			{
+				__m128i d = _mm_sub_epi8(in[i], digit0);
+				__m128i l = _mm_sub_epi8(_mm_or_si128(in[i], lowerBit), letterA);
+				__m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(d, nine), d);
+				__m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(l, five), l);
+				if (_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) != 0xFFFF) {
+					return false;
+				}
+				__m128i v = _mm_or_si128(_mm_and_si128(isDigit, d), _mm_and_si128(isLetter, _mm_add_epi8(l, ten)));
+				values[i] = _mm_maddubs_epi16(v, weights);
 			}
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(bytes), _mm_packus_epi16(values[0], values[1]));
+			return true;
+		}
 
-			return (size_t)((GetTickCount64() - this->m_start) / (size_t)(CLOCKS_PER_SEC / 1'000'000));
+		ITS_TARGET("ssse3")
+		static bool ParseCompactSSSE3(const char* p, uint8_t* bytes)
+		{
+			return ItsGuid::DecodeHexSSSE3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16)), bytes);
 		}
 
-		size_t LapTicks()
+		//
+		// p holds the 36 characters of the hyphenated layout.
+		//
+		ITS_TARGET("ssse3")
+		static bool ParseHyphenatedSSSE3(const char* p, uint8_t* bytes)
 		{
-			if (!this->IsRunning()) {
-				return 0;
+			if (p[8] != '-' || p[13] != '-' || p[18] != '-' || p[23] != '-') {
+				return false;
 			}
-
-			return (size_t)GetTickCount64() - this->m_start;
+			// Squeeze the hyphens out: digits 0-15 come from p[0..17], 16-31 from p[19..35].
+			const __m128i a0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 12, 14, 15, -1, -1));
+			const __m128i a1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 2)), _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 14, 15));
+			const __m128i b0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 19)), _mm_setr_epi8(0, 1, 2, 3, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, -1));
+			const __m128i b1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 20)), _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 15));
+			return ItsGuid::DecodeHexSSSE3(_mm_or_si128(a0, a1), _mm_or_si128(b0, b1), bytes);
 		}
+#endif
 
-		size_t GetSeconds()
+		template<typename Char>
+		static bool ParseText(const Char* text, size_t length, GUID* guid)
 		{
-			if (this->IsRunning()) {
-				return 0;
+			if (guid == nullptr) {
+				return false;
 			}
 
-			return (size_t)((this->m_end - this->m_start) / (size_t)CLOCKS_PER_SEC);
+			// Layouts with at most 38 characters are narrowed into a padded buffer for SIMD loads.
+			if (length <= 38)
+			{
+				char buffer[48]{};
+				for (size_t i = 0; i < length; i++)
+				{
+					if (static_cast<uint32_t>(text[i]) > 0x7F) {
+						return false;
+					}
+					buffer[i] = static_cast<char>(text[i]);
+				}
+
+				const char* digits = nullptr;
+				bool hyphenated = false;
+				if (length == 32) {
+					digits = buffer;
+				}
+				else if (length == 36 && (buffer[0] | 0x20) == 'g' && (buffer[1] | 0x20) == 'u' && (buffer[2] | 0x20) == 'i' && (buffer[3] | 0x20) == 'd') {
+					digits = buffer + 4;
+				}
+				else if (length == 36) {
+					digits = buffer;
+					hyphenated = true;
+				}
+				else if (length == 38 && buffer[0] == '{' && buffer[37] == '}') {
+					digits = buffer + 1;
+					hyphenated = true;
+				}
+
+				if (digits != nullptr)
+				{
+					uint8_t bytes[16];
+					bool ok = false;
+#if defined(ITS_X86)
+					if (ItsCpu::HasSSSE3()) {
+						ok = hyphenated ? ItsGuid::ParseHyphenatedSSSE3(digits, bytes) : ItsGuid::ParseCompactSSSE3(digits, bytes);
+					}
+					else
+#endif
+					{
+						ok = ItsGuid::ParseDigits(digits, hyphenated, bytes);
+					}
+					if (ok) {
+						*guid = ItsGuid::FromBytes(bytes);
+					}
+					return ok;
+				}
+			}
+
+			return ItsGuid::ParseConst(text, text + length, guid);
 		}
 
-		size_t GetMilliseconds()
+	public:
+		static wstring CreateGuid()
 		{
-			if (this->IsRunning()) {
-				return 0;
+			GUID guid{ 0 };
+			if (!ItsGuid::CreateGuid(&guid)) {
+				return wstring(L"");
 			}
 
-			return (size_t)((this->m_end - this->m_start) / (size_t)(CLOCKS_PER_SEC / 1'000));
+			return ItsGuid::ToString(guid);
+		}
+		//
+		// Version 4 GUID from the per-thread buffered CSPRNG (no system call per GUID).
+		//
+		static bool CreateGuid(GUID* pGuid)
+		{
+			if (!ItsSecureRandom::Fill(pGuid, sizeof(GUID))) {
+				return false;
+			}
+			ItsGuid::SetVersion4(*pGuid);
+			return true;
 		}
+		static bool CreateGuids(std::span<GUID> guids)
+		{
+			if (!ItsSecureRandom::Fill(guids.data(), guids.size_bytes())) {
+				return false;
+			}
+			for (auto& guid : guids) {
+				ItsGuid::SetVersion4(guid);
+			}
+			return true;
+		}
+		//
+		// Longest text written by ToChars.
+		//
+		static constexpr size_t MaxLength = 100;
 
-		size_t GetMicroseconds()
+		//
+		// Writes guid in one of the ItsGuidFormat layouts to out (no terminator) and
+		// returns the number of characters. Returns 0 for other formats.
+		//
+		template<typename Char>
+		static size_t ToChars(const GUID& guid, Char* out, const wchar_t* format = ItsGuidFormat::RegistryFormat)
 		{
-			if (this->IsRunning()) {
-				return 0;
+			const std::wstring_view f(format);
+			const auto bytes = ItsGuid::ToBytes(guid);
+			Char* p = out;
+			if (f == ItsGuidFormat::RegistryFormat || f == ItsGuidFormat::RegistryFormatStripped)
+			{
+				const bool braces = (f == ItsGuidFormat::RegistryFormat);
+				if (braces) {
+					*p++ = static_cast<Char>('{');
+				}
+				p = ItsGuid::WriteHex(p, bytes, 0, 4);
+				*p++ = static_cast<Char>('-');
+				p = ItsGuid::WriteHex(p, bytes, 4, 6);
+				*p++ = static_cast<Char>('-');
+				p = ItsGuid::WriteHex(p, bytes, 6, 8);
+				*p++ = static_cast<Char>('-');
+				p = ItsGuid::WriteHex(p, bytes, 8, 10);
+				*p++ = static_cast<Char>('-');
+				p = ItsGuid::WriteHex(p, bytes, 10, 16);
+				if (braces) {
+					*p++ = static_cast<Char>('}');
+				}
+			}
+			else if (f == ItsGuidFormat::CompactFormat || f == ItsGuidFormat::PrefixedCompactFormat)
+			{
+				if (f == ItsGuidFormat::PrefixedCompactFormat) {
+					p = ItsGuid::WriteText(p, "GUID");
+				}
+				p = ItsGuid::WriteHex(p, bytes, 0, 16);
+			}
+			else if (f == ItsGuidFormat::ConstFormat)
+			{
+				p = ItsGuid::WriteText(p, "{ ");
+				p = ItsGuid::WriteConstHex(p, static_cast<uint32_t>(guid.Data1));
+				p = ItsGuid::WriteText(p, ", ");
+				p = ItsGuid::WriteConstHex(p, guid.Data2);
+				p = ItsGuid::WriteText(p, ", ");
+				p = ItsGuid::WriteConstHex(p, guid.Data3);
+				p = ItsGuid::WriteText(p, ", { ");
+				for (int i = 0; i < 8; i++)
+				{
+					p = ItsGuid::WriteConstHex(p, guid.Data4[i]);
+					p = ItsGuid::WriteText(p, (i < 7) ? ", " : " } }");
+				}
+			}
+			return static_cast<size_t>(p - out);
+		}
+
+		static wstring ToString(const GUID& guid) {
+			return ItsGuid::ToString(guid, ItsGuidFormat::RegistryFormat);
+		}
+		static wstring ToString(const GUID& guid, wstring format) {
+			wchar_t wcsBuffer[ItsGuid::MaxLength];
+			size_t length = ItsGuid::ToChars(guid, wcsBuffer, format.c_str());
+			if (length > 0) {
+				return wstring(wcsBuffer, length);
 			}
 
-			return (size_t)((this->m_end - this->m_start) / (size_t)(CLOCKS_PER_SEC / 1'000'000));
+			memset(wcsBuffer, 0, sizeof(wcsBuffer));
+			wsprintf(wcsBuffer, format.c_str(),
+				// first copy...
+				guid.Data1, guid.Data2, guid.Data3,
+				guid.Data4[0], guid.Data4[1], guid.Data4[2], guid.Data4[3],
+				guid.Data4[4], guid.Data4[5], guid.Data4[6], guid.Data4[7]);
+
+			return wstring(wcsBuffer);
+		}
+
+		//
+		// Parses any ItsGuidFormat layout (hex digits in either case).
+		//
+		static bool Parse(std::wstring_view text, GUID* guid)
+		{
+			return ItsGuid::ParseText(text.data(), text.size(), guid);
+		}
+		static bool Parse(std::string_view text, GUID* guid)
+		{
+			return ItsGuid::ParseText(text.data(), text.size(), guid);
 		}
 
-		size_t GetTicks()
+		//
+		// Compile time GUID from a registry, stripped or compact literal:
+		// constexpr GUID id = ItsGuid::FromLiteral("{6B29FC40-CA47-1067-B31D-00DD010662DA}");
+		//
+		template<size_t N>
+		static consteval GUID FromLiteral(const char(&text)[N])
 		{
-			if (this->IsRunning()) {
-				return 0;
+			const size_t length = N - 1;
+			const char* digits = text;
+			bool hyphenated = false;
+			if (length == 38 && text[0] == '{' && text[37] == '}') {
+				digits = text + 1;
+				hyphenated = true;
+			}
+			else if (length == 36) {
+				hyphenated = true;
+			}
+			else if (length != 32) {
+				throw "ItsGuid::FromLiteral: unsupported GUID layout";
+			}
+			uint8_t bytes[16]{};
+			if (!ItsGuid::ParseDigits(digits, hyphenated, bytes)) {
+				throw "ItsGuid::FromLiteral: invalid GUID";
 			}
+			return ItsGuid::FromBytes(bytes);
+		}
+	};
 
-			return this->m_end - this->m_start;
+	//
+	// struct: ItsGuidHash
+	//
+	// (i): 64 bit hash of a GUID. Mixes both halves so sequential (v7, ULID) GUIDs spread well.
+	//
+	struct ItsGuidHash
+	{
+		size_t operator()(const GUID& guid) const
+		{
+			uint64_t a = 0;
+			uint64_t b = 0;
+			memcpy(&a, &guid, 8);
+			memcpy(&b, reinterpret_cast<const uint8_t*>(&guid) + 8, 8);
+			ItsUInt128 m = ItsUInt128::Multiply(a ^ 0xA0761D6478BD642Full, b ^ 0xE7037ED1A0B428DBull);
+			return static_cast<size_t>(m.High ^ m.Low);
 		}
 	};
 
 	//
-	// struct: ItsGuidFormat
+	// struct: ItsGuidEqual
 	//
-	// (i): Container for premade Guid format strings.
+	struct ItsGuidEqual
+	{
+		bool operator()(const GUID& a, const GUID& b) const
+		{
+			return memcmp(&a, &b, sizeof(GUID)) == 0;
+		}
+	};
+
 	//
-	struct ItsGuidFormat {
-		inline static constexpr const wchar_t* RegistryFormat{ L"{%08lX-%04X-%04x-%02X%02X-%02X%02X%02X%02X%02X%02X}" };
-		inline static constexpr const wchar_t* RegistryFormatStripped{ L"%08lX-%04X-%04x-%02X%02X-%02X%02X%02X%02X%02X%02X" };
-		inline static constexpr const wchar_t* ConstFormat{ L"{ 0x%lx, 0x%x, 0x%x, { 0x%x, 0x%x, 0x%x, 0x%x, 0x%x, 0x%x, 0x%x, 0x%x } }" };
-		inline static constexpr const wchar_t* CompactFormat{ L"%08lX%04X%04x%02X%02X%02X%02X%02X%02X%02X%02X" };
-		inline static constexpr const wchar_t* PrefixedCompactFormat{ L"GUID%08lX%04X%04x%02X%02X%02X%02X%02X%02X%02X%02X" };
+	// struct: ItsGuidLess
+	//
+	// (i): Orders GUIDs as their registry strings sort (Data1, Data2, Data3, then Data4 bytes).
+	//
+	struct ItsGuidLess
+	{
+		bool operator()(const GUID& a, const GUID& b) const
+		{
+			if (a.Data1 != b.Data1) {
+				return a.Data1 < b.Data1;
+			}
+			if (a.Data2 != b.Data2) {
+				return a.Data2 < b.Data2;
+			}
+			if (a.Data3 != b.Data3) {
+				return a.Data3 < b.Data3;
+			}
+			return memcmp(a.Data4, b.Data4, sizeof(a.Data4)) < 0;
+		}
 	};
 
 	//
-	// struct: ItsGuid
+	// class: ItsGuidTable
 	//
-	// (i): Wrapper for Guid generation and rendering.
+	// (i): Open addressing hash table keyed by GUID (Swiss table layout). One control byte
+	//      per slot holds 7 hash bits or empty/deleted; 16 control bytes form a group that is
+	//      matched with one SSE2 compare. Control bytes and slots are separate arrays so a
+	//      probe touches one cache line of metadata before any key. Entry is GUID (set) or
+	//      std::pair<GUID, V> (map).
 	//
-	struct ItsGuid
+	template<typename Entry>
+	class ItsGuidTable
 	{
+	private:
+		static constexpr int8_t Empty = static_cast<int8_t>(0x80);
+		static constexpr int8_t Deleted = static_cast<int8_t>(0xFE);
+		static constexpr size_t GroupSize = 16;
+
+		std::unique_ptr<int8_t[]> m_control;
+		Entry* m_slots{ nullptr };
+		size_t m_capacity{ 0 };
+		size_t m_size{ 0 };
+		size_t m_deleted{ 0 };
+
+		static const GUID& KeyOf(const GUID& entry) { return entry; }
+		template<typename V>
+		static const GUID& KeyOf(const std::pair<GUID, V>& entry) { return entry.first; }
+
+		static uint32_t Match(const int8_t* group, int8_t value)
+		{
+#if defined(ITS_X86)
+			const __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+			return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(value))));
+#else
+			uint32_t mask = 0;
+			for (size_t i = 0; i < GroupSize; i++) {
+				mask |= (group[i] == value) ? (1u << i) : 0u;
+			}
+			return mask;
+#endif
+		}
+
+		//
+		// Empty or deleted slots (control byte has the high bit set).
+		//
+		static uint32_t MatchFree(const int8_t* group)
+		{
+#if defined(ITS_X86)
+			return static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(group))));
+#else
+			uint32_t mask = 0;
+			for (size_t i = 0; i < GroupSize; i++) {
+				mask |= (group[i] < 0) ? (1u << i) : 0u;
+			}
+			return mask;
+#endif
+		}
+
+		//
+		// Slot index of key, or m_capacity when absent.
+		//
+		size_t FindIndex(const GUID& key, size_t hash) const
+		{
+			if (this->m_capacity == 0) {
+				return 0;
+			}
+			const int8_t h2 = static_cast<int8_t>(hash & 0x7F);
+			const size_t groupMask = this->m_capacity / GroupSize - 1;
+			size_t group = (hash >> 7) & groupMask;
+			for (size_t step = 1;; step++)
+			{
+				const int8_t* ctrl = this->m_control.get() + group * GroupSize;
+				for (uint32_t m = ItsGuidTable::Match(ctrl, h2); m != 0; m &= m - 1)
+				{
+					size_t index = group * GroupSize + static_cast<size_t>(std::countr_zero(m));
+					if (ItsGuidEqual()(ItsGuidTable::KeyOf(this->m_slots[index]), key)) {
+						return index;
+					}
+				}
+				if (ItsGuidTable::Match(ctrl, Empty) != 0 || step > groupMask + 1) {
+					return this->m_capacity;
+				}
+				group = (group + step) & groupMask;
+			}
+		}
+
+		//
+		// First free slot on the probe path of hash. Caller guarantees one exists.
+		//
+		size_t FindFree(size_t hash) const
+		{
+			const size_t groupMask = this->m_capacity / GroupSize - 1;
+			size_t group = (hash >> 7) & groupMask;
+			for (size_t step = 1;; step++)
+			{
+				uint32_t m = ItsGuidTable::MatchFree(this->m_control.get() + group * GroupSize);
+				if (m != 0) {
+					return group * GroupSize + static_cast<size_t>(std::countr_zero(m));
+				}
+				group = (group + step) & groupMask;
+			}
+		}
+
+		void Rehash(size_t capacity)
+		{
+			std::unique_ptr<int8_t[]> control = std::move(this->m_control);
+			Entry* slots = this->m_slots;
+			size_t oldCapacity = this->m_capacity;
+
+			this->m_control = std::make_unique<int8_t[]>(capacity);
+			memset(this->m_control.get(), Empty, capacity);
+			this->m_slots = std::allocator<Entry>().allocate(capacity);
+			this->m_capacity = capacity;
+			this->m_deleted = 0;
+
+			for (size_t i = 0; i < oldCapacity; i++)
+			{
+				if (control[i] >= 0)
+				{
+					size_t hash = ItsGuidHash()(ItsGuidTable::KeyOf(slots[i]));
+					size_t index = this->FindFree(hash);
+					this->m_control[index] = static_cast<int8_t>(hash & 0x7F);
+					new (&this->m_slots[index]) Entry(std::move(slots[i]));
+					slots[i].~Entry();
+				}
+			}
+			if (slots != nullptr) {
+				std::allocator<Entry>().deallocate(slots, oldCapacity);
+			}
+		}
+
 	public:
-		static wstring CreateGuid()
+		ItsGuidTable() = default;
+		ItsGuidTable(const ItsGuidTable&) = delete;
+		ItsGuidTable& operator=(const ItsGuidTable&) = delete;
+
+		ItsGuidTable(ItsGuidTable&& other) noexcept
 		{
-			GUID guid{ 0 };
-			HRESULT hr = CoCreateGuid(&guid);
-			if (FAILED(hr)) {
-				return wstring(L"");
+			*this = std::move(other);
+		}
+
+		ItsGuidTable& operator=(ItsGuidTable&& other) noexcept
+		{
+			if (this != &other)
+			{
+				this->Release();
+				this->m_control = std::move(other.m_control);
+				this->m_slots = std::exchange(other.m_slots, nullptr);
+				this->m_capacity = std::exchange(other.m_capacity, 0);
+				this->m_size = std::exchange(other.m_size, 0);
+				this->m_deleted = std::exchange(other.m_deleted, 0);
 			}
+			return *this;
+		}
 
-			return ItsGuid::ToString(guid);
+		~ItsGuidTable()
+		{
+			this->Release();
 		}
-		static bool CreateGuid(GUID* pGuid)
+
+		size_t Size() const { return this->m_size; }
+		bool IsEmpty() const { return this->m_size == 0; }
+		size_t Capacity() const { return this->m_capacity; }
+
+		//
+		// Makes room for count entries without rehashing.
+		//
+		void Reserve(size_t count)
+		{
+			size_t capacity = std::bit_ceil(std::max<size_t>(GroupSize, count + count / 7 + 1));
+			if (capacity > this->m_capacity) {
+				this->Rehash(capacity);
+			}
+		}
+
+		Entry* Find(const GUID& key)
+		{
+			size_t index = this->FindIndex(key, ItsGuidHash()(key));
+			return (index < this->m_capacity) ? &this->m_slots[index] : nullptr;
+		}
+
+		const Entry* Find(const GUID& key) const
+		{
+			size_t index = this->FindIndex(key, ItsGuidHash()(key));
+			return (index < this->m_capacity) ? &this->m_slots[index] : nullptr;
+		}
+
+		//
+		// Pulls the control group and first slot of key into cache ahead of a Find.
+		//
+		void Prefetch(const GUID& key) const
+		{
+			if (this->m_capacity == 0) {
+				return;
+			}
+#if defined(ITS_X86)
+			size_t group = (ItsGuidHash()(key) >> 7) & (this->m_capacity / GroupSize - 1);
+			_mm_prefetch(reinterpret_cast<const char*>(this->m_control.get() + group * GroupSize), _MM_HINT_T0);
+			_mm_prefetch(reinterpret_cast<const char*>(this->m_slots + group * GroupSize), _MM_HINT_T0);
+#endif
+		}
+
+		//
+		// Inserts entry unless its key exists. Returns the entry in the table and whether
+		// it was inserted.
+		//
+		std::pair<Entry*, bool> Insert(Entry&& entry)
 		{
-			HRESULT hr = CoCreateGuid(pGuid);
-			if (FAILED(hr)) {
+			const GUID& key = ItsGuidTable::KeyOf(entry);
+			size_t hash = ItsGuidHash()(key);
+			size_t index = this->FindIndex(key, hash);
+			if (this->m_capacity > 0 && index < this->m_capacity) {
+				return { &this->m_slots[index], false };
+			}
+			if ((this->m_size + this->m_deleted + 1) * 8 > this->m_capacity * 7) {
+				this->Rehash((this->m_size + 1) * 8 > this->m_capacity * 7 / 2 ? std::max<size_t>(GroupSize, this->m_capacity * 2) : this->m_capacity);
+			}
+			index = this->FindFree(hash);
+			if (this->m_control[index] == Deleted) {
+				this->m_deleted--;
+			}
+			this->m_control[index] = static_cast<int8_t>(hash & 0x7F);
+			new (&this->m_slots[index]) Entry(std::move(entry));
+			this->m_size++;
+			return { &this->m_slots[index], true };
+		}
+
+		bool Erase(const GUID& key)
+		{
+			size_t index = this->FindIndex(key, ItsGuidHash()(key));
+			if (this->m_capacity == 0 || index >= this->m_capacity) {
 				return false;
 			}
+			this->m_slots[index].~Entry();
+			// A group that still has an empty slot was never full, so no probe continues past it.
+			int8_t* group = this->m_control.get() + (index & ~(GroupSize - 1));
+			if (ItsGuidTable::Match(group, Empty) != 0) {
+				this->m_control[index] = Empty;
+			}
+			else {
+				this->m_control[index] = Deleted;
+				this->m_deleted++;
+			}
+			this->m_size--;
 			return true;
 		}
-		static wstring ToString(GUID& guid) {
-			return ItsGuid::ToString(guid, ItsGuidFormat::RegistryFormat);
+
+		void Clear()
+		{
+			for (size_t i = 0; i < this->m_capacity; i++)
+			{
+				if (this->m_control[i] >= 0) {
+					this->m_slots[i].~Entry();
+				}
+			}
+			if (this->m_capacity > 0) {
+				memset(this->m_control.get(), Empty, this->m_capacity);
+			}
+			this->m_size = 0;
+			this->m_deleted = 0;
 		}
-		static wstring ToString(GUID& guid, wstring format) {
-			wchar_t wcsBuffer[100];
-			memset(wcsBuffer, 0, 100);
 
-			wsprintf(wcsBuffer, format.c_str(),
-				// first copy...
-				guid.Data1, guid.Data2, guid.Data3,
-				guid.Data4[0], guid.Data4[1], guid.Data4[2], guid.Data4[3],
-				guid.Data4[4], guid.Data4[5], guid.Data4[6], guid.Data4[7]);
+		template<typename Func>
+		void ForEach(Func&& func)
+		{
+			for (size_t i = 0; i < this->m_capacity; i++)
+			{
+				if (this->m_control[i] >= 0) {
+					func(this->m_slots[i]);
+				}
+			}
+		}
 
-			return wstring(wcsBuffer);
+	private:
+		void Release()
+		{
+			if (this->m_slots != nullptr)
+			{
+				this->Clear();
+				std::allocator<Entry>().deallocate(this->m_slots, this->m_capacity);
+				this->m_slots = nullptr;
+			}
+			this->m_control.reset();
+			this->m_capacity = 0;
+		}
+	};
+
+	//
+	// class: ItsGuidMap
+	//
+	// (i): GUID keyed hash map with 16 byte inline keys.
+	//
+	template<typename V>
+	class ItsGuidMap
+	{
+	private:
+		ItsGuidTable<std::pair<GUID, V>> m_table;
+
+	public:
+		size_t Size() const { return this->m_table.Size(); }
+		bool IsEmpty() const { return this->m_table.IsEmpty(); }
+		void Reserve(size_t count) { this->m_table.Reserve(count); }
+		void Clear() { this->m_table.Clear(); }
+		void Prefetch(const GUID& key) const { this->m_table.Prefetch(key); }
+		bool Erase(const GUID& key) { return this->m_table.Erase(key); }
+		bool Contains(const GUID& key) const { return this->m_table.Find(key) != nullptr; }
+
+		V* Find(const GUID& key)
+		{
+			auto entry = this->m_table.Find(key);
+			return (entry != nullptr) ? &entry->second : nullptr;
+		}
+
+		const V* Find(const GUID& key) const
+		{
+			auto entry = this->m_table.Find(key);
+			return (entry != nullptr) ? &entry->second : nullptr;
+		}
+
+		//
+		// Inserts unless key exists; returns the stored value and whether it was inserted.
+		//
+		std::pair<V*, bool> Insert(const GUID& key, V value)
+		{
+			auto r = this->m_table.Insert(std::pair<GUID, V>(key, std::move(value)));
+			return { &r.first->second, r.second };
+		}
+
+		V& operator[](const GUID& key)
+		{
+			V* value = this->Find(key);
+			return (value != nullptr) ? *value : *this->Insert(key, V{}).first;
+		}
+
+		template<typename Func>
+		void ForEach(Func&& func)
+		{
+			this->m_table.ForEach([&func](std::pair<GUID, V>& entry) { func(entry.first, entry.second); });
+		}
+	};
+
+	//
+	// class: ItsGuidSet
+	//
+	// (i): GUID hash set with 16 byte inline keys.
+	//
+	class ItsGuidSet
+	{
+	private:
+		ItsGuidTable<GUID> m_table;
+
+	public:
+		size_t Size() const { return this->m_table.Size(); }
+		bool IsEmpty() const { return this->m_table.IsEmpty(); }
+		void Reserve(size_t count) { this->m_table.Reserve(count); }
+		void Clear() { this->m_table.Clear(); }
+		void Prefetch(const GUID& key) const { this->m_table.Prefetch(key); }
+		bool Erase(const GUID& key) { return this->m_table.Erase(key); }
+		bool Contains(const GUID& key) const { return this->m_table.Find(key) != nullptr; }
+
+		bool Insert(const GUID& key)
+		{
+			return this->m_table.Insert(GUID(key)).second;
+		}
+
+		template<typename Func>
+		void ForEach(Func&& func)
+		{
+			this->m_table.ForEach([&func](GUID& key) { func(static_cast<const GUID&>(key)); });
 		}
 	};
 
@@ -2977,4 +3702,22 @@ namespace ItSoftware::Win::Core
 			return true;
 		}
 	};// ItsIniFile
-}// namespace ItSoftware::Win::Core
\ No newline at end of file
+}// namespace ItSoftware::Win::Core
+
+//
+// GUID ordering (registry string order) and std::hash, so GUID works as a key in
+// std::map, std::set and the unordered containers. operator== comes from guiddef.h.
+//
+inline bool operator<(const GUID& a, const GUID& b) { return ItSoftware::Win::Core::ItsGuidLess()(a, b); }
+inline bool operator>(const GUID& a, const GUID& b) { return b < a; }
+inline bool operator<=(const GUID& a, const GUID& b) { return !(b < a); }
+inline bool operator>=(const GUID& a, const GUID& b) { return !(a < b); }
+
+template<>
+struct std::hash<GUID>
+{
+	size_t operator()(const GUID& guid) const
+	{
+		return ItSoftware::Win::Core::ItsGuidHash()(guid);
+	}
+};
\ No newline at end of file
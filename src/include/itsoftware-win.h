@@ -43,6 +43,8 @@ namespace ItSoftware::Win
 	using std::function;
 	using std::thread;
 	using ItSoftware::ItsString;
+	using ItSoftware::ItsColor;
+	using ItSoftware::ItsColorFormat;
 
 	//
 	// Variable: hCBTHook for ItsWin
@@ -82,15 +84,7 @@ namespace ItSoftware::Win
 		//
 		static wstring ToRGBString(COLORREF color)
 		{
-			wstringstream ss;
-
-			ss << (unsigned char)((color & 0x0000FF));
-			ss << L",";
-			ss << (unsigned char)((color & 0x00FF00) >> 8);
-			ss << L",";
-			ss << (unsigned char)((color & 0xFF0000) >> 16);
-
-			return ss.str();
+			return ItsColor::FromCOLORREF(color).ToString(ItsColorFormat::RGB);
 		}
 
 		//
@@ -18,6 +18,7 @@
 #include <iostream>
 #include <iomanip>
 #include <exception>
+#include <fstream>
 #include <algorithm>
 #include "atlcomcli.h"		
 #include <string>
@@ -27,7 +28,46 @@
 #include <functional>
 #include <stdlib.h>
 #include <time.h>
+#include <thread>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <compare>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string_view>
 #include "itsoftware-exceptions.h"
+#if defined(_WIN32)
+#include <bcrypt.h>
+#pragma comment(lib, "bcrypt.lib")
+#else
+#include <errno.h>
+#include <pthread.h>
+#include <sys/random.h>
+#endif
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define ITS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
 
 //
 // namespace
@@ -59,6 +99,11 @@ namespace ItSoftware
 #define ROR( val, steps ) ( ( val >> Shift( val, steps ) ) | ( val << ( BitsCount( val ) - Shift( val, steps ) ) ) )	
 #define AddFlag( val, flag ) (val | flag)
 #define RemoveFlag(val, flag) (val & ~flag)
+#if defined(_MSC_VER)
+#define ITS_TARGET(isa)
+#else
+#define ITS_TARGET(isa) __attribute__((target(isa)))
+#endif
 
 //
 // Function: as_const
@@ -150,131 +195,495 @@ namespace ItSoftware
 	}
 
 	//
-	// struct: ItsTime
+	// enum: ItsDurationFormat
 	//
-	// (i): Split milliseconds or render milliseconds to a friendly string.
+	// (i): Text forms of ItsDuration.
+	//      Full:               "1 day 1 hour 41:21" (the ItsTime::RenderMsToFullString layout)
+	//      FullMilliseconds:   "1 day 1 hour 41:21.379"
+	//      Compact:            "1d1h41m21.379s", "1.5ms", "0s"
+	//      ISO8601:            "P1DT1H41M21.379S"
 	//
-	struct ItsTime
+	enum class ItsDurationFormat
 	{
-		static void SplitMsToHourMinuteSeconds(size_t time_ms, size_t* part_hours, size_t* part_minutes, size_t* part_seconds, size_t* part_ms)
-		{
-			size_t seconds = time_ms / 1000;
+		Full,
+		FullMilliseconds,
+		Compact,
+		ISO8601
+	};
 
-			*part_hours = 0;
-			*part_minutes = 0;;
-			*part_seconds = 0;
-			*part_ms = 0;
+	//
+	// struct: ItsDurationParts
+	//
+	// (i): Components of an ItsDuration's magnitude. A year is 52 weeks, as in ItsTime.
+	//
+	struct ItsDurationParts
+	{
+		bool Negative{ false };
+		uint64_t Years{ 0 };
+		uint64_t Weeks{ 0 };
+		uint64_t Days{ 0 };
+		uint64_t Hours{ 0 };
+		uint64_t Minutes{ 0 };
+		uint64_t Seconds{ 0 };
+		uint64_t Milliseconds{ 0 };
+		uint64_t Microseconds{ 0 };
+		uint64_t Nanoseconds{ 0 };
+	};
 
-			*part_hours = seconds / 3600;
-			*part_minutes = (seconds - (*part_hours * 3600)) / 60;
-			*part_seconds = seconds - (*part_hours * 3600) - (*part_minutes * 60);
-			*part_ms = time_ms - (*part_seconds * 1000) - (*part_minutes * 60 * 1000) - (*part_hours * 3600 * 1000);
-		}
+	//
+	// struct: ItsDuration
+	//
+	// (i): Signed duration in nanoseconds with constexpr decomposition, allocation free
+	//      formatting and parsing of the compact form.
+	//
+	struct ItsDuration
+	{
+	private:
+		int64_t m_ns{ 0 };
 
-		static void SplitHourToYearWeekDayHour(size_t houIn, size_t* houRest, size_t* day, size_t* week, size_t* year)
+		constexpr uint64_t Magnitude() const
 		{
-			*houRest = houIn;
+			return (this->m_ns < 0) ? 0 - static_cast<uint64_t>(this->m_ns) : static_cast<uint64_t>(this->m_ns);
+		}
 
-			*day = houIn / 24;
-			*week = *day / 7;
-			*year = *week / 52;
+		template<typename Char>
+		static Char* WriteText(Char* p, const char* text)
+		{
+			while (*text != '\0') {
+				*p++ = static_cast<Char>(*text++);
+			}
+			return p;
+		}
 
-			*day -= (*week * 7);
+		template<typename Char>
+		static Char* WriteNumber(Char* p, uint64_t value, int minDigits = 1)
+		{
+			char digits[20];
+			int count = 0;
+			do {
+				digits[count++] = static_cast<char>('0' + value % 10);
+				value /= 10;
+			} while (value != 0);
+			while (count < minDigits) {
+				digits[count++] = '0';
+			}
+			while (count > 0) {
+				*p++ = static_cast<Char>(digits[--count]);
+			}
+			return p;
+		}
 
-			*week -= (*year * 52);
+		//
+		// ".fff" with trailing zeros removed; nothing when value is 0.
+		//
+		template<typename Char>
+		static Char* WriteFraction(Char* p, uint64_t value, int digits)
+		{
+			if (value == 0) {
+				return p;
+			}
+			while (value % 10 == 0) {
+				value /= 10;
+				digits--;
+			}
+			*p++ = static_cast<Char>('.');
+			return ItsDuration::WriteNumber(p, value, digits);
+		}
 
-			*houRest -= *week * 7 * 24;
-			*houRest -= *day * 24;
-			*houRest -= *year * 52 * 7 * 24;
+		template<typename Char>
+		static Char* WriteUnit(Char* p, uint64_t value, const char* singular, const char* plural)
+		{
+			p = ItsDuration::WriteNumber(p, value);
+			return ItsDuration::WriteText(p, (value <= 1) ? singular : plural);
 		}
 
-		static wstring RenderMsToFullString(size_t milliseconds, bool bWithMilliseconds)
+		template<typename Char>
+		static bool ParseText(const Char* text, size_t length, ItsDuration* duration)
 		{
-			size_t hou = 0;
-			size_t min = 0;
-			size_t sec = 0;
-			size_t ms = 0;
-			ItsTime::SplitMsToHourMinuteSeconds(milliseconds, &hou, &min, &sec, &ms);
+			size_t i = 0;
+			bool negative = false;
+			if (i < length && (text[i] == static_cast<Char>('-') || text[i] == static_cast<Char>('+'))) {
+				negative = (text[i] == static_cast<Char>('-'));
+				i++;
+			}
+			if (i == length) {
+				return false;
+			}
 
-			size_t houRest = 0;
-			size_t day = 0;
-			size_t week = 0;
-			size_t year = 0;
-			ItsTime::SplitHourToYearWeekDayHour(hou, &houRest, &day, &week, &year);
+			// A bare zero needs no unit.
+			if (i + 1 == length && text[i] == static_cast<Char>('0')) {
+				*duration = ItsDuration();
+				return true;
+			}
 
-			wstringstream ss;
-			if (year > 0) {
-				if (year == 1)
+			const uint64_t limit = negative ? 0x8000000000000000ull : 0x7FFFFFFFFFFFFFFFull;
+			uint64_t total = 0;
+			while (i < length)
+			{
+				uint64_t whole = 0;
+				size_t start = i;
+				while (i < length && text[i] >= static_cast<Char>('0') && text[i] <= static_cast<Char>('9'))
 				{
-					ss << year << L" year ";
+					if (whole > (0xFFFFFFFFFFFFFFFFull - 9) / 10) {
+						return false;
+					}
+					whole = whole * 10 + static_cast<uint64_t>(text[i] - static_cast<Char>('0'));
+					i++;
 				}
-				else
+				bool hasWhole = i > start;
+
+				uint64_t fraction = 0;
+				uint64_t fractionScale = 1;
+				bool hasFraction = false;
+				if (i < length && text[i] == static_cast<Char>('.'))
 				{
-					ss << year << L" years ";
-				}
-			}
-			if (week > 0 || year > 0) {
-				if (week == 1 || week == 0) {
-					ss << week << L" week ";
+					i++;
+					while (i < length && text[i] >= static_cast<Char>('0') && text[i] <= static_cast<Char>('9'))
+					{
+						if (fractionScale < 1'000'000'000'000'000'000ull) {
+							fraction = fraction * 10 + static_cast<uint64_t>(text[i] - static_cast<Char>('0'));
+							fractionScale *= 10;
+						}
+						hasFraction = true;
+						i++;
+					}
 				}
-				else
-				{
-					ss << week << L" weeks ";
+				if (!hasWhole && !hasFraction) {
+					return false;
 				}
-			}
-			if (day > 0 || week > 0 || year > 0) {
-				if (day == 1 || day == 0)
-				{
-					ss << day << L" day ";
+
+				uint64_t unit = 0;
+				Char c = (i < length) ? text[i] : static_cast<Char>(0);
+				Char next = (i + 1 < length) ? text[i + 1] : static_cast<Char>(0);
+				if (c == static_cast<Char>('n') && next == static_cast<Char>('s')) { unit = 1; i += 2; }
+				else if (c == static_cast<Char>('u') && next == static_cast<Char>('s')) { unit = 1'000; i += 2; }
+				else if (c == static_cast<Char>('m') && next == static_cast<Char>('s')) { unit = 1'000'000; i += 2; }
+				else if (c == static_cast<Char>('s')) { unit = 1'000'000'000; i++; }
+				else if (c == static_cast<Char>('m')) { unit = 60'000'000'000; i++; }
+				else if (c == static_cast<Char>('h')) { unit = 3'600'000'000'000; i++; }
+				else if (c == static_cast<Char>('d')) { unit = 86'400'000'000'000; i++; }
+				else if (c == static_cast<Char>('w')) { unit = 604'800'000'000'000; i++; }
+				else {
+					return false;
 				}
-				else
-				{
-					ss << day << L" days ";
+
+				if (whole > limit / unit) {
+					return false;
 				}
-			}
-			if (houRest > 0 || day > 0 || week > 0 || year > 0)
-			{
-				if (houRest == 1 || houRest == 0)
-				{
-					ss << houRest << L" hour ";
+				uint64_t value = whole * unit;
+				if (hasFraction) {
+					// Rounded to the nanosecond; exact for at least 15 significant digits.
+					value += static_cast<uint64_t>(static_cast<double>(fraction) / static_cast<double>(fractionScale) * static_cast<double>(unit) + 0.5);
 				}
-				else
-				{
-					ss << houRest << L" hours ";
+				if (value > limit - total) {
+					return false;
 				}
+				total += value;
+			}
+
+			*duration = ItsDuration(negative ? static_cast<int64_t>(0 - total) : static_cast<int64_t>(total));
+			return true;
+		}
+
+	public:
+		static constexpr int64_t Nanosecond = 1;
+		static constexpr int64_t Microsecond = 1'000;
+		static constexpr int64_t Millisecond = 1'000'000;
+		static constexpr int64_t Second = 1'000'000'000;
+		static constexpr int64_t Minute = 60 * Second;
+		static constexpr int64_t Hour = 60 * Minute;
+		static constexpr int64_t Day = 24 * Hour;
+		static constexpr int64_t Week = 7 * Day;
+
+		//
+		// Buffer size needed by ToChars in any format.
+		//
+		static constexpr size_t MaxLength = 64;
+
+		constexpr ItsDuration() = default;
+
+		constexpr explicit ItsDuration(int64_t nanoseconds)
+			: m_ns(nanoseconds)
+		{
+		}
+
+		template<typename Rep, typename Period>
+		constexpr ItsDuration(std::chrono::duration<Rep, Period> duration)
+			: m_ns(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count())
+		{
+		}
+
+		static constexpr ItsDuration FromMicroseconds(int64_t value) { return ItsDuration(value * Microsecond); }
+		static constexpr ItsDuration FromMilliseconds(int64_t value) { return ItsDuration(value * Millisecond); }
+		static constexpr ItsDuration FromSeconds(int64_t value) { return ItsDuration(value * Second); }
+		static constexpr ItsDuration FromMinutes(int64_t value) { return ItsDuration(value * Minute); }
+		static constexpr ItsDuration FromHours(int64_t value) { return ItsDuration(value * Hour); }
+		static constexpr ItsDuration FromDays(int64_t value) { return ItsDuration(value * Day); }
+
+		constexpr int64_t TotalNanoseconds() const { return this->m_ns; }
+		constexpr int64_t TotalMicroseconds() const { return this->m_ns / Microsecond; }
+		constexpr int64_t TotalMilliseconds() const { return this->m_ns / Millisecond; }
+		constexpr int64_t TotalSeconds() const { return this->m_ns / Second; }
+		constexpr int64_t TotalMinutes() const { return this->m_ns / Minute; }
+		constexpr int64_t TotalHours() const { return this->m_ns / Hour; }
+		constexpr int64_t TotalDays() const { return this->m_ns / Day; }
+
+		constexpr std::chrono::nanoseconds ToChrono() const
+		{
+			return std::chrono::nanoseconds(this->m_ns);
+		}
+
+		constexpr bool IsNegative() const
+		{
+			return this->m_ns < 0;
+		}
+
+		constexpr ItsDuration Abs() const
+		{
+			return ItsDuration((this->m_ns < 0) ? -this->m_ns : this->m_ns);
+		}
+
+		//
+		// Years (52 weeks), weeks, days, hours, ... of the magnitude.
+		//
+		constexpr ItsDurationParts Split() const
+		{
+			ItsDurationParts parts;
+			parts.Negative = this->m_ns < 0;
+
+			uint64_t ns = this->Magnitude();
+			uint64_t seconds = ns / Second;
+			uint64_t subSecond = ns % Second;
+			parts.Milliseconds = subSecond / Millisecond;
+			parts.Microseconds = subSecond / Microsecond % 1000;
+			parts.Nanoseconds = subSecond % 1000;
+			parts.Seconds = seconds % 60;
+			parts.Minutes = seconds / 60 % 60;
+
+			uint64_t hours = seconds / 3600;
+			parts.Hours = hours % 24;
+			uint64_t days = hours / 24;
+			parts.Days = days % 7;
+			uint64_t weeks = days / 7;
+			parts.Weeks = weeks % 52;
+			parts.Years = weeks / 52;
+			return parts;
+		}
+
+		//
+		// Full / FullMilliseconds layout of parts, which may come from outside the int64 nanosecond
+		// range (see ItsTime). Room for MaxLength characters, not terminated. Returns characters written.
+		//
+		template<typename Char>
+		static size_t ToFullChars(const ItsDurationParts& parts, Char* out, bool withMilliseconds)
+		{
+			Char* p = out;
+			if (parts.Negative) {
+				*p++ = static_cast<Char>('-');
 			}
 
-			if (min < 10) {
-				ss << L"0" << min << L":";
+			bool larger = false;
+			if (parts.Years > 0) {
+				p = ItsDuration::WriteUnit(p, parts.Years, " year ", " years ");
+				larger = true;
 			}
-			else
-			{
-				ss << min << L":";
+			if (larger || parts.Weeks > 0) {
+				p = ItsDuration::WriteUnit(p, parts.Weeks, " week ", " weeks ");
+				larger = true;
 			}
-			if (sec < 10) {
-				ss << L"0" << sec;
+			if (larger || parts.Days > 0) {
+				p = ItsDuration::WriteUnit(p, parts.Days, " day ", " days ");
+				larger = true;
 			}
-			else
-			{
-				ss << sec;
+			if (larger || parts.Hours > 0) {
+				p = ItsDuration::WriteUnit(p, parts.Hours, " hour ", " hours ");
+			}
+			p = ItsDuration::WriteNumber(p, parts.Minutes, 2);
+			*p++ = static_cast<Char>(':');
+			p = ItsDuration::WriteNumber(p, parts.Seconds, 2);
+			if (withMilliseconds) {
+				*p++ = static_cast<Char>('.');
+				p = ItsDuration::WriteNumber(p, parts.Milliseconds, 3);
+			}
+			return static_cast<size_t>(p - out);
+		}
+
+		//
+		// Writes the duration to out (room for MaxLength characters, not terminated).
+		// Returns the number of characters written.
+		//
+		template<typename Char>
+		size_t ToChars(Char* out, ItsDurationFormat format) const
+		{
+			const ItsDurationParts parts = this->Split();
+			if (format == ItsDurationFormat::Full || format == ItsDurationFormat::FullMilliseconds) {
+				return ItsDuration::ToFullChars(parts, out, format == ItsDurationFormat::FullMilliseconds);
+			}
+
+			Char* p = out;
+			if (this->m_ns < 0) {
+				*p++ = static_cast<Char>('-');
 			}
 
-			if (bWithMilliseconds)
+			const uint64_t ns = this->Magnitude();
+			const uint64_t subSecond = ns % Second;
+
+			if (format == ItsDurationFormat::Compact)
 			{
-				if (ms < 10) {
-					ss << L".00" << ms;
+				if (ns == 0) {
+					p = ItsDuration::WriteText(p, "0s");
 				}
-				else if (ms < 100) {
-					ss << L".0" << ms;
+				else if (ns < Microsecond) {
+					p = ItsDuration::WriteNumber(p, ns);
+					p = ItsDuration::WriteText(p, "ns");
 				}
-				else {
-					ss << L"." << ms;
+				else if (ns < Millisecond) {
+					p = ItsDuration::WriteNumber(p, ns / Microsecond);
+					p = ItsDuration::WriteFraction(p, ns % Microsecond, 3);
+					p = ItsDuration::WriteText(p, "us");
+				}
+				else if (ns < Second) {
+					p = ItsDuration::WriteNumber(p, ns / Millisecond);
+					p = ItsDuration::WriteFraction(p, ns % Millisecond, 6);
+					p = ItsDuration::WriteText(p, "ms");
+				}
+				else
+				{
+					uint64_t days = ns / Day;
+					if (days > 0) {
+						p = ItsDuration::WriteNumber(p, days);
+						*p++ = static_cast<Char>('d');
+					}
+					if (parts.Hours > 0) {
+						p = ItsDuration::WriteNumber(p, parts.Hours);
+						*p++ = static_cast<Char>('h');
+					}
+					if (parts.Minutes > 0) {
+						p = ItsDuration::WriteNumber(p, parts.Minutes);
+						*p++ = static_cast<Char>('m');
+					}
+					if (parts.Seconds > 0 || subSecond > 0) {
+						p = ItsDuration::WriteNumber(p, parts.Seconds);
+						p = ItsDuration::WriteFraction(p, subSecond, 9);
+						*p++ = static_cast<Char>('s');
+					}
+				}
+			}
+			else
+			{
+				*p++ = static_cast<Char>('P');
+				uint64_t days = ns / Day;
+				if (days > 0) {
+					p = ItsDuration::WriteNumber(p, days);
+					*p++ = static_cast<Char>('D');
+				}
+				if (ns % Day != 0 || days == 0)
+				{
+					*p++ = static_cast<Char>('T');
+					if (parts.Hours > 0) {
+						p = ItsDuration::WriteNumber(p, parts.Hours);
+						*p++ = static_cast<Char>('H');
+					}
+					if (parts.Minutes > 0) {
+						p = ItsDuration::WriteNumber(p, parts.Minutes);
+						*p++ = static_cast<Char>('M');
+					}
+					if (parts.Seconds > 0 || subSecond > 0 || ns == 0) {
+						p = ItsDuration::WriteNumber(p, parts.Seconds);
+						p = ItsDuration::WriteFraction(p, subSecond, 9);
+						*p++ = static_cast<Char>('S');
+					}
 				}
 			}
+			return static_cast<size_t>(p - out);
+		}
 
-			wstring str = ss.str();
+		wstring ToString(ItsDurationFormat format = ItsDurationFormat::Compact) const
+		{
+			wchar_t buffer[ItsDuration::MaxLength];
+			return wstring(buffer, this->ToChars(buffer, format));
+		}
 
-			return str;
+		//
+		// Parses the compact form: an optional sign and one or more number-unit pairs,
+		// for example "1h30m", "1.5s", "250ms", "-2d4h" or "0". Units: w, d, h, m, s, ms, us, ns.
+		//
+		static bool Parse(std::wstring_view text, ItsDuration* duration)
+		{
+			return ItsDuration::ParseText(text.data(), text.size(), duration);
+		}
+		static bool Parse(std::string_view text, ItsDuration* duration)
+		{
+			return ItsDuration::ParseText(text.data(), text.size(), duration);
+		}
+
+		constexpr ItsDuration operator-() const { return ItsDuration(-this->m_ns); }
+		constexpr ItsDuration operator+(ItsDuration other) const { return ItsDuration(this->m_ns + other.m_ns); }
+		constexpr ItsDuration operator-(ItsDuration other) const { return ItsDuration(this->m_ns - other.m_ns); }
+		constexpr ItsDuration operator*(int64_t factor) const { return ItsDuration(this->m_ns * factor); }
+		constexpr ItsDuration operator/(int64_t divisor) const { return ItsDuration(this->m_ns / divisor); }
+		constexpr int64_t operator/(ItsDuration other) const { return this->m_ns / other.m_ns; }
+		constexpr ItsDuration& operator+=(ItsDuration other) { this->m_ns += other.m_ns; return *this; }
+		constexpr ItsDuration& operator-=(ItsDuration other) { this->m_ns -= other.m_ns; return *this; }
+		constexpr auto operator<=>(const ItsDuration& other) const = default;
+	};
+
+	//
+	// struct: ItsTime
+	//
+	// (i): Split milliseconds or render milliseconds to a friendly string.
+	//      Kept for existing callers. Works on size_t directly, so it is exact over the whole
+	//      size_t range (beyond ItsDuration's int64 nanoseconds); rendering uses ItsDuration's layout.
+	//
+	struct ItsTime
+	{
+		static void SplitMsToHourMinuteSeconds(size_t time_ms, size_t* part_hours, size_t* part_minutes, size_t* part_seconds, size_t* part_ms)
+		{
+			size_t seconds = time_ms / 1000;
+
+			*part_hours = seconds / 3600;
+			*part_minutes = seconds / 60 % 60;
+			*part_seconds = seconds % 60;
+			*part_ms = time_ms % 1000;
+		}
+
+		static void SplitHourToYearWeekDayHour(size_t houIn, size_t* houRest, size_t* day, size_t* week, size_t* year)
+		{
+			size_t days = houIn / 24;
+			size_t weeks = days / 7;
+
+			*houRest = houIn % 24;
+			*day = days % 7;
+			*week = weeks % 52;
+			*year = weeks / 52;
+		}
+
+		static wstring RenderMsToFullString(size_t milliseconds, bool bWithMilliseconds)
+		{
+			size_t hours = 0;
+			size_t minutes = 0;
+			size_t seconds = 0;
+			size_t ms = 0;
+			ItsTime::SplitMsToHourMinuteSeconds(milliseconds, &hours, &minutes, &seconds, &ms);
+
+			size_t houRest = 0;
+			size_t day = 0;
+			size_t week = 0;
+			size_t year = 0;
+			ItsTime::SplitHourToYearWeekDayHour(hours, &houRest, &day, &week, &year);
+
+			ItsDurationParts parts;
+			parts.Years = year;
+			parts.Weeks = week;
+			parts.Days = day;
+			parts.Hours = houRest;
+			parts.Minutes = minutes;
+			parts.Seconds = seconds;
+			parts.Milliseconds = ms;
+
+			wchar_t buffer[ItsDuration::MaxLength];
+			size_t length = ItsDuration::ToFullChars(parts, buffer, bWithMilliseconds);
+			return wstring(buffer, length);
 		}
 	};
 
@@ -508,760 +917,8314 @@ namespace ItSoftware
 	};
 
 	//
-	// enum: DataSizeStringType
+	// struct: ItsCpu
 	//
-	// (i): Enum for string representation of ToDataSizeString ItsConvert function.
+	// (i): Runtime detection of the instruction set extensions used by SIMD kernels.
 	//
-	enum class ItsDataSizeStringType {
-		Recommended,
-		IEC
+	struct ItsCpu
+	{
+	private:
+		struct Features
+		{
+			bool SSSE3{ false };
+			bool AVX2{ false };
+			bool InvariantTSC{ false };
+		};
+
+		static Features Detect()
+		{
+			Features f;
+#if defined(ITS_X86)
+			unsigned int regs[4]{ 0 };
+			unsigned int maxLeaf = 0;
+#if defined(_MSC_VER)
+			int r[4]{ 0 };
+			__cpuid(r, 0);
+			maxLeaf = static_cast<unsigned int>(r[0]);
+			__cpuidex(r, 1, 0);
+			for (int i = 0; i < 4; i++) { regs[i] = static_cast<unsigned int>(r[i]); }
+#else
+			maxLeaf = __get_cpuid_max(0, nullptr);
+			__cpuid_count(1, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif
+			f.SSSE3 = (regs[2] & (1u << 9)) != 0;
+
+			bool osxsave = (regs[2] & (1u << 27)) != 0;
+			bool avx = (regs[2] & (1u << 28)) != 0;
+			if (maxLeaf >= 7 && osxsave && avx)
+			{
+#if defined(_MSC_VER)
+				unsigned long long xcr0 = _xgetbv(0);
+				__cpuidex(r, 7, 0);
+				for (int i = 0; i < 4; i++) { regs[i] = static_cast<unsigned int>(r[i]); }
+#else
+				unsigned int eax = 0, edx = 0;
+				__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+				unsigned long long xcr0 = (static_cast<unsigned long long>(edx) << 32) | eax;
+				__cpuid_count(7, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif
+				// OS must save both XMM and YMM state.
+				f.AVX2 = ((xcr0 & 0x6) == 0x6) && (regs[1] & (1u << 5)) != 0;
+			}
+
+			// Invariant TSC: constant rate across P-, C- and T-states.
+#if defined(_MSC_VER)
+			__cpuid(r, static_cast<int>(0x80000000));
+			unsigned int maxExtLeaf = static_cast<unsigned int>(r[0]);
+			if (maxExtLeaf >= 0x80000007) {
+				__cpuid(r, static_cast<int>(0x80000007));
+				regs[3] = static_cast<unsigned int>(r[3]);
+			}
+#else
+			unsigned int maxExtLeaf = __get_cpuid_max(0x80000000, nullptr);
+			if (maxExtLeaf >= 0x80000007) {
+				__cpuid(0x80000007, regs[0], regs[1], regs[2], regs[3]);
+			}
+#endif
+			f.InvariantTSC = maxExtLeaf >= 0x80000007 && (regs[3] & (1u << 8)) != 0;
+#endif
+			return f;
+		}
+
+		static const Features& Get()
+		{
+			static const Features features = ItsCpu::Detect();
+			return features;
+		}
+	public:
+		static bool HasSSSE3()
+		{
+			return ItsCpu::Get().SSSE3;
+		}
+
+		static bool HasAVX2()
+		{
+			return ItsCpu::Get().AVX2;
+		}
+
+		static bool HasInvariantTSC()
+		{
+			return ItsCpu::Get().InvariantTSC;
+		}
 	};
 
 	//
-	// struct: ItsConvert
+	// struct: ItsUInt128
 	//
-	// (i): Misc. convertion routines in one place.
+	// (i): Minimal unsigned 128 bit arithmetic (wrapping) for generators and parsers.
 	//
-	struct ItsConvert
+	struct ItsUInt128
 	{
-		static wstring ToDataSizeString(size_t size)
+		uint64_t High{ 0 };
+		uint64_t Low{ 0 };
+
+		constexpr ItsUInt128() = default;
+
+		constexpr ItsUInt128(uint64_t high, uint64_t low)
+			: High(high), Low(low)
 		{
-			return ItsConvert::ToDataSizeString(size, 0);
 		}
-		static wstring ToDataSizeString(size_t size, int digits)
+
+		//
+		// Full 64 x 64 -> 128 bit product.
+		//
+		static ItsUInt128 Multiply(uint64_t a, uint64_t b)
 		{
-			return ItsConvert::ToDataSizeString(size, digits, ItsDataSizeStringType::Recommended);
+#if defined(_MSC_VER) && defined(_M_X64)
+			uint64_t high = 0;
+			uint64_t low = _umul128(a, b, &high);
+			return ItsUInt128(high, low);
+#elif defined(__SIZEOF_INT128__)
+			unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+			return ItsUInt128(static_cast<uint64_t>(r >> 64), static_cast<uint64_t>(r));
+#else
+			uint64_t aLo = a & 0xFFFFFFFF, aHi = a >> 32, bLo = b & 0xFFFFFFFF, bHi = b >> 32;
+			uint64_t lolo = aLo * bLo, hilo = aHi * bLo, lohi = aLo * bHi, hihi = aHi * bHi;
+			uint64_t cross = (lolo >> 32) + (hilo & 0xFFFFFFFF) + lohi;
+			return ItsUInt128(hihi + (hilo >> 32) + (cross >> 32), (cross << 32) | (lolo & 0xFFFFFFFF));
+#endif
 		}
-		static wstring ToDataSizeString(size_t size, int digits, ItsDataSizeStringType type)
+
+		ItsUInt128 operator*(const ItsUInt128& other) const
 		{
-			if (digits < 0)
-			{
-				digits = 0;
-			}
-			else if (digits > 3)
-			{
-				digits = 3;
-			}
+			ItsUInt128 r = ItsUInt128::Multiply(this->Low, other.Low);
+			r.High += this->Low * other.High + this->High * other.Low;
+			return r;
+		}
 
-			wstringstream ss;
-			double dSize = (double)size;
+		constexpr ItsUInt128 operator+(const ItsUInt128& other) const
+		{
+			uint64_t low = this->Low + other.Low;
+			return ItsUInt128(this->High + other.High + ((low < this->Low) ? 1 : 0), low);
+		}
 
-			int index = 0;
-			while (dSize >= 1024)
-			{
-				dSize /= 1024;
-				index++;
-			}
+		constexpr bool IsZero() const
+		{
+			return this->High == 0 && this->Low == 0;
+		}
 
-			vector<wstring> szSize;
-			if (type == ItsDataSizeStringType::IEC) {
-				szSize = { L"Bi", L"KiB", L"MiB", L"GiB", L"TiB", L"PiB", L"EiB", L"ZiB", L"YiB", L"BB", L"GP" };
-			}
-			else {//(type == ItsDataSizeStringType::Recommended) { // defaults to this notation
-				szSize = { L"B", L"KB", L"MB", L"GB", L"TB", L"PB", L"EB", L"ZB", L"YB", L"BB", L"GP" };
-			}
+		constexpr ItsUInt128 ShiftRight1() const
+		{
+			return ItsUInt128(this->High >> 1, (this->Low >> 1) | (this->High << 63));
+		}
 
-			size_t tst = (size_t)dSize;
-			ss << tst;
-			if (digits > 0) {
-				double t = dSize - tst;
-				wstring ws = ItsConvert::ToString<double>(t);
-				if (ws[0] == '0' && t != 0.0) {
-					ws += L"000";
-				}
-				else {
-					ws += L".000";
-				}
-				ss << ws.substr(1, static_cast<size_t>(digits) + 1);
+		constexpr bool operator==(const ItsUInt128& other) const = default;
+	};
+
+	//
+	// enum: ItsBase64Variant
+	//
+	// (i): Alphabet and padding used by ItsBase64.
+	//
+	enum class ItsBase64Variant
+	{
+		Standard,
+		StandardNoPadding,
+		UrlSafe,
+		UrlSafeNoPadding
+	};
+
+	//
+	// struct: ItsBase64
+	//
+	// (i): RFC 4648 Base64 on caller supplied buffers. Scalar, SSSE3 and AVX2 kernels, picked at runtime.
+	//      Decoding is strict: no whitespace, padding only at the end and no stray bits in the last quantum.
+	//
+	struct ItsBase64
+	{
+	private:
+		inline static constexpr const char* StandardAlphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+		inline static constexpr const char* UrlSafeAlphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+		static constexpr std::array<int8_t, 256> MakeDecodeTable(const char* alphabet)
+		{
+			std::array<int8_t, 256> table{};
+			for (auto& t : table) {
+				t = -1;
 			}
-			ss << L" ";
-			ss << ((index > (szSize.size() - 1) || index < 0) ? L"?" : szSize[index]);
+			for (int i = 0; i < 64; i++) {
+				table[static_cast<uint8_t>(alphabet[i])] = static_cast<int8_t>(i);
+			}
+			return table;
+		}
 
-			wstring retVal = ss.str();
-			return retVal;
+		static const int8_t* DecodeTable(bool urlSafe)
+		{
+			static constexpr std::array<int8_t, 256> standard = ItsBase64::MakeDecodeTable("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/");
+			static constexpr std::array<int8_t, 256> urlsafe = ItsBase64::MakeDecodeTable("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_");
+			return urlSafe ? urlsafe.data() : standard.data();
 		}
 
-#pragma warning(disable:4244)
-		template<typename Numeric>
-		static Numeric ToNumber(const wstring& str)
+		static constexpr bool IsUrlSafe(ItsBase64Variant variant)
 		{
-			if (std::is_same_v<Numeric, char>)
+			return variant == ItsBase64Variant::UrlSafe || variant == ItsBase64Variant::UrlSafeNoPadding;
+		}
+
+		static constexpr bool IsPadded(ItsBase64Variant variant)
+		{
+			return variant == ItsBase64Variant::Standard || variant == ItsBase64Variant::UrlSafe;
+		}
+
+#if defined(ITS_X86)
+		//
+		// SSSE3: 12 bytes -> 16 chars (W. Mula, D. Lemire). Returns number of input bytes consumed.
+		//
+		ITS_TARGET("ssse3")
+		static size_t EncodeSSSE3(const uint8_t* in, size_t size, char* out, bool urlSafe)
+		{
+			const __m128i shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+			const __m128i lut = _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, urlSafe ? -17 : -19, urlSafe ? 32 : -16, 0, 0);
+
+			size_t i = 0;
+			for (; i + 16 <= size; i += 12, out += 16)
 			{
-				return static_cast<char>(std::stoi(str));
+				__m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), shuffle);
+				__m128i t0 = _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+				__m128i t1 = _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+				__m128i idx = _mm_or_si128(t0, t1);
+				__m128i sel = _mm_sub_epi8(_mm_subs_epu8(idx, _mm_set1_epi8(51)), _mm_cmpgt_epi8(idx, _mm_set1_epi8(25)));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_add_epi8(idx, _mm_shuffle_epi8(lut, sel)));
 			}
-			else if (std::is_same_v<Numeric, unsigned char>)
+			return i;
+		}
+
+		//
+		// AVX2: 24 bytes -> 32 chars, one 12 byte group per 128 bit lane.
+		//
+		ITS_TARGET("avx2")
+		static size_t EncodeAVX2(const uint8_t* in, size_t size, char* out, bool urlSafe)
+		{
+			const __m256i shuffle = _mm256_broadcastsi128_si256(_mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+			const __m256i lut = _mm256_broadcastsi128_si256(_mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, urlSafe ? -17 : -19, urlSafe ? 32 : -16, 0, 0));
+
+			size_t i = 0;
+			for (; i + 28 <= size; i += 24, out += 32)
 			{
-				return static_cast<unsigned char>(std::stoi(str));
+				__m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))), _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 12)), 1);
+				v = _mm256_shuffle_epi8(v, shuffle);
+				__m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(v, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+				__m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(v, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+				__m256i idx = _mm256_or_si256(t0, t1);
+				__m256i sel = _mm256_sub_epi8(_mm256_subs_epu8(idx, _mm256_set1_epi8(51)), _mm256_cmpgt_epi8(idx, _mm256_set1_epi8(25)));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_add_epi8(idx, _mm256_shuffle_epi8(lut, sel)));
 			}
-			else if (std::is_same_v<Numeric, short>)
+			return i;
+		}
+
+		static __m128i InRange(__m128i v, char lo, char hi)
+		{
+			return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(static_cast<char>(lo - 1))), _mm_cmpgt_epi8(_mm_set1_epi8(static_cast<char>(hi + 1)), v));
+		}
+
+		ITS_TARGET("avx2")
+		static __m256i InRange(__m256i v, char lo, char hi)
+		{
+			return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(static_cast<char>(lo - 1))), _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(hi + 1)), v));
+		}
+
+		//
+		// SSSE3: 16 chars -> 12 bytes. Stops at the first block holding a non alphabet char and lets
+		//        the scalar code report it. Returns number of chars consumed.
+		//
+		ITS_TARGET("ssse3")
+		static size_t DecodeSSSE3(const char* in, size_t size, uint8_t* out, size_t capacity, bool urlSafe)
+		{
+			const char c62 = urlSafe ? '-' : '+';
+			const char c63 = urlSafe ? '_' : '/';
+			const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+			size_t i = 0;
+			size_t o = 0;
+			for (; i + 16 <= size && o + 16 <= capacity; i += 16, o += 12)
 			{
-				return static_cast<short>(std::stoi(str));
+				__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+				__m128i upper = ItsBase64::InRange(v, 'A', 'Z');
+				__m128i lower = ItsBase64::InRange(v, 'a', 'z');
+				__m128i digit = ItsBase64::InRange(v, '0', '9');
+				__m128i m62 = _mm_cmpeq_epi8(v, _mm_set1_epi8(c62));
+				__m128i m63 = _mm_cmpeq_epi8(v, _mm_set1_epi8(c63));
+				__m128i valid = _mm_or_si128(_mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, m62)), m63);
+				if (_mm_movemask_epi8(valid) != 0xFFFF) {
+					break;
+				}
+
+				__m128i delta = _mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(-65)), _mm_and_si128(lower, _mm_set1_epi8(-71)));
+				delta = _mm_or_si128(delta, _mm_and_si128(digit, _mm_set1_epi8(4)));
+				delta = _mm_or_si128(delta, _mm_and_si128(m62, _mm_set1_epi8(static_cast<char>(62 - c62))));
+				delta = _mm_or_si128(delta, _mm_and_si128(m63, _mm_set1_epi8(static_cast<char>(63 - c63))));
+				v = _mm_add_epi8(v, delta);
+
+				v = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+				v = _mm_madd_epi16(v, _mm_set1_epi32(0x00011000));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + o), _mm_shuffle_epi8(v, pack));
 			}
-			else if (std::is_same_v<Numeric, unsigned short>)
+			return i;
+		}
+
+		//
+		// AVX2: 32 chars -> 24 bytes.
+		//
+		ITS_TARGET("avx2")
+		static size_t DecodeAVX2(const char* in, size_t size, uint8_t* out, size_t capacity, bool urlSafe)
+		{
+			const char c62 = urlSafe ? '-' : '+';
+			const char c63 = urlSafe ? '_' : '/';
+			const __m256i pack = _mm256_broadcastsi128_si256(_mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+			size_t i = 0;
+			size_t o = 0;
+			for (; i + 32 <= size && o + 28 <= capacity; i += 32, o += 24)
 			{
-				return static_cast<unsigned short>(std::stoi(str));
+				__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+				__m256i upper = ItsBase64::InRange(v, 'A', 'Z');
+				__m256i lower = ItsBase64::InRange(v, 'a', 'z');
+				__m256i digit = ItsBase64::InRange(v, '0', '9');
+				__m256i m62 = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(c62));
+				__m256i m63 = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(c63));
+				__m256i valid = _mm256_or_si256(_mm256_or_si256(_mm256_or_si256(upper, lower), _mm256_or_si256(digit, m62)), m63);
+				if (_mm256_movemask_epi8(valid) != -1) {
+					break;
+				}
+
+				__m256i delta = _mm256_or_si256(_mm256_and_si256(upper, _mm256_set1_epi8(-65)), _mm256_and_si256(lower, _mm256_set1_epi8(-71)));
+				delta = _mm256_or_si256(delta, _mm256_and_si256(digit, _mm256_set1_epi8(4)));
+				delta = _mm256_or_si256(delta, _mm256_and_si256(m62, _mm256_set1_epi8(static_cast<char>(62 - c62))));
+				delta = _mm256_or_si256(delta, _mm256_and_si256(m63, _mm256_set1_epi8(static_cast<char>(63 - c63))));
+				v = _mm256_add_epi8(v, delta);
+
+				v = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+				v = _mm256_madd_epi16(v, _mm256_set1_epi32(0x00011000));
+				v = _mm256_shuffle_epi8(v, pack);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + o), _mm256_castsi256_si128(v));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + o + 12), _mm256_extracti128_si256(v, 1));
 			}
-			else if (std::is_same_v<Numeric, float>)
-			{
-				return std::stof(str);
+			return i;
+		}
+#endif
+	public:
+		static size_t EncodedLength(size_t size, ItsBase64Variant variant)
+		{
+			if (ItsBase64::IsPadded(variant)) {
+				return (size + 2) / 3 * 4;
 			}
-			else if (std::is_same_v<Numeric, double>)
-			{
-				return std::stod(str);
+			return size / 3 * 4 + ((size % 3 == 0) ? 0 : (size % 3) + 1);
+		}
+
+		//
+		// Upper bound of decoded bytes for text of given size.
+		//
+		static size_t DecodedMaxLength(size_t size)
+		{
+			return (size + 3) / 4 * 3;
+		}
+
+		//
+		// Encodes size bytes into out, which must hold EncodedLength chars. Returns chars written.
+		//
+		static size_t Encode(const uint8_t* in, size_t size, char* out, ItsBase64Variant variant)
+		{
+			const bool urlSafe = ItsBase64::IsUrlSafe(variant);
+			const char* alphabet = urlSafe ? UrlSafeAlphabet : StandardAlphabet;
+
+			size_t i = 0;
+			char* p = out;
+#if defined(ITS_X86)
+			if (ItsCpu::HasAVX2()) {
+				size_t n = ItsBase64::EncodeAVX2(in, size, p, urlSafe);
+				i += n;
+				p += n / 3 * 4;
 			}
-			else if (std::is_same_v <Numeric, long double>)
-			{
-				return std::stold(str);
+			if (ItsCpu::HasSSSE3()) {
+				size_t n = ItsBase64::EncodeSSSE3(in + i, size - i, p, urlSafe);
+				i += n;
+				p += n / 3 * 4;
 			}
-			else if (std::is_same_v<Numeric, int>)
+#endif
+			for (; i + 3 <= size; i += 3, p += 4)
 			{
-				return std::stoi(str);
+				uint32_t v = (static_cast<uint32_t>(in[i]) << 16) | (static_cast<uint32_t>(in[i + 1]) << 8) | in[i + 2];
+				p[0] = alphabet[v >> 18];
+				p[1] = alphabet[(v >> 12) & 0x3F];
+				p[2] = alphabet[(v >> 6) & 0x3F];
+				p[3] = alphabet[v & 0x3F];
 			}
-			else if (std::is_same_v<Numeric, long>)
+
+			size_t rest = size - i;
+			if (rest > 0)
 			{
-				return std::stol(str);
+				uint32_t v = static_cast<uint32_t>(in[i]) << 16;
+				if (rest == 2) {
+					v |= static_cast<uint32_t>(in[i + 1]) << 8;
+				}
+				*p++ = alphabet[v >> 18];
+				*p++ = alphabet[(v >> 12) & 0x3F];
+				if (rest == 2) {
+					*p++ = alphabet[(v >> 6) & 0x3F];
+				}
+				if (ItsBase64::IsPadded(variant)) {
+					if (rest == 1) {
+						*p++ = '=';
+					}
+					*p++ = '=';
+				}
 			}
-			else if (std::is_same_v<Numeric, long long>)
-			{
-				return std::stoll(str);
+
+			return static_cast<size_t>(p - out);
+		}
+
+		//
+		// Decodes size chars into out, which must hold DecodedMaxLength bytes.
+		// Returns false on malformed input. *written receives bytes produced.
+		//
+		static bool Decode(const char* in, size_t size, uint8_t* out, size_t* written, ItsBase64Variant variant)
+		{
+			*written = 0;
+
+			const bool urlSafe = ItsBase64::IsUrlSafe(variant);
+			const int8_t* table = ItsBase64::DecodeTable(urlSafe);
+
+			size_t rest = size % 4;
+			if (ItsBase64::IsPadded(variant) && rest != 0) {
+				return false;
 			}
-			else if (std::is_same_v<Numeric, unsigned int>)
-			{
-				return static_cast<unsigned int>(std::stoul(str));
+			if (rest == 1) {
+				return false;
 			}
-			else if (std::is_same_v<Numeric, unsigned long>)
+
+			// Last quantum (partial or possibly padded) is handled separately.
+			size_t body = (rest != 0) ? size - rest : ((size >= 4) ? size - 4 : 0);
+			size_t tail = size - body;
+
+			size_t i = 0;
+			size_t o = 0;
+#if defined(ITS_X86)
+			const size_t capacity = body / 4 * 3;
+			if (ItsCpu::HasAVX2()) {
+				size_t n = ItsBase64::DecodeAVX2(in, body, out, capacity, urlSafe);
+				i += n;
+				o += n / 4 * 3;
+			}
+			if (ItsCpu::HasSSSE3()) {
+				size_t n = ItsBase64::DecodeSSSE3(in + i, body - i, out + o, capacity - o, urlSafe);
+				i += n;
+				o += n / 4 * 3;
+			}
+#endif
+			for (; i < body; i += 4, o += 3)
 			{
-				return std::stoul(str);
+				int a = table[static_cast<uint8_t>(in[i])];
+				int b = table[static_cast<uint8_t>(in[i + 1])];
+				int c = table[static_cast<uint8_t>(in[i + 2])];
+				int d = table[static_cast<uint8_t>(in[i + 3])];
+				if ((a | b | c | d) < 0) {
+					return false;
+				}
+				uint32_t v = (static_cast<uint32_t>(a) << 18) | (static_cast<uint32_t>(b) << 12) | (static_cast<uint32_t>(c) << 6) | static_cast<uint32_t>(d);
+				out[o] = static_cast<uint8_t>(v >> 16);
+				out[o + 1] = static_cast<uint8_t>(v >> 8);
+				out[o + 2] = static_cast<uint8_t>(v);
 			}
-			else if (std::is_same_v<Numeric, unsigned long long>)
+
+			if (tail > 0)
 			{
-				return std::stoull(str);
+				const char* q = in + body;
+				size_t chars = tail;
+				if (tail == 4 && ItsBase64::IsPadded(variant))
+				{
+					if (q[3] == '=') {
+						chars = (q[2] == '=') ? 2 : 3;
+					}
+				}
+
+				int v[4]{ 0 };
+				for (size_t k = 0; k < chars; k++)
+				{
+					v[k] = table[static_cast<uint8_t>(q[k])];
+					if (v[k] < 0) {
+						return false;
+					}
+				}
+
+				uint32_t bits = (static_cast<uint32_t>(v[0]) << 18) | (static_cast<uint32_t>(v[1]) << 12) | (static_cast<uint32_t>(v[2]) << 6) | static_cast<uint32_t>(v[3]);
+				out[o++] = static_cast<uint8_t>(bits >> 16);
+				if (chars == 2 && (bits & 0xFFFF) != 0) {
+					return false;
+				}
+				if (chars >= 3) {
+					out[o++] = static_cast<uint8_t>(bits >> 8);
+				}
+				if (chars == 3 && (bits & 0xFF) != 0) {
+					return false;
+				}
+				if (chars == 4) {
+					out[o++] = static_cast<uint8_t>(bits);
+				}
 			}
 
-			Numeric x = std::stoull(str);
-			return x;
+			*written = o;
+			return true;
 		}
-#pragma warning(error: 4244)
-		static long ToLongFromHex(const wstring& str)
+	};
+
+	//
+	// enum: ItsBase32Variant
+	//
+	// (i): Padding used by ItsBase32.
+	//
+	enum class ItsBase32Variant
+	{
+		Standard,
+		StandardNoPadding
+	};
+
+	//
+	// struct: ItsBase32
+	//
+	// (i): RFC 4648 Base32 on caller supplied buffers. Scalar, SSSE3 and AVX2 kernels, picked at runtime.
+	//
+	struct ItsBase32
+	{
+	private:
+		inline static constexpr const char* Alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+
+		static constexpr std::array<int8_t, 256> MakeDecodeTable()
 		{
-			wchar_t* p;
-			long n = wcstol(str.c_str(), &p, 16);
-			if (*p != 0) {
-				return 0;
+			std::array<int8_t, 256> table{};
+			for (auto& t : table) {
+				t = -1;
 			}
-			return n;
+			for (int i = 0; i < 32; i++) {
+				table[static_cast<uint8_t>("ABCDEFGHIJKLMNOPQRSTUVWXYZ234567"[i])] = static_cast<int8_t>(i);
+			}
+			return table;
 		}
 
-		static wstring ToString(const bool flag)
+		static const int8_t* DecodeTable()
 		{
-			if (flag)
+			static constexpr std::array<int8_t, 256> table = ItsBase32::MakeDecodeTable();
+			return table.data();
+		}
+
+		static constexpr bool IsPadded(ItsBase32Variant variant)
+		{
+			return variant == ItsBase32Variant::Standard;
+		}
+
+		static constexpr size_t CharsForBytes(size_t bytes)
+		{
+			return (bytes * 8 + 4) / 5;
+		}
+
+#if defined(ITS_X86)
+		//
+		// Each 16 bit lane k gets the big endian byte pair holding 5 bit field k; mulhi by 2^(16-s)
+		// then shifts lane k right by s. One 5 byte group per 128 bit register.
+		//
+		ITS_TARGET("ssse3")
+		static __m128i EncodeIndices(__m128i v, __m128i shuffleLo, __m128i shuffleHi)
+		{
+			const __m128i shift = _mm_setr_epi16(32, 1024, 128, 4096, 512, 64, 2048, 256);
+			const __m128i mask = _mm_set1_epi16(31);
+			__m128i lo = _mm_and_si128(_mm_mulhi_epu16(_mm_shuffle_epi8(v, shuffleLo), shift), mask);
+			__m128i hi = _mm_and_si128(_mm_mulhi_epu16(_mm_shuffle_epi8(v, shuffleHi), shift), mask);
+			__m128i idx = _mm_packus_epi16(lo, hi);
+			__m128i delta = _mm_add_epi8(_mm_set1_epi8(24), _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), idx), _mm_set1_epi8(41)));
+			return _mm_add_epi8(idx, delta);
+		}
+
+		//
+		// SSSE3: 10 bytes -> 16 chars. Returns input bytes consumed.
+		//
+		ITS_TARGET("ssse3")
+		static size_t EncodeSSSE3(const uint8_t* in, size_t size, char* out)
+		{
+			const __m128i shuffleLo = _mm_setr_epi8(1, 0, 1, 0, 2, 1, 2, 1, 3, 2, 4, 3, 4, 3, 5, 4);
+			const __m128i shuffleHi = _mm_setr_epi8(6, 5, 6, 5, 7, 6, 7, 6, 8, 7, 9, 8, 9, 8, 10, 9);
+
+			size_t i = 0;
+			for (; i + 16 <= size; i += 10, out += 16)
 			{
-				return wstring(L"True");
+				__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out), ItsBase32::EncodeIndices(v, shuffleLo, shuffleHi));
 			}
-			return wstring(L"False");
+			return i;
 		}
 
-		template<typename Numeric>
-		static wstring ToString(Numeric number)
+		//
+		// AVX2: 20 bytes -> 32 chars, one 10 byte group per 128 bit lane.
+		//
+		ITS_TARGET("avx2")
+		static size_t EncodeAVX2(const uint8_t* in, size_t size, char* out)
 		{
-			wstringstream ss;
-			if (std::is_same_v<Numeric, float>)
+			const __m256i shuffleLo = _mm256_broadcastsi128_si256(_mm_setr_epi8(1, 0, 1, 0, 2, 1, 2, 1, 3, 2, 4, 3, 4, 3, 5, 4));
+			const __m256i shuffleHi = _mm256_broadcastsi128_si256(_mm_setr_epi8(6, 5, 6, 5, 7, 6, 7, 6, 8, 7, 9, 8, 9, 8, 10, 9));
+			const __m256i shift = _mm256_broadcastsi128_si256(_mm_setr_epi16(32, 1024, 128, 4096, 512, 64, 2048, 256));
+			const __m256i mask = _mm256_set1_epi16(31);
+
+			size_t i = 0;
+			for (; i + 26 <= size; i += 20, out += 32)
 			{
-				ss << std::setprecision(std::numeric_limits<float>::digits10);
+				__m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))), _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 10)), 1);
+				__m256i lo = _mm256_and_si256(_mm256_mulhi_epu16(_mm256_shuffle_epi8(v, shuffleLo), shift), mask);
+				__m256i hi = _mm256_and_si256(_mm256_mulhi_epu16(_mm256_shuffle_epi8(v, shuffleHi), shift), mask);
+				__m256i idx = _mm256_packus_epi16(lo, hi);
+				__m256i delta = _mm256_add_epi8(_mm256_set1_epi8(24), _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), idx), _mm256_set1_epi8(41)));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_add_epi8(idx, delta));
 			}
-			else if (std::is_same_v<Numeric, double>)
+			return i;
+		}
+
+		//
+		// SSSE3: 16 chars -> 10 bytes. Returns chars consumed.
+		//
+		ITS_TARGET("ssse3")
+		static size_t DecodeSSSE3(const char* in, size_t size, uint8_t* out, size_t capacity)
+		{
+			const __m128i pack = _mm_setr_epi8(4, 3, 2, 1, 0, 12, 11, 10, 9, 8, -1, -1, -1, -1, -1, -1);
+			const __m128i low32 = _mm_set1_epi64x(0xFFFFFFFF);
+
+			size_t i = 0;
+			size_t o = 0;
+			for (; i + 16 <= size && o + 16 <= capacity; i += 16, o += 10)
 			{
-				ss << std::setprecision(std::numeric_limits<double>::digits10);
+				__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+				__m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('Z' + 1), v));
+				__m128i digit = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('2' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('7' + 1), v));
+				if (_mm_movemask_epi8(_mm_or_si128(upper, digit)) != 0xFFFF) {
+					break;
+				}
+				v = _mm_add_epi8(v, _mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(-65)), _mm_and_si128(digit, _mm_set1_epi8(-24))));
+
+				v = _mm_maddubs_epi16(v, _mm_set1_epi16(0x0120));
+				v = _mm_madd_epi16(v, _mm_set1_epi32(0x00010400));
+				v = _mm_or_si128(_mm_slli_epi64(_mm_and_si128(v, low32), 20), _mm_srli_epi64(v, 32));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + o), _mm_shuffle_epi8(v, pack));
 			}
-			else if (std::is_same_v<Numeric, long double>)
+			return i;
+		}
+
+		//
+		// AVX2: 32 chars -> 20 bytes.
+		//
+		ITS_TARGET("avx2")
+		static size_t DecodeAVX2(const char* in, size_t size, uint8_t* out, size_t capacity)
+		{
+			const __m256i pack = _mm256_broadcastsi128_si256(_mm_setr_epi8(4, 3, 2, 1, 0, 12, 11, 10, 9, 8, -1, -1, -1, -1, -1, -1));
+			const __m256i low32 = _mm256_set1_epi64x(0xFFFFFFFF);
+
+			size_t i = 0;
+			size_t o = 0;
+			for (; i + 32 <= size && o + 26 <= capacity; i += 32, o += 20)
 			{
-				ss << std::setprecision(std::numeric_limits<long double>::digits10);
+				__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+				__m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), v));
+				__m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('2' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('7' + 1), v));
+				if (_mm256_movemask_epi8(_mm256_or_si256(upper, digit)) != -1) {
+					break;
+				}
+				v = _mm256_add_epi8(v, _mm256_or_si256(_mm256_and_si256(upper, _mm256_set1_epi8(-65)), _mm256_and_si256(digit, _mm256_set1_epi8(-24))));
+
+				v = _mm256_maddubs_epi16(v, _mm256_set1_epi16(0x0120));
+				v = _mm256_madd_epi16(v, _mm256_set1_epi32(0x00010400));
+				v = _mm256_or_si256(_mm256_slli_epi64(_mm256_and_si256(v, low32), 20), _mm256_srli_epi64(v, 32));
+				v = _mm256_shuffle_epi8(v, pack);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + o), _mm256_castsi256_si128(v));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + o + 10), _mm256_extracti128_si256(v, 1));
 			}
-			ss << number;
-
-			wstring tos = ss.str();
-			return tos;
+			return i;
+		}
+#endif
+	public:
+		static size_t EncodedLength(size_t size, ItsBase32Variant variant)
+		{
+			if (ItsBase32::IsPadded(variant)) {
+				return (size + 4) / 5 * 8;
+			}
+			return size / 5 * 8 + ItsBase32::CharsForBytes(size % 5);
 		}
 
-		static wstring ToStringFormatted(size_t number, wchar_t thousandSep = L',')
+		static size_t DecodedMaxLength(size_t size)
 		{
-			wstring txt = ItsConvert::ToString(number);
+			return (size + 7) / 8 * 5;
+		}
 
-			wstringstream ss;
+		static size_t Encode(const uint8_t* in, size_t size, char* out, ItsBase32Variant variant)
+		{
+			size_t i = 0;
+			char* p = out;
+#if defined(ITS_X86)
+			if (ItsCpu::HasAVX2()) {
+				size_t n = ItsBase32::EncodeAVX2(in, size, p);
+				i += n;
+				p += n / 5 * 8;
+			}
+			if (ItsCpu::HasSSSE3()) {
+				size_t n = ItsBase32::EncodeSSSE3(in + i, size - i, p);
+				i += n;
+				p += n / 5 * 8;
+			}
+#endif
+			for (; i + 5 <= size; i += 5, p += 8)
+			{
+				uint64_t v = (static_cast<uint64_t>(in[i]) << 32) | (static_cast<uint64_t>(in[i + 1]) << 24) | (static_cast<uint64_t>(in[i + 2]) << 16) | (static_cast<uint64_t>(in[i + 3]) << 8) | in[i + 4];
+				for (int k = 0; k < 8; k++) {
+					p[k] = Alphabet[(v >> (35 - 5 * k)) & 0x1F];
+				}
+			}
 
-			int groupSize = 3;
-			int i = groupSize;
-			size_t iCount = 0;
-			size_t iSize = txt.size();
-			for (auto itr = txt.rbegin(); itr < txt.rend(); itr++)
+			size_t rest = size - i;
+			if (rest > 0)
 			{
-				if (i-- > 0)
-				{
-					ss << *itr;
-					iCount++;
+				uint64_t v = 0;
+				for (size_t k = 0; k < rest; k++) {
+					v |= static_cast<uint64_t>(in[i + k]) << (32 - 8 * k);
 				}
-				else
-				{
-					if (iCount < iSize)
-					{
-						ss << thousandSep;
-						ss << *itr;
-						iCount++;
-						i = groupSize - 1;
-					}
-					else {
-						i = groupSize;
+				size_t chars = ItsBase32::CharsForBytes(rest);
+				for (size_t k = 0; k < chars; k++) {
+					*p++ = Alphabet[(v >> (35 - 5 * k)) & 0x1F];
+				}
+				if (ItsBase32::IsPadded(variant)) {
+					for (size_t k = chars; k < 8; k++) {
+						*p++ = '=';
 					}
 				}
+			}
+
+			return static_cast<size_t>(p - out);
+		}
+
+		static bool Decode(const char* in, size_t size, uint8_t* out, size_t* written, ItsBase32Variant variant)
+		{
+			*written = 0;
+
+			const int8_t* table = ItsBase32::DecodeTable();
+
+			size_t rest = size % 8;
+			if (ItsBase32::IsPadded(variant) && rest != 0) {
+				return false;
+			}
+			if (rest == 1 || rest == 3 || rest == 6) {
+				return false;
+			}
+
+			size_t body = (rest != 0) ? size - rest : ((size >= 8) ? size - 8 : 0);
+			size_t tail = size - body;
+
+			size_t i = 0;
+			size_t o = 0;
+#if defined(ITS_X86)
+			const size_t capacity = body / 8 * 5;
+			if (ItsCpu::HasAVX2()) {
+				size_t n = ItsBase32::DecodeAVX2(in, body, out, capacity);
+				i += n;
+				o += n / 8 * 5;
+			}
+			if (ItsCpu::HasSSSE3()) {
+				size_t n = ItsBase32::DecodeSSSE3(in + i, body - i, out + o, capacity - o);
+				i += n;
+				o += n / 8 * 5;
+			}
+#endif
+			for (; i < body; i += 8, o += 5)
+			{
+				uint64_t v = 0;
+				int check = 0;
+				for (int k = 0; k < 8; k++) {
+					int c = table[static_cast<uint8_t>(in[i + k])];
+					check |= c;
+					v = (v << 5) | static_cast<uint64_t>(c & 0x1F);
+				}
+				if (check < 0) {
+					return false;
+				}
+				for (int k = 0; k < 5; k++) {
+					out[o + k] = static_cast<uint8_t>(v >> (32 - 8 * k));
+				}
+			}
+
+			if (tail > 0)
+			{
+				const char* q = in + body;
+				size_t chars = tail;
+				while (chars > 0 && q[chars - 1] == '=') {
+					chars--;
+				}
+				if (chars != tail && !ItsBase32::IsPadded(variant)) {
+					return false;
+				}
+
+				// A final group holds 2, 4, 5, 7 or 8 symbols, so padding is 6, 4, 3, 1 or none.
+				size_t padding = tail - chars;
+				if (chars == 0 || chars == 1 || chars == 3 || chars == 6 ||
+					(padding != 0 && padding != 1 && padding != 3 && padding != 4 && padding != 6)) {
+					return false;
+				}
+
+				uint64_t v = 0;
+				for (size_t k = 0; k < chars; k++) {
+					int c = table[static_cast<uint8_t>(q[k])];
+					if (c < 0) {
+						return false;
+					}
+					v |= static_cast<uint64_t>(c) << (35 - 5 * k);
+				}
+
+				size_t bytes = chars * 5 / 8;
+				if ((v & ((uint64_t(1) << (40 - 8 * bytes)) - 1)) != 0) {
+					return false;
+				}
+				for (size_t k = 0; k < bytes; k++) {
+					out[o++] = static_cast<uint8_t>(v >> (32 - 8 * k));
+				}
+			}
+
+			*written = o;
+			return true;
+		}
+	};
+
+	//
+	// struct: ItsBase64Codec, ItsBase32Codec
+	//
+	// (i): Codec traits for ItsEncoderStream and ItsDecoderStream.
+	//
+	struct ItsBase64Codec
+	{
+		using Variant = ItsBase64Variant;
+		inline static constexpr size_t BytesPerQuantum = 3;
+		inline static constexpr size_t CharsPerQuantum = 4;
+		static size_t EncodedLength(size_t size, Variant v) { return ItsBase64::EncodedLength(size, v); }
+		static size_t DecodedMaxLength(size_t size) { return ItsBase64::DecodedMaxLength(size); }
+		static size_t Encode(const uint8_t* in, size_t size, char* out, Variant v) { return ItsBase64::Encode(in, size, out, v); }
+		static bool Decode(const char* in, size_t size, uint8_t* out, size_t* written, Variant v) { return ItsBase64::Decode(in, size, out, written, v); }
+		static bool IsPadded(Variant v) { return v == ItsBase64Variant::Standard || v == ItsBase64Variant::UrlSafe; }
+	};
+
+	struct ItsBase32Codec
+	{
+		using Variant = ItsBase32Variant;
+		inline static constexpr size_t BytesPerQuantum = 5;
+		inline static constexpr size_t CharsPerQuantum = 8;
+		static size_t EncodedLength(size_t size, Variant v) { return ItsBase32::EncodedLength(size, v); }
+		static size_t DecodedMaxLength(size_t size) { return ItsBase32::DecodedMaxLength(size); }
+		static size_t Encode(const uint8_t* in, size_t size, char* out, Variant v) { return ItsBase32::Encode(in, size, out, v); }
+		static bool Decode(const char* in, size_t size, uint8_t* out, size_t* written, Variant v) { return ItsBase32::Decode(in, size, out, written, v); }
+		static bool IsPadded(Variant v) { return v == ItsBase32Variant::Standard; }
+	};
+
+	//
+	// class: ItsEncoderStream
+	//
+	// (i): Incremental encoder for data arriving in chunks (e.g. ItsFile::Read).
+	//      Call Update for each chunk and Final once at the end.
+	//
+	template<typename Codec>
+	class ItsEncoderStream
+	{
+	private:
+		typename Codec::Variant m_variant;
+		uint8_t m_pending[Codec::BytesPerQuantum]{ 0 };
+		size_t m_pendingSize{ 0 };
+	public:
+		explicit ItsEncoderStream(typename Codec::Variant variant)
+			: m_variant(variant)
+		{
+		}
+
+		void Update(const void* data, size_t size, string& out)
+		{
+			const uint8_t* p = static_cast<const uint8_t*>(data);
+			if (this->m_pendingSize > 0)
+			{
+				while (this->m_pendingSize < Codec::BytesPerQuantum && size > 0) {
+					this->m_pending[this->m_pendingSize++] = *p++;
+					size--;
+				}
+				if (this->m_pendingSize < Codec::BytesPerQuantum) {
+					return;
+				}
+				size_t pos = out.size();
+				out.resize(pos + Codec::CharsPerQuantum);
+				Codec::Encode(this->m_pending, Codec::BytesPerQuantum, &out[pos], this->m_variant);
+				this->m_pendingSize = 0;
+			}
+
+			size_t whole = size / Codec::BytesPerQuantum * Codec::BytesPerQuantum;
+			if (whole > 0)
+			{
+				size_t pos = out.size();
+				out.resize(pos + whole / Codec::BytesPerQuantum * Codec::CharsPerQuantum);
+				Codec::Encode(p, whole, &out[pos], this->m_variant);
+			}
+
+			for (size_t i = whole; i < size; i++) {
+				this->m_pending[this->m_pendingSize++] = p[i];
+			}
+		}
+
+		void Final(string& out)
+		{
+			if (this->m_pendingSize > 0)
+			{
+				size_t pos = out.size();
+				out.resize(pos + Codec::EncodedLength(this->m_pendingSize, this->m_variant));
+				Codec::Encode(this->m_pending, this->m_pendingSize, &out[pos], this->m_variant);
+			}
+			this->m_pendingSize = 0;
+		}
+	};
+
+	//
+	// class: ItsDecoderStream
+	//
+	// (i): Incremental strict decoder. Update/Final return false on malformed input,
+	//      including data after the padded final quantum.
+	//
+	template<typename Codec>
+	class ItsDecoderStream
+	{
+	private:
+		typename Codec::Variant m_variant;
+		char m_pending[Codec::CharsPerQuantum]{ 0 };
+		size_t m_pendingSize{ 0 };
+		bool m_finished{ false };
+
+		bool DecodeQuanta(const char* text, size_t size, vector<uint8_t>& out)
+		{
+			size_t pos = out.size();
+			out.resize(pos + Codec::DecodedMaxLength(size));
+			size_t written = 0;
+			bool ok = Codec::Decode(text, size, out.data() + pos, &written, this->m_variant);
+			out.resize(pos + written);
+			if (ok && size > 0 && text[size - 1] == '=') {
+				this->m_finished = true;
+			}
+			return ok;
+		}
+	public:
+		explicit ItsDecoderStream(typename Codec::Variant variant)
+			: m_variant(variant)
+		{
+		}
+
+		bool Update(const char* text, size_t size, vector<uint8_t>& out)
+		{
+			if (size == 0) {
+				return true;
+			}
+			if (this->m_finished) {
+				return false;
+			}
+
+			if (this->m_pendingSize > 0)
+			{
+				while (this->m_pendingSize < Codec::CharsPerQuantum && size > 0) {
+					this->m_pending[this->m_pendingSize++] = *text++;
+					size--;
+				}
+				if (this->m_pendingSize < Codec::CharsPerQuantum) {
+					return true;
+				}
+				this->m_pendingSize = 0;
+				if (!this->DecodeQuanta(this->m_pending, Codec::CharsPerQuantum, out)) {
+					return false;
+				}
+				if (this->m_finished && size > 0) {
+					return false;
+				}
+			}
+
+			size_t whole = size / Codec::CharsPerQuantum * Codec::CharsPerQuantum;
+			if (whole > 0 && !this->DecodeQuanta(text, whole, out)) {
+				return false;
+			}
+			if (this->m_finished && whole < size) {
+				return false;
+			}
+
+			for (size_t i = whole; i < size; i++) {
+				this->m_pending[this->m_pendingSize++] = text[i];
+			}
+			return true;
+		}
+
+		bool Update(const string& text, vector<uint8_t>& out)
+		{
+			return this->Update(text.data(), text.size(), out);
+		}
+
+		bool Final(vector<uint8_t>& out)
+		{
+			bool ok = true;
+			if (this->m_pendingSize > 0)
+			{
+				ok = !Codec::IsPadded(this->m_variant) && this->DecodeQuanta(this->m_pending, this->m_pendingSize, out);
+			}
+			this->m_pendingSize = 0;
+			this->m_finished = false;
+			return ok;
+		}
+	};
+
+	using ItsBase64Encoder = ItsEncoderStream<ItsBase64Codec>;
+	using ItsBase64Decoder = ItsDecoderStream<ItsBase64Codec>;
+	using ItsBase32Encoder = ItsEncoderStream<ItsBase32Codec>;
+	using ItsBase32Decoder = ItsDecoderStream<ItsBase32Codec>;
+
+	//
+	// struct: ItsPKList
+	//
+	// (i): Kernels for ';' separated primary key lists and their binary delta/varint form.
+	//      Delimiters are located 16/32 bytes at a time, digits are converted 8 at a time (SWAR).
+	//
+	struct ItsPKList
+	{
+	private:
+		inline static constexpr const char* DigitPairs =
+			"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+			"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+			"8081828384858687888990919293949596979899";
+
+		inline static constexpr uint64_t PowersOf10[20] = {
+			1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+			10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull,
+			1000000000000000ull, 10000000000000000ull, 100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull
+		};
+
+		static bool IsEightDigits(uint64_t v)
+		{
+			return (((v & 0xF0F0F0F0F0F0F0F0ull) | (((v + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull);
+		}
+
+		static uint32_t ParseEightDigits(uint64_t v)
+		{
+			v = (v & 0x0F0F0F0F0F0F0F0Full) * 2561 >> 8;
+			v = (v & 0x00FF00FF00FF00FFull) * 6553601 >> 16;
+			return static_cast<uint32_t>((v & 0x0000FFFF0000FFFFull) * 42949672960001ull >> 32);
+		}
+
+		static bool IsSpace(char c)
+		{
+			return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+		}
+
+		static uint64_t ZigZag(int64_t v)
+		{
+			return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+		}
+
+		static int64_t UnZigZag(uint64_t v)
+		{
+			return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+		}
+
+		static void PutVarint(vector<uint8_t>& out, uint64_t v)
+		{
+			while (v >= 0x80) {
+				out.push_back(static_cast<uint8_t>(v | 0x80));
+				v >>= 7;
+			}
+			out.push_back(static_cast<uint8_t>(v));
+		}
+
+		static bool GetVarint(const uint8_t*& p, const uint8_t* end, uint64_t* v)
+		{
+			uint64_t result = 0;
+			for (int shift = 0; shift < 64 && p < end; shift += 7)
+			{
+				uint8_t b = *p++;
+				result |= static_cast<uint64_t>(b & 0x7F) << shift;
+				if ((b & 0x80) == 0) {
+					*v = result;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		//
+		// Bitmask of delimiter positions in the 16 (or 32) bytes at p.
+		//
+#if defined(ITS_X86)
+		static uint32_t DelimiterMask16(const char* p, char delimiter)
+		{
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+			return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(delimiter))));
+		}
+
+		ITS_TARGET("avx2")
+		static uint32_t DelimiterMask32(const char* p, char delimiter)
+		{
+			__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+			return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(delimiter))));
+		}
+#endif
+	public:
+		inline static constexpr char Delimiter = ';';
+
+		//
+		// Parses one token: optional surrounding whitespace, optional sign and decimal digits.
+		//
+		static bool ParseInt64(const char* p, size_t size, long long* value)
+		{
+			while (size > 0 && ItsPKList::IsSpace(*p)) {
+				p++;
+				size--;
+			}
+			while (size > 0 && ItsPKList::IsSpace(p[size - 1])) {
+				size--;
+			}
+
+			bool negative = false;
+			if (size > 0 && (*p == '-' || *p == '+')) {
+				negative = (*p == '-');
+				p++;
+				size--;
+			}
+			if (size == 0) {
+				return false;
+			}
+			while (size > 1 && *p == '0') {
+				p++;
+				size--;
+			}
+			if (size > 19) {
+				return false;
+			}
+
+			uint64_t u = 0;
+			while (size >= 8)
+			{
+				uint64_t chunk;
+				memcpy(&chunk, p, sizeof(chunk));
+				if (!ItsPKList::IsEightDigits(chunk)) {
+					return false;
+				}
+				u = u * 100000000ull + ItsPKList::ParseEightDigits(chunk);
+				p += 8;
+				size -= 8;
+			}
+			while (size > 0)
+			{
+				unsigned int d = static_cast<unsigned int>(static_cast<unsigned char>(*p) - '0');
+				if (d > 9) {
+					return false;
+				}
+				u = u * 10 + d;
+				p++;
+				size--;
+			}
+
+			const uint64_t limit = negative ? 9223372036854775808ull : 9223372036854775807ull;
+			if (u > limit) {
+				return false;
+			}
+			*value = negative ? static_cast<long long>(0 - u) : static_cast<long long>(u);
+			return true;
+		}
+
+		static size_t CountDelimiters(const char* p, size_t size)
+		{
+			size_t count = 0;
+			size_t i = 0;
+#if defined(ITS_X86)
+			if (ItsCpu::HasAVX2()) {
+				for (; i + 32 <= size; i += 32) {
+					count += std::popcount(ItsPKList::DelimiterMask32(p + i, Delimiter));
+				}
+			}
+			for (; i + 16 <= size; i += 16) {
+				count += std::popcount(ItsPKList::DelimiterMask16(p + i, Delimiter));
+			}
+#endif
+			for (; i < size; i++) {
+				count += (p[i] == Delimiter) ? 1 : 0;
+			}
+			return count;
+		}
+
+		//
+		// Calls emit(long long) for every non empty token. Returns false on the first malformed token
+		// or when emit returns false.
+		//
+		template<typename Emit>
+		static bool Parse(const char* p, size_t size, Emit&& emit)
+		{
+			size_t start = 0;
+			auto token = [&](size_t end) -> bool {
+				size_t length = end - start;
+				bool blank = true;
+				for (size_t k = 0; k < length && blank; k++) {
+					blank = ItsPKList::IsSpace(p[start + k]);
+				}
+				if (!blank)
+				{
+					long long value = 0;
+					if (!ItsPKList::ParseInt64(p + start, length, &value) || !emit(value)) {
+						return false;
+					}
+				}
+				start = end + 1;
+				return true;
+			};
+
+			size_t i = 0;
+#if defined(ITS_X86)
+			const bool avx2 = ItsCpu::HasAVX2();
+			const size_t block = avx2 ? 32 : 16;
+			for (; i + block <= size; i += block)
+			{
+				uint32_t mask = avx2 ? ItsPKList::DelimiterMask32(p + i, Delimiter) : ItsPKList::DelimiterMask16(p + i, Delimiter);
+				while (mask != 0)
+				{
+					if (!token(i + static_cast<size_t>(std::countr_zero(mask)))) {
+						return false;
+					}
+					mask &= mask - 1;
+				}
+			}
+#endif
+			for (; i < size; i++)
+			{
+				if (p[i] == Delimiter && !token(i)) {
+					return false;
+				}
+			}
+			return token(size);
+		}
+
+		static size_t DigitCount(uint64_t v)
+		{
+			v |= 1;
+			size_t t = (static_cast<size_t>(std::bit_width(v)) * 1233) >> 12;
+			return t + (v >= PowersOf10[t] ? 1 : 0);
+		}
+
+		static size_t FormattedLength(std::span<const long long> values)
+		{
+			if (values.empty()) {
+				return 0;
+			}
+			size_t length = values.size() - 1;
+			for (long long v : values)
+			{
+				uint64_t u = (v < 0) ? 0 - static_cast<uint64_t>(v) : static_cast<uint64_t>(v);
+				length += ItsPKList::DigitCount(u) + ((v < 0) ? 1 : 0);
+			}
+			return length;
+		}
+
+		//
+		// Writes the ';' separated list into out, which must hold FormattedLength chars. Returns chars written.
+		//
+		template<typename Char>
+		static size_t Format(std::span<const long long> values, Char* out)
+		{
+			Char* p = out;
+			for (size_t i = 0; i < values.size(); i++)
+			{
+				if (i > 0) {
+					*p++ = static_cast<Char>(Delimiter);
+				}
+				long long v = values[i];
+				uint64_t u = (v < 0) ? 0 - static_cast<uint64_t>(v) : static_cast<uint64_t>(v);
+				if (v < 0) {
+					*p++ = static_cast<Char>('-');
+				}
+
+				size_t digits = ItsPKList::DigitCount(u);
+				Char* q = p + digits;
+				while (u >= 100)
+				{
+					size_t pair = static_cast<size_t>(u % 100) * 2;
+					u /= 100;
+					*--q = static_cast<Char>(DigitPairs[pair + 1]);
+					*--q = static_cast<Char>(DigitPairs[pair]);
+				}
+				if (u >= 10) {
+					*--q = static_cast<Char>(DigitPairs[u * 2 + 1]);
+					*--q = static_cast<Char>(DigitPairs[u * 2]);
+				}
+				else {
+					*--q = static_cast<Char>('0' + u);
+				}
+				p += digits;
+			}
+			return static_cast<size_t>(p - out);
+		}
+
+		//
+		// Binary form: varint count followed by zigzag varint deltas. Sorted id lists
+		// typically take 1-3 bytes per id.
+		//
+		static vector<uint8_t> EncodeBinary(std::span<const long long> values)
+		{
+			vector<uint8_t> out;
+			out.reserve(values.size() * 2 + 10);
+			ItsPKList::PutVarint(out, values.size());
+			long long previous = 0;
+			for (long long v : values)
+			{
+				ItsPKList::PutVarint(out, ItsPKList::ZigZag(static_cast<int64_t>(static_cast<uint64_t>(v) - static_cast<uint64_t>(previous))));
+				previous = v;
+			}
+			return out;
+		}
+
+		static bool DecodeBinary(const uint8_t* data, size_t size, vector<long long>& values)
+		{
+			const uint8_t* p = data;
+			const uint8_t* end = data + size;
+			uint64_t count = 0;
+			if (!ItsPKList::GetVarint(p, end, &count) || count > size) {
+				return false;
+			}
+
+			values.clear();
+			values.reserve(static_cast<size_t>(count));
+			uint64_t previous = 0;
+			for (uint64_t i = 0; i < count; i++)
+			{
+				uint64_t delta = 0;
+				if (!ItsPKList::GetVarint(p, end, &delta)) {
+					return false;
+				}
+				previous += static_cast<uint64_t>(ItsPKList::UnZigZag(delta));
+				values.push_back(static_cast<long long>(previous));
+			}
+			return p == end;
+		}
+	};
+
+	//
+	// struct: ItsCivil
+	//
+	// (i): Proleptic Gregorian calendar on days since 1970-01-01, after H. Hinnant's
+	//      days_from_civil / civil_from_days. All O(1) and constexpr.
+	//
+	struct ItsCivil
+	{
+		struct Date
+		{
+			int Year{ 1970 };
+			int Month{ 1 };
+			int Day{ 1 };
+		};
+
+		static constexpr bool IsLeapYear(int year)
+		{
+			return (year % 4 == 0) && (year % 100 != 0 || year % 400 == 0);
+		}
+
+		static constexpr int DaysInMonth(int year, int month)
+		{
+			constexpr int days[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+			return (month == 2 && ItsCivil::IsLeapYear(year)) ? 29 : days[month - 1];
+		}
+
+		//
+		// Days since 1970-01-01.
+		//
+		static constexpr int64_t DaysFromCivil(int y, int m, int d)
+		{
+			y -= (m <= 2) ? 1 : 0;
+			const int64_t era = (y >= 0 ? y : y - 399) / 400;
+			const unsigned int yoe = static_cast<unsigned int>(y - era * 400);
+			const unsigned int doy = (153 * static_cast<unsigned int>(m > 2 ? m - 3 : m + 9) + 2) / 5 + static_cast<unsigned int>(d) - 1;
+			const unsigned int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+			return era * 146097 + static_cast<int64_t>(doe) - 719468;
+		}
+
+		static constexpr Date CivilFromDays(int64_t days)
+		{
+			days += 719468;
+			const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+			const unsigned int doe = static_cast<unsigned int>(days - era * 146097);
+			const unsigned int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+			const unsigned int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+			const unsigned int mp = (5 * doy + 2) / 153;
+			Date date;
+			date.Day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+			date.Month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+			date.Year = static_cast<int>(static_cast<int64_t>(yoe) + era * 400 + (date.Month <= 2 ? 1 : 0));
+			return date;
+		}
+
+		//
+		// 0 = Sunday ... 6 = Saturday.
+		//
+		static constexpr int WeekdayFromDays(int64_t days)
+		{
+			return static_cast<int>((days >= -4) ? (days + 4) % 7 : (days + 5) % 7 + 6);
+		}
+
+		//
+		// 0 = January 1st.
+		//
+		static constexpr int DayOfYear(int year, int month, int day)
+		{
+			constexpr int daysBeforeMonth[12] = { 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334 };
+			return daysBeforeMonth[month - 1] + day - 1 + ((month > 2 && ItsCivil::IsLeapYear(year)) ? 1 : 0);
+		}
+	};
+
+	//
+	// struct: ItsTimestamp
+	//
+	// (i): Result of ISO-8601 parsing. Fraction and offset are optional in the text.
+	//
+	struct ItsTimestamp
+	{
+		tm DateTime{ 0 };
+		uint32_t Nanosecond{ 0 };
+		int32_t OffsetMinutes{ 0 };
+		bool HasOffset{ false };
+	};
+
+	//
+	// struct: ItsISO8601
+	//
+	// (i): Fixed layout ISO-8601 parse and format: YYYY-MM-DDTHH:MM:SS[.fffffffff][Z|+hh:mm|-hh:mm].
+	//      A space is accepted in place of 'T'. Fields are validated and converted with SWAR arithmetic.
+	//
+	struct ItsISO8601
+	{
+	private:
+		inline static constexpr const char* DigitPairs =
+			"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+			"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+			"8081828384858687888990919293949596979899";
+
+		//
+		// Checks 8 chars at p: lanes in digitLanes must be digits, lanes in separatorLanes must equal pattern.
+		// On success lane i of *pairs holds digit[i] * 10 + digit[i + 1].
+		//
+		static bool Pairs(const char* p, uint64_t digitLanes, uint64_t separatorLanes, uint64_t pattern, uint64_t* pairs)
+		{
+			uint64_t w;
+			memcpy(&w, p, sizeof(w));
+			if (((w ^ pattern) & separatorLanes) != 0) {
+				return false;
+			}
+			uint64_t y = (w & digitLanes) | (0x3030303030303030ull & ~digitLanes);
+			if ((((y & 0xF0F0F0F0F0F0F0F0ull) | (((y + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) != 0x3333333333333333ull)) {
+				return false;
+			}
+			uint64_t v = y - 0x3030303030303030ull;
+			*pairs = v * 10 + (v >> 8);
+			return true;
+		}
+
+		static int Lane(uint64_t v, int lane)
+		{
+			return static_cast<int>((v >> (lane * 8)) & 0xFF);
+		}
+
+		template<typename Char>
+		static Char* PutPair(Char* p, int value)
+		{
+			*p++ = static_cast<Char>(DigitPairs[value * 2]);
+			*p++ = static_cast<Char>(DigitPairs[value * 2 + 1]);
+			return p;
+		}
+
+		static bool ParseNarrow(const char* p, size_t size, ItsTimestamp* out)
+		{
+			if (size < 19) {
+				return false;
+			}
+
+			// "YYYY-MM-", "DDTHH:MM", "HH:MM:SS"
+			uint64_t a, b, c;
+			if (!ItsISO8601::Pairs(p, 0x00FFFF00FFFFFFFFull, 0xFF0000FF00000000ull, 0x2D30302D30303030ull, &a)) {
+				return false;
+			}
+			char t = p[10];
+			if (t != 'T' && t != ' ' && t != 't') {
+				return false;
+			}
+			if (!ItsISO8601::Pairs(p + 8, 0xFFFF00FFFF00FFFFull, 0x0000FF0000000000ull, 0x30303A3030303030ull, &b) ||
+				!ItsISO8601::Pairs(p + 11, 0xFFFF00FFFF00FFFFull, 0x0000FF0000FF0000ull, 0x30303A30303A3030ull, &c)) {
+				return false;
+			}
+
+			int year = ItsISO8601::Lane(a, 0) * 100 + ItsISO8601::Lane(a, 2);
+			int month = ItsISO8601::Lane(a, 5);
+			int day = ItsISO8601::Lane(b, 0);
+			int hour = ItsISO8601::Lane(c, 0);
+			int minute = ItsISO8601::Lane(c, 3);
+			int second = ItsISO8601::Lane(c, 6);
+			if (month < 1 || month > 12 || day < 1 || day > ItsCivil::DaysInMonth(year, month) ||
+				hour > 23 || minute > 59 || second > 60) {
+				return false;
+			}
+
+			size_t i = 19;
+			uint32_t nanosecond = 0;
+			if (i < size && (p[i] == '.' || p[i] == ','))
+			{
+				i++;
+				size_t digits = 0;
+				while (i < size && p[i] >= '0' && p[i] <= '9')
+				{
+					if (digits < 9) {
+						nanosecond = nanosecond * 10 + static_cast<uint32_t>(p[i] - '0');
+					}
+					digits++;
+					i++;
+				}
+				if (digits == 0) {
+					return false;
+				}
+				for (; digits < 9; digits++) {
+					nanosecond *= 10;
+				}
+			}
+
+			bool hasOffset = false;
+			int offset = 0;
+			if (i < size && (p[i] == 'Z' || p[i] == 'z'))
+			{
+				hasOffset = true;
+				i++;
+			}
+			else if (i < size && (p[i] == '+' || p[i] == '-'))
+			{
+				if (size - i < 6 || p[i + 3] != ':') {
+					return false;
+				}
+				int h1 = p[i + 1] - '0', h2 = p[i + 2] - '0', m1 = p[i + 4] - '0', m2 = p[i + 5] - '0';
+				if ((static_cast<unsigned int>(h1) | static_cast<unsigned int>(h2) | static_cast<unsigned int>(m1) | static_cast<unsigned int>(m2)) > 9) {
+					return false;
+				}
+				int oh = h1 * 10 + h2;
+				int om = m1 * 10 + m2;
+				if (oh > 23 || om > 59) {
+					return false;
+				}
+				offset = (oh * 60 + om) * ((p[i] == '-') ? -1 : 1);
+				hasOffset = true;
+				i += 6;
+			}
+			if (i != size) {
+				return false;
+			}
+
+			tm& dt = out->DateTime;
+			dt = tm{ 0 };
+			dt.tm_year = year - 1900;
+			dt.tm_mon = month - 1;
+			dt.tm_mday = day;
+			dt.tm_hour = hour;
+			dt.tm_min = minute;
+			dt.tm_sec = second;
+			dt.tm_yday = ItsCivil::DayOfYear(year, month, day);
+			dt.tm_wday = ItsCivil::WeekdayFromDays(ItsCivil::DaysFromCivil(year, month, day));
+			out->Nanosecond = nanosecond;
+			out->OffsetMinutes = offset;
+			out->HasOffset = hasOffset;
+			return true;
+		}
+	public:
+		inline static constexpr size_t MaxLength = 35;
+
+		//
+		// Text longer than MaxLength is rejected for every character type.
+		//
+		template<typename Char>
+		static bool Parse(const Char* p, size_t size, ItsTimestamp* out)
+		{
+			if (size > MaxLength) {
+				return false;
+			}
+			if constexpr (sizeof(Char) == 1)
+			{
+				return ItsISO8601::ParseNarrow(reinterpret_cast<const char*>(p), size, out);
+			}
+			else
+			{
+				char narrow[MaxLength + 8]{ 0 };
+				for (size_t i = 0; i < size; i++) {
+					narrow[i] = (static_cast<uint32_t>(p[i]) < 0x80) ? static_cast<char>(p[i]) : '\x80';
+				}
+				return ItsISO8601::ParseNarrow(narrow, size, out);
+			}
+		}
+
+		//
+		// Writes up to MaxLength chars. fractionDigits is clamped to 0..9. Returns chars written.
+		//
+		template<typename Char>
+		static size_t Format(const tm& dt, Char* out, uint32_t nanosecond = 0, int fractionDigits = 0, bool withOffset = false, int offsetMinutes = 0)
+		{
+			Char* p = out;
+			int year = dt.tm_year + 1900;
+			if (year < 0 || year > 9999) {
+				year = (year < 0) ? 0 : 9999;
+			}
+			p = ItsISO8601::PutPair(p, year / 100);
+			p = ItsISO8601::PutPair(p, year % 100);
+			*p++ = static_cast<Char>('-');
+			p = ItsISO8601::PutPair(p, (dt.tm_mon + 1) % 100);
+			*p++ = static_cast<Char>('-');
+			p = ItsISO8601::PutPair(p, dt.tm_mday % 100);
+			*p++ = static_cast<Char>('T');
+			p = ItsISO8601::PutPair(p, dt.tm_hour % 100);
+			*p++ = static_cast<Char>(':');
+			p = ItsISO8601::PutPair(p, dt.tm_min % 100);
+			*p++ = static_cast<Char>(':');
+			p = ItsISO8601::PutPair(p, dt.tm_sec % 100);
+
+			if (fractionDigits > 0)
+			{
+				if (fractionDigits > 9) {
+					fractionDigits = 9;
+				}
+				*p++ = static_cast<Char>('.');
+				uint32_t value = nanosecond % 1000000000;
+				for (int k = 9; k > fractionDigits; k--) {
+					value /= 10;
+				}
+				for (int k = fractionDigits - 1; k >= 0; k--) {
+					p[k] = static_cast<Char>('0' + value % 10);
+					value /= 10;
+				}
+				p += fractionDigits;
+			}
+
+			if (withOffset)
+			{
+				if (offsetMinutes == 0) {
+					*p++ = static_cast<Char>('Z');
+				}
+				else {
+					int a = (offsetMinutes < 0) ? -offsetMinutes : offsetMinutes;
+					*p++ = static_cast<Char>((offsetMinutes < 0) ? '-' : '+');
+					p = ItsISO8601::PutPair(p, (a / 60) % 100);
+					*p++ = static_cast<Char>(':');
+					p = ItsISO8601::PutPair(p, a % 60);
+				}
+			}
+
+			return static_cast<size_t>(p - out);
+		}
+
+		//
+		// Parses a whole column. Returns number of rows that failed; their indexes go to failedRows when given.
+		//
+		template<typename StringView>
+		static size_t ParseColumn(std::span<const StringView> texts, std::span<ItsTimestamp> out, vector<size_t>* failedRows = nullptr)
+		{
+			size_t failed = 0;
+			size_t count = (texts.size() < out.size()) ? texts.size() : out.size();
+			for (size_t i = 0; i < count; i++)
+			{
+				if (!ItsISO8601::Parse(texts[i].data(), texts[i].size(), &out[i]))
+				{
+					out[i] = ItsTimestamp{};
+					failed++;
+					if (failedRows != nullptr) {
+						failedRows->push_back(i);
+					}
+				}
+			}
+			return failed;
+		}
+	};
+
+	//
+	// struct: ItsDecimal
+	//
+	// (i): Locale independent, correctly rounded decimal to float/double (Eisel-Lemire).
+	//      Grammar: [+-]digits[.digits][(e|E)[+-]digits], plus inf/infinity/nan. Inputs with more than
+	//      19 significant digits that the fast path cannot settle go to std::from_chars.
+	//
+	struct ItsDecimal
+	{
+	private:
+		template<typename T>
+		struct Format;
+
+		//
+		// 128 bit truncated powers of five, 5^-342 .. 5^308, most significant bit set.
+		//
+		static const uint64_t* PowersOfFive()
+		{
+			static constexpr uint64_t table[651 * 2] = {
+				0xEEF453D6923BD65Aull, 0x113FAA2906A13B3Full,
+				0x9558B4661B6565F8ull, 0x4AC7CA59A424C507ull,
+				0xBAAEE17FA23EBF76ull, 0x5D79BCF00D2DF649ull,
+				0xE95A99DF8ACE6F53ull, 0xF4D82C2C107973DCull,
+				0x91D8A02BB6C10594ull, 0x79071B9B8A4BE869ull,
+				0xB64EC836A47146F9ull, 0x9748E2826CDEE284ull,
+				0xE3E27A444D8D98B7ull, 0xFD1B1B2308169B25ull,
+				0x8E6D8C6AB0787F72ull, 0xFE30F0F5E50E20F7ull,
+				0xB208EF855C969F4Full, 0xBDBD2D335E51A935ull,
+				0xDE8B2B66B3BC4723ull, 0xAD2C788035E61382ull,
+				0x8B16FB203055AC76ull, 0x4C3BCB5021AFCC31ull,
+				0xADDCB9E83C6B1793ull, 0xDF4ABE242A1BBF3Dull,
+				0xD953E8624B85DD78ull, 0xD71D6DAD34A2AF0Dull,
+				0x87D4713D6F33AA6Bull, 0x8672648C40E5AD68ull,
+				0xA9C98D8CCB009506ull, 0x680EFDAF511F18C2ull,
+				0xD43BF0EFFDC0BA48ull, 0x0212BD1B2566DEF2ull,
+				0x84A57695FE98746Dull, 0x014BB630F7604B57ull,
+				0xA5CED43B7E3E9188ull, 0x419EA3BD35385E2Dull,
+				0xCF42894A5DCE35EAull, 0x52064CAC828675B9ull,
+				0x818995CE7AA0E1B2ull, 0x7343EFEBD1940993ull,
+				0xA1EBFB4219491A1Full, 0x1014EBE6C5F90BF8ull,
+				0xCA66FA129F9B60A6ull, 0xD41A26E077774EF6ull,
+				0xFD00B897478238D0ull, 0x8920B098955522B4ull,
+				0x9E20735E8CB16382ull, 0x55B46E5F5D5535B0ull,
+				0xC5A890362FDDBC62ull, 0xEB2189F734AA831Dull,
+				0xF712B443BBD52B7Bull, 0xA5E9EC7501D523E4ull,
+				0x9A6BB0AA55653B2Dull, 0x47B233C92125366Eull,
+				0xC1069CD4EABE89F8ull, 0x999EC0BB696E840Aull,
+				0xF148440A256E2C76ull, 0xC00670EA43CA250Dull,
+				0x96CD2A865764DBCAull, 0x380406926A5E5728ull,
+				0xBC807527ED3E12BCull, 0xC605083704F5ECF2ull,
+				0xEBA09271E88D976Bull, 0xF7864A44C633682Eull,
+				0x93445B8731587EA3ull, 0x7AB3EE6AFBE0211Dull,
+				0xB8157268FDAE9E4Cull, 0x5960EA05BAD82964ull,
+				0xE61ACF033D1A45DFull, 0x6FB92487298E33BDull,
+				0x8FD0C16206306BABull, 0xA5D3B6D479F8E056ull,
+				0xB3C4F1BA87BC8696ull, 0x8F48A4899877186Cull,
+				0xE0B62E2929ABA83Cull, 0x331ACDABFE94DE87ull,
+				0x8C71DCD9BA0B4925ull, 0x9FF0C08B7F1D0B14ull,
+				0xAF8E5410288E1B6Full, 0x07ECF0AE5EE44DD9ull,
+				0xDB71E91432B1A24Aull, 0xC9E82CD9F69D6150ull,
+				0x892731AC9FAF056Eull, 0xBE311C083A225CD2ull,
+				0xAB70FE17C79AC6CAull, 0x6DBD630A48AAF406ull,
+				0xD64D3D9DB981787Dull, 0x092CBBCCDAD5B108ull,
+				0x85F0468293F0EB4Eull, 0x25BBF56008C58EA5ull,
+				0xA76C582338ED2621ull, 0xAF2AF2B80AF6F24Eull,
+				0xD1476E2C07286FAAull, 0x1AF5AF660DB4AEE1ull,
+				0x82CCA4DB847945CAull, 0x50D98D9FC890ED4Dull,
+				0xA37FCE126597973Cull, 0xE50FF107BAB528A0ull,
+				0xCC5FC196FEFD7D0Cull, 0x1E53ED49A96272C8ull,
+				0xFF77B1FCBEBCDC4Full, 0x25E8E89C13BB0F7Aull,
+				0x9FAACF3DF73609B1ull, 0x77B191618C54E9ACull,
+				0xC795830D75038C1Dull, 0xD59DF5B9EF6A2417ull,
+				0xF97AE3D0D2446F25ull, 0x4B0573286B44AD1Dull,
+				0x9BECCE62836AC577ull, 0x4EE367F9430AEC32ull,
+				0xC2E801FB244576D5ull, 0x229C41F793CDA73Full,
+				0xF3A20279ED56D48Aull, 0x6B43527578C1110Full,
+				0x9845418C345644D6ull, 0x830A13896B78AAA9ull,
+				0xBE5691EF416BD60Cull, 0x23CC986BC656D553ull,
+				0xEDEC366B11C6CB8Full, 0x2CBFBE86B7EC8AA8ull,
+				0x94B3A202EB1C3F39ull, 0x7BF7D71432F3D6A9ull,
+				0xB9E08A83A5E34F07ull, 0xDAF5CCD93FB0CC53ull,
+				0xE858AD248F5C22C9ull, 0xD1B3400F8F9CFF68ull,
+				0x91376C36D99995BEull, 0x23100809B9C21FA1ull,
+				0xB58547448FFFFB2Dull, 0xABD40A0C2832A78Aull,
+				0xE2E69915B3FFF9F9ull, 0x16C90C8F323F516Cull,
+				0x8DD01FAD907FFC3Bull, 0xAE3DA7D97F6792E3ull,
+				0xB1442798F49FFB4Aull, 0x99CD11CFDF41779Cull,
+				0xDD95317F31C7FA1Dull, 0x40405643D711D583ull,
+				0x8A7D3EEF7F1CFC52ull, 0x482835EA666B2572ull,
+				0xAD1C8EAB5EE43B66ull, 0xDA3243650005EECFull,
+				0xD863B256369D4A40ull, 0x90BED43E40076A82ull,
+				0x873E4F75E2224E68ull, 0x5A7744A6E804A291ull,
+				0xA90DE3535AAAE202ull, 0x711515D0A205CB36ull,
+				0xD3515C2831559A83ull, 0x0D5A5B44CA873E03ull,
+				0x8412D9991ED58091ull, 0xE858790AFE9486C2ull,
+				0xA5178FFF668AE0B6ull, 0x626E974DBE39A872ull,
+				0xCE5D73FF402D98E3ull, 0xFB0A3D212DC8128Full,
+				0x80FA687F881C7F8Eull, 0x7CE66634BC9D0B99ull,
+				0xA139029F6A239F72ull, 0x1C1FFFC1EBC44E80ull,
+				0xC987434744AC874Eull, 0xA327FFB266B56220ull,
+				0xFBE9141915D7A922ull, 0x4BF1FF9F0062BAA8ull,
+				0x9D71AC8FADA6C9B5ull, 0x6F773FC3603DB4A9ull,
+				0xC4CE17B399107C22ull, 0xCB550FB4384D21D3ull,
+				0xF6019DA07F549B2Bull, 0x7E2A53A146606A48ull,
+				0x99C102844F94E0FBull, 0x2EDA7444CBFC426Dull,
+				0xC0314325637A1939ull, 0xFA911155FEFB5308ull,
+				0xF03D93EEBC589F88ull, 0x793555AB7EBA27CAull,
+				0x96267C7535B763B5ull, 0x4BC1558B2F3458DEull,
+				0xBBB01B9283253CA2ull, 0x9EB1AAEDFB016F16ull,
+				0xEA9C227723EE8BCBull, 0x465E15A979C1CADCull,
+				0x92A1958A7675175Full, 0x0BFACD89EC191EC9ull,
+				0xB749FAED14125D36ull, 0xCEF980EC671F667Bull,
+				0xE51C79A85916F484ull, 0x82B7E12780E7401Aull,
+				0x8F31CC0937AE58D2ull, 0xD1B2ECB8B0908810ull,
+				0xB2FE3F0B8599EF07ull, 0x861FA7E6DCB4AA15ull,
+				0xDFBDCECE67006AC9ull, 0x67A791E093E1D49Aull,
+				0x8BD6A141006042BDull, 0xE0C8BB2C5C6D24E0ull,
+				0xAECC49914078536Dull, 0x58FAE9F773886E18ull,
+				0xDA7F5BF590966848ull, 0xAF39A475506A899Eull,
+				0x888F99797A5E012Dull, 0x6D8406C952429603ull,
+				0xAAB37FD7D8F58178ull, 0xC8E5087BA6D33B83ull,
+				0xD5605FCDCF32E1D6ull, 0xFB1E4A9A90880A64ull,
+				0x855C3BE0A17FCD26ull, 0x5CF2EEA09A55067Full,
+				0xA6B34AD8C9DFC06Full, 0xF42FAA48C0EA481Eull,
+				0xD0601D8EFC57B08Bull, 0xF13B94DAF124DA26ull,
+				0x823C12795DB6CE57ull, 0x76C53D08D6B70858ull,
+				0xA2CB1717B52481EDull, 0x54768C4B0C64CA6Eull,
+				0xCB7DDCDDA26DA268ull, 0xA9942F5DCF7DFD09ull,
+				0xFE5D54150B090B02ull, 0xD3F93B35435D7C4Cull,
+				0x9EFA548D26E5A6E1ull, 0xC47BC5014A1A6DAFull,
+				0xC6B8E9B0709F109Aull, 0x359AB6419CA1091Bull,
+				0xF867241C8CC6D4C0ull, 0xC30163D203C94B62ull,
+				0x9B407691D7FC44F8ull, 0x79E0DE63425DCF1Dull,
+				0xC21094364DFB5636ull, 0x985915FC12F542E4ull,
+				0xF294B943E17A2BC4ull, 0x3E6F5B7B17B2939Dull,
+				0x979CF3CA6CEC5B5Aull, 0xA705992CEECF9C42ull,
+				0xBD8430BD08277231ull, 0x50C6FF782A838353ull,
+				0xECE53CEC4A314EBDull, 0xA4F8BF5635246428ull,
+				0x940F4613AE5ED136ull, 0x871B7795E136BE99ull,
+				0xB913179899F68584ull, 0x28E2557B59846E3Full,
+				0xE757DD7EC07426E5ull, 0x331AEADA2FE589CFull,
+				0x9096EA6F3848984Full, 0x3FF0D2C85DEF7621ull,
+				0xB4BCA50B065ABE63ull, 0x0FED077A756B53A9ull,
+				0xE1EBCE4DC7F16DFBull, 0xD3E8495912C62894ull,
+				0x8D3360F09CF6E4BDull, 0x64712DD7ABBBD95Cull,
+				0xB080392CC4349DECull, 0xBD8D794D96AACFB3ull,
+				0xDCA04777F541C567ull, 0xECF0D7A0FC5583A0ull,
+				0x89E42CAAF9491B60ull, 0xF41686C49DB57244ull,
+				0xAC5D37D5B79B6239ull, 0x311C2875C522CED5ull,
+				0xD77485CB25823AC7ull, 0x7D633293366B828Bull,
+				0x86A8D39EF77164BCull, 0xAE5DFF9C02033197ull,
+				0xA8530886B54DBDEBull, 0xD9F57F830283FDFCull,
+				0xD267CAA862A12D66ull, 0xD072DF63C324FD7Bull,
+				0x8380DEA93DA4BC60ull, 0x4247CB9E59F71E6Dull,
+				0xA46116538D0DEB78ull, 0x52D9BE85F074E608ull,
+				0xCD795BE870516656ull, 0x67902E276C921F8Bull,
+				0x806BD9714632DFF6ull, 0x00BA1CD8A3DB53B6ull,
+				0xA086CFCD97BF97F3ull, 0x80E8A40ECCD228A4ull,
+				0xC8A883C0FDAF7DF0ull, 0x6122CD128006B2CDull,
+				0xFAD2A4B13D1B5D6Cull, 0x796B805720085F81ull,
+				0x9CC3A6EEC6311A63ull, 0xCBE3303674053BB0ull,
+				0xC3F490AA77BD60FCull, 0xBEDBFC4411068A9Cull,
+				0xF4F1B4D515ACB93Bull, 0xEE92FB5515482D44ull,
+				0x991711052D8BF3C5ull, 0x751BDD152D4D1C4Aull,
+				0xBF5CD54678EEF0B6ull, 0xD262D45A78A0635Dull,
+				0xEF340A98172AACE4ull, 0x86FB897116C87C34ull,
+				0x9580869F0E7AAC0Eull, 0xD45D35E6AE3D4DA0ull,
+				0xBAE0A846D2195712ull, 0x8974836059CCA109ull,
+				0xE998D258869FACD7ull, 0x2BD1A438703FC94Bull,
+				0x91FF83775423CC06ull, 0x7B6306A34627DDCFull,
+				0xB67F6455292CBF08ull, 0x1A3BC84C17B1D542ull,
+				0xE41F3D6A7377EECAull, 0x20CABA5F1D9E4A93ull,
+				0x8E938662882AF53Eull, 0x547EB47B7282EE9Cull,
+				0xB23867FB2A35B28Dull, 0xE99E619A4F23AA43ull,
+				0xDEC681F9F4C31F31ull, 0x6405FA00E2EC94D4ull,
+				0x8B3C113C38F9F37Eull, 0xDE83BC408DD3DD04ull,
+				0xAE0B158B4738705Eull, 0x9624AB50B148D445ull,
+				0xD98DDAEE19068C76ull, 0x3BADD624DD9B0957ull,
+				0x87F8A8D4CFA417C9ull, 0xE54CA5D70A80E5D6ull,
+				0xA9F6D30A038D1DBCull, 0x5E9FCF4CCD211F4Cull,
+				0xD47487CC8470652Bull, 0x7647C3200069671Full,
+				0x84C8D4DFD2C63F3Bull, 0x29ECD9F40041E073ull,
+				0xA5FB0A17C777CF09ull, 0xF468107100525890ull,
+				0xCF79CC9DB955C2CCull, 0x7182148D4066EEB4ull,
+				0x81AC1FE293D599BFull, 0xC6F14CD848405530ull,
+				0xA21727DB38CB002Full, 0xB8ADA00E5A506A7Cull,
+				0xCA9CF1D206FDC03Bull, 0xA6D90811F0E4851Cull,
+				0xFD442E4688BD304Aull, 0x908F4A166D1DA663ull,
+				0x9E4A9CEC15763E2Eull, 0x9A598E4E043287FEull,
+				0xC5DD44271AD3CDBAull, 0x40EFF1E1853F29FDull,
+				0xF7549530E188C128ull, 0xD12BEE59E68EF47Cull,
+				0x9A94DD3E8CF578B9ull, 0x82BB74F8301958CEull,
+				0xC13A148E3032D6E7ull, 0xE36A52363C1FAF01ull,
+				0xF18899B1BC3F8CA1ull, 0xDC44E6C3CB279AC1ull,
+				0x96F5600F15A7B7E5ull, 0x29AB103A5EF8C0B9ull,
+				0xBCB2B812DB11A5DEull, 0x7415D448F6B6F0E7ull,
+				0xEBDF661791D60F56ull, 0x111B495B3464AD21ull,
+				0x936B9FCEBB25C995ull, 0xCAB10DD900BEEC34ull,
+				0xB84687C269EF3BFBull, 0x3D5D514F40EEA742ull,
+				0xE65829B3046B0AFAull, 0x0CB4A5A3112A5112ull,
+				0x8FF71A0FE2C2E6DCull, 0x47F0E785EABA72ABull,
+				0xB3F4E093DB73A093ull, 0x59ED216765690F56ull,
+				0xE0F218B8D25088B8ull, 0x306869C13EC3532Cull,
+				0x8C974F7383725573ull, 0x1E414218C73A13FBull,
+				0xAFBD2350644EEACFull, 0xE5D1929EF90898FAull,
+				0xDBAC6C247D62A583ull, 0xDF45F746B74ABF39ull,
+				0x894BC396CE5DA772ull, 0x6B8BBA8C328EB783ull,
+				0xAB9EB47C81F5114Full, 0x066EA92F3F326564ull,
+				0xD686619BA27255A2ull, 0xC80A537B0EFEFEBDull,
+				0x8613FD0145877585ull, 0xBD06742CE95F5F36ull,
+				0xA798FC4196E952E7ull, 0x2C48113823B73704ull,
+				0xD17F3B51FCA3A7A0ull, 0xF75A15862CA504C5ull,
+				0x82EF85133DE648C4ull, 0x9A984D73DBE722FBull,
+				0xA3AB66580D5FDAF5ull, 0xC13E60D0D2E0EBBAull,
+				0xCC963FEE10B7D1B3ull, 0x318DF905079926A8ull,
+				0xFFBBCFE994E5C61Full, 0xFDF17746497F7052ull,
+				0x9FD561F1FD0F9BD3ull, 0xFEB6EA8BEDEFA633ull,
+				0xC7CABA6E7C5382C8ull, 0xFE64A52EE96B8FC0ull,
+				0xF9BD690A1B68637Bull, 0x3DFDCE7AA3C673B0ull,
+				0x9C1661A651213E2Dull, 0x06BEA10CA65C084Eull,
+				0xC31BFA0FE5698DB8ull, 0x486E494FCFF30A62ull,
+				0xF3E2F893DEC3F126ull, 0x5A89DBA3C3EFCCFAull,
+				0x986DDB5C6B3A76B7ull, 0xF89629465A75E01Cull,
+				0xBE89523386091465ull, 0xF6BBB397F1135823ull,
+				0xEE2BA6C0678B597Full, 0x746AA07DED582E2Cull,
+				0x94DB483840B717EFull, 0xA8C2A44EB4571CDCull,
+				0xBA121A4650E4DDEBull, 0x92F34D62616CE413ull,
+				0xE896A0D7E51E1566ull, 0x77B020BAF9C81D17ull,
+				0x915E2486EF32CD60ull, 0x0ACE1474DC1D122Eull,
+				0xB5B5ADA8AAFF80B8ull, 0x0D819992132456BAull,
+				0xE3231912D5BF60E6ull, 0x10E1FFF697ED6C69ull,
+				0x8DF5EFABC5979C8Full, 0xCA8D3FFA1EF463C1ull,
+				0xB1736B96B6FD83B3ull, 0xBD308FF8A6B17CB2ull,
+				0xDDD0467C64BCE4A0ull, 0xAC7CB3F6D05DDBDEull,
+				0x8AA22C0DBEF60EE4ull, 0x6BCDF07A423AA96Bull,
+				0xAD4AB7112EB3929Dull, 0x86C16C98D2C953C6ull,
+				0xD89D64D57A607744ull, 0xE871C7BF077BA8B7ull,
+				0x87625F056C7C4A8Bull, 0x11471CD764AD4972ull,
+				0xA93AF6C6C79B5D2Dull, 0xD598E40D3DD89BCFull,
+				0xD389B47879823479ull, 0x4AFF1D108D4EC2C3ull,
+				0x843610CB4BF160CBull, 0xCEDF722A585139BAull,
+				0xA54394FE1EEDB8FEull, 0xC2974EB4EE658828ull,
+				0xCE947A3DA6A9273Eull, 0x733D226229FEEA32ull,
+				0x811CCC668829B887ull, 0x0806357D5A3F525Full,
+				0xA163FF802A3426A8ull, 0xCA07C2DCB0CF26F7ull,
+				0xC9BCFF6034C13052ull, 0xFC89B393DD02F0B5ull,
+				0xFC2C3F3841F17C67ull, 0xBBAC2078D443ACE2ull,
+				0x9D9BA7832936EDC0ull, 0xD54B944B84AA4C0Dull,
+				0xC5029163F384A931ull, 0x0A9E795E65D4DF11ull,
+				0xF64335BCF065D37Dull, 0x4D4617B5FF4A16D5ull,
+				0x99EA0196163FA42Eull, 0x504BCED1BF8E4E45ull,
+				0xC06481FB9BCF8D39ull, 0xE45EC2862F71E1D6ull,
+				0xF07DA27A82C37088ull, 0x5D767327BB4E5A4Cull,
+				0x964E858C91BA2655ull, 0x3A6A07F8D510F86Full,
+				0xBBE226EFB628AFEAull, 0x890489F70A55368Bull,
+				0xEADAB0ABA3B2DBE5ull, 0x2B45AC74CCEA842Eull,
+				0x92C8AE6B464FC96Full, 0x3B0B8BC90012929Dull,
+				0xB77ADA0617E3BBCBull, 0x09CE6EBB40173744ull,
+				0xE55990879DDCAABDull, 0xCC420A6A101D0515ull,
+				0x8F57FA54C2A9EAB6ull, 0x9FA946824A12232Dull,
+				0xB32DF8E9F3546564ull, 0x47939822DC96ABF9ull,
+				0xDFF9772470297EBDull, 0x59787E2B93BC56F7ull,
+				0x8BFBEA76C619EF36ull, 0x57EB4EDB3C55B65Aull,
+				0xAEFAE51477A06B03ull, 0xEDE622920B6B23F1ull,
+				0xDAB99E59958885C4ull, 0xE95FAB368E45ECEDull,
+				0x88B402F7FD75539Bull, 0x11DBCB0218EBB414ull,
+				0xAAE103B5FCD2A881ull, 0xD652BDC29F26A119ull,
+				0xD59944A37C0752A2ull, 0x4BE76D3346F0495Full,
+				0x857FCAE62D8493A5ull, 0x6F70A4400C562DDBull,
+				0xA6DFBD9FB8E5B88Eull, 0xCB4CCD500F6BB952ull,
+				0xD097AD07A71F26B2ull, 0x7E2000A41346A7A7ull,
+				0x825ECC24C873782Full, 0x8ED400668C0C28C8ull,
+				0xA2F67F2DFA90563Bull, 0x728900802F0F32FAull,
+				0xCBB41EF979346BCAull, 0x4F2B40A03AD2FFB9ull,
+				0xFEA126B7D78186BCull, 0xE2F610C84987BFA8ull,
+				0x9F24B832E6B0F436ull, 0x0DD9CA7D2DF4D7C9ull,
+				0xC6EDE63FA05D3143ull, 0x91503D1C79720DBBull,
+				0xF8A95FCF88747D94ull, 0x75A44C6397CE912Aull,
+				0x9B69DBE1B548CE7Cull, 0xC986AFBE3EE11ABAull,
+				0xC24452DA229B021Bull, 0xFBE85BADCE996168ull,
+				0xF2D56790AB41C2A2ull, 0xFAE27299423FB9C3ull,
+				0x97C560BA6B0919A5ull, 0xDCCD879FC967D41Aull,
+				0xBDB6B8E905CB600Full, 0x5400E987BBC1C920ull,
+				0xED246723473E3813ull, 0x290123E9AAB23B68ull,
+				0x9436C0760C86E30Bull, 0xF9A0B6720AAF6521ull,
+				0xB94470938FA89BCEull, 0xF808E40E8D5B3E69ull,
+				0xE7958CB87392C2C2ull, 0xB60B1D1230B20E04ull,
+				0x90BD77F3483BB9B9ull, 0xB1C6F22B5E6F48C2ull,
+				0xB4ECD5F01A4AA828ull, 0x1E38AEB6360B1AF3ull,
+				0xE2280B6C20DD5232ull, 0x25C6DA63C38DE1B0ull,
+				0x8D590723948A535Full, 0x579C487E5A38AD0Eull,
+				0xB0AF48EC79ACE837ull, 0x2D835A9DF0C6D851ull,
+				0xDCDB1B2798182244ull, 0xF8E431456CF88E65ull,
+				0x8A08F0F8BF0F156Bull, 0x1B8E9ECB641B58FFull,
+				0xAC8B2D36EED2DAC5ull, 0xE272467E3D222F3Full,
+				0xD7ADF884AA879177ull, 0x5B0ED81DCC6ABB0Full,
+				0x86CCBB52EA94BAEAull, 0x98E947129FC2B4E9ull,
+				0xA87FEA27A539E9A5ull, 0x3F2398D747B36224ull,
+				0xD29FE4B18E88640Eull, 0x8EEC7F0D19A03AADull,
+				0x83A3EEEEF9153E89ull, 0x1953CF68300424ACull,
+				0xA48CEAAAB75A8E2Bull, 0x5FA8C3423C052DD7ull,
+				0xCDB02555653131B6ull, 0x3792F412CB06794Dull,
+				0x808E17555F3EBF11ull, 0xE2BBD88BBEE40BD0ull,
+				0xA0B19D2AB70E6ED6ull, 0x5B6ACEAEAE9D0EC4ull,
+				0xC8DE047564D20A8Bull, 0xF245825A5A445275ull,
+				0xFB158592BE068D2Eull, 0xEED6E2F0F0D56712ull,
+				0x9CED737BB6C4183Dull, 0x55464DD69685606Bull,
+				0xC428D05AA4751E4Cull, 0xAA97E14C3C26B886ull,
+				0xF53304714D9265DFull, 0xD53DD99F4B3066A8ull,
+				0x993FE2C6D07B7FABull, 0xE546A8038EFE4029ull,
+				0xBF8FDB78849A5F96ull, 0xDE98520472BDD033ull,
+				0xEF73D256A5C0F77Cull, 0x963E66858F6D4440ull,
+				0x95A8637627989AADull, 0xDDE7001379A44AA8ull,
+				0xBB127C53B17EC159ull, 0x5560C018580D5D52ull,
+				0xE9D71B689DDE71AFull, 0xAAB8F01E6E10B4A6ull,
+				0x9226712162AB070Dull, 0xCAB3961304CA70E8ull,
+				0xB6B00D69BB55C8D1ull, 0x3D607B97C5FD0D22ull,
+				0xE45C10C42A2B3B05ull, 0x8CB89A7DB77C506Aull,
+				0x8EB98A7A9A5B04E3ull, 0x77F3608E92ADB242ull,
+				0xB267ED1940F1C61Cull, 0x55F038B237591ED3ull,
+				0xDF01E85F912E37A3ull, 0x6B6C46DEC52F6688ull,
+				0x8B61313BBABCE2C6ull, 0x2323AC4B3B3DA015ull,
+				0xAE397D8AA96C1B77ull, 0xABEC975E0A0D081Aull,
+				0xD9C7DCED53C72255ull, 0x96E7BD358C904A21ull,
+				0x881CEA14545C7575ull, 0x7E50D64177DA2E54ull,
+				0xAA242499697392D2ull, 0xDDE50BD1D5D0B9E9ull,
+				0xD4AD2DBFC3D07787ull, 0x955E4EC64B44E864ull,
+				0x84EC3C97DA624AB4ull, 0xBD5AF13BEF0B113Eull,
+				0xA6274BBDD0FADD61ull, 0xECB1AD8AEACDD58Eull,
+				0xCFB11EAD453994BAull, 0x67DE18EDA5814AF2ull,
+				0x81CEB32C4B43FCF4ull, 0x80EACF948770CED7ull,
+				0xA2425FF75E14FC31ull, 0xA1258379A94D028Dull,
+				0xCAD2F7F5359A3B3Eull, 0x096EE45813A04330ull,
+				0xFD87B5F28300CA0Dull, 0x8BCA9D6E188853FCull,
+				0x9E74D1B791E07E48ull, 0x775EA264CF55347Eull,
+				0xC612062576589DDAull, 0x95364AFE032A819Eull,
+				0xF79687AED3EEC551ull, 0x3A83DDBD83F52205ull,
+				0x9ABE14CD44753B52ull, 0xC4926A9672793543ull,
+				0xC16D9A0095928A27ull, 0x75B7053C0F178294ull,
+				0xF1C90080BAF72CB1ull, 0x5324C68B12DD6339ull,
+				0x971DA05074DA7BEEull, 0xD3F6FC16EBCA5E04ull,
+				0xBCE5086492111AEAull, 0x88F4BB1CA6BCF585ull,
+				0xEC1E4A7DB69561A5ull, 0x2B31E9E3D06C32E6ull,
+				0x9392EE8E921D5D07ull, 0x3AFF322E62439FD0ull,
+				0xB877AA3236A4B449ull, 0x09BEFEB9FAD487C3ull,
+				0xE69594BEC44DE15Bull, 0x4C2EBE687989A9B4ull,
+				0x901D7CF73AB0ACD9ull, 0x0F9D37014BF60A11ull,
+				0xB424DC35095CD80Full, 0x538484C19EF38C95ull,
+				0xE12E13424BB40E13ull, 0x2865A5F206B06FBAull,
+				0x8CBCCC096F5088CBull, 0xF93F87B7442E45D4ull,
+				0xAFEBFF0BCB24AAFEull, 0xF78F69A51539D749ull,
+				0xDBE6FECEBDEDD5BEull, 0xB573440E5A884D1Cull,
+				0x89705F4136B4A597ull, 0x31680A88F8953031ull,
+				0xABCC77118461CEFCull, 0xFDC20D2B36BA7C3Eull,
+				0xD6BF94D5E57A42BCull, 0x3D32907604691B4Dull,
+				0x8637BD05AF6C69B5ull, 0xA63F9A49C2C1B110ull,
+				0xA7C5AC471B478423ull, 0x0FCF80DC33721D54ull,
+				0xD1B71758E219652Bull, 0xD3C36113404EA4A9ull,
+				0x83126E978D4FDF3Bull, 0x645A1CAC083126EAull,
+				0xA3D70A3D70A3D70Aull, 0x3D70A3D70A3D70A4ull,
+				0xCCCCCCCCCCCCCCCCull, 0xCCCCCCCCCCCCCCCDull,
+				0x8000000000000000ull, 0x0000000000000000ull,
+				0xA000000000000000ull, 0x0000000000000000ull,
+				0xC800000000000000ull, 0x0000000000000000ull,
+				0xFA00000000000000ull, 0x0000000000000000ull,
+				0x9C40000000000000ull, 0x0000000000000000ull,
+				0xC350000000000000ull, 0x0000000000000000ull,
+				0xF424000000000000ull, 0x0000000000000000ull,
+				0x9896800000000000ull, 0x0000000000000000ull,
+				0xBEBC200000000000ull, 0x0000000000000000ull,
+				0xEE6B280000000000ull, 0x0000000000000000ull,
+				0x9502F90000000000ull, 0x0000000000000000ull,
+				0xBA43B74000000000ull, 0x0000000000000000ull,
+				0xE8D4A51000000000ull, 0x0000000000000000ull,
+				0x9184E72A00000000ull, 0x0000000000000000ull,
+				0xB5E620F480000000ull, 0x0000000000000000ull,
+				0xE35FA931A0000000ull, 0x0000000000000000ull,
+				0x8E1BC9BF04000000ull, 0x0000000000000000ull,
+				0xB1A2BC2EC5000000ull, 0x0000000000000000ull,
+				0xDE0B6B3A76400000ull, 0x0000000000000000ull,
+				0x8AC7230489E80000ull, 0x0000000000000000ull,
+				0xAD78EBC5AC620000ull, 0x0000000000000000ull,
+				0xD8D726B7177A8000ull, 0x0000000000000000ull,
+				0x878678326EAC9000ull, 0x0000000000000000ull,
+				0xA968163F0A57B400ull, 0x0000000000000000ull,
+				0xD3C21BCECCEDA100ull, 0x0000000000000000ull,
+				0x84595161401484A0ull, 0x0000000000000000ull,
+				0xA56FA5B99019A5C8ull, 0x0000000000000000ull,
+				0xCECB8F27F4200F3Aull, 0x0000000000000000ull,
+				0x813F3978F8940984ull, 0x4000000000000000ull,
+				0xA18F07D736B90BE5ull, 0x5000000000000000ull,
+				0xC9F2C9CD04674EDEull, 0xA400000000000000ull,
+				0xFC6F7C4045812296ull, 0x4D00000000000000ull,
+				0x9DC5ADA82B70B59Dull, 0xF020000000000000ull,
+				0xC5371912364CE305ull, 0x6C28000000000000ull,
+				0xF684DF56C3E01BC6ull, 0xC732000000000000ull,
+				0x9A130B963A6C115Cull, 0x3C7F400000000000ull,
+				0xC097CE7BC90715B3ull, 0x4B9F100000000000ull,
+				0xF0BDC21ABB48DB20ull, 0x1E86D40000000000ull,
+				0x96769950B50D88F4ull, 0x1314448000000000ull,
+				0xBC143FA4E250EB31ull, 0x17D955A000000000ull,
+				0xEB194F8E1AE525FDull, 0x5DCFAB0800000000ull,
+				0x92EFD1B8D0CF37BEull, 0x5AA1CAE500000000ull,
+				0xB7ABC627050305ADull, 0xF14A3D9E40000000ull,
+				0xE596B7B0C643C719ull, 0x6D9CCD05D0000000ull,
+				0x8F7E32CE7BEA5C6Full, 0xE4820023A2000000ull,
+				0xB35DBF821AE4F38Bull, 0xDDA2802C8A800000ull,
+				0xE0352F62A19E306Eull, 0xD50B2037AD200000ull,
+				0x8C213D9DA502DE45ull, 0x4526F422CC340000ull,
+				0xAF298D050E4395D6ull, 0x9670B12B7F410000ull,
+				0xDAF3F04651D47B4Cull, 0x3C0CDD765F114000ull,
+				0x88D8762BF324CD0Full, 0xA5880A69FB6AC800ull,
+				0xAB0E93B6EFEE0053ull, 0x8EEA0D047A457A00ull,
+				0xD5D238A4ABE98068ull, 0x72A4904598D6D880ull,
+				0x85A36366EB71F041ull, 0x47A6DA2B7F864750ull,
+				0xA70C3C40A64E6C51ull, 0x999090B65F67D924ull,
+				0xD0CF4B50CFE20765ull, 0xFFF4B4E3F741CF6Dull,
+				0x82818F1281ED449Full, 0xBFF8F10E7A8921A4ull,
+				0xA321F2D7226895C7ull, 0xAFF72D52192B6A0Dull,
+				0xCBEA6F8CEB02BB39ull, 0x9BF4F8A69F764490ull,
+				0xFEE50B7025C36A08ull, 0x02F236D04753D5B4ull,
+				0x9F4F2726179A2245ull, 0x01D762422C946590ull,
+				0xC722F0EF9D80AAD6ull, 0x424D3AD2B7B97EF5ull,
+				0xF8EBAD2B84E0D58Bull, 0xD2E0898765A7DEB2ull,
+				0x9B934C3B330C8577ull, 0x63CC55F49F88EB2Full,
+				0xC2781F49FFCFA6D5ull, 0x3CBF6B71C76B25FBull,
+				0xF316271C7FC3908Aull, 0x8BEF464E3945EF7Aull,
+				0x97EDD871CFDA3A56ull, 0x97758BF0E3CBB5ACull,
+				0xBDE94E8E43D0C8ECull, 0x3D52EEED1CBEA317ull,
+				0xED63A231D4C4FB27ull, 0x4CA7AAA863EE4BDDull,
+				0x945E455F24FB1CF8ull, 0x8FE8CAA93E74EF6Aull,
+				0xB975D6B6EE39E436ull, 0xB3E2FD538E122B44ull,
+				0xE7D34C64A9C85D44ull, 0x60DBBCA87196B616ull,
+				0x90E40FBEEA1D3A4Aull, 0xBC8955E946FE31CDull,
+				0xB51D13AEA4A488DDull, 0x6BABAB6398BDBE41ull,
+				0xE264589A4DCDAB14ull, 0xC696963C7EED2DD1ull,
+				0x8D7EB76070A08AECull, 0xFC1E1DE5CF543CA2ull,
+				0xB0DE65388CC8ADA8ull, 0x3B25A55F43294BCBull,
+				0xDD15FE86AFFAD912ull, 0x49EF0EB713F39EBEull,
+				0x8A2DBF142DFCC7ABull, 0x6E3569326C784337ull,
+				0xACB92ED9397BF996ull, 0x49C2C37F07965404ull,
+				0xD7E77A8F87DAF7FBull, 0xDC33745EC97BE906ull,
+				0x86F0AC99B4E8DAFDull, 0x69A028BB3DED71A3ull,
+				0xA8ACD7C0222311BCull, 0xC40832EA0D68CE0Cull,
+				0xD2D80DB02AABD62Bull, 0xF50A3FA490C30190ull,
+				0x83C7088E1AAB65DBull, 0x792667C6DA79E0FAull,
+				0xA4B8CAB1A1563F52ull, 0x577001B891185938ull,
+				0xCDE6FD5E09ABCF26ull, 0xED4C0226B55E6F86ull,
+				0x80B05E5AC60B6178ull, 0x544F8158315B05B4ull,
+				0xA0DC75F1778E39D6ull, 0x696361AE3DB1C721ull,
+				0xC913936DD571C84Cull, 0x03BC3A19CD1E38E9ull,
+				0xFB5878494ACE3A5Full, 0x04AB48A04065C723ull,
+				0x9D174B2DCEC0E47Bull, 0x62EB0D64283F9C76ull,
+				0xC45D1DF942711D9Aull, 0x3BA5D0BD324F8394ull,
+				0xF5746577930D6500ull, 0xCA8F44EC7EE36479ull,
+				0x9968BF6ABBE85F20ull, 0x7E998B13CF4E1ECBull,
+				0xBFC2EF456AE276E8ull, 0x9E3FEDD8C321A67Eull,
+				0xEFB3AB16C59B14A2ull, 0xC5CFE94EF3EA101Eull,
+				0x95D04AEE3B80ECE5ull, 0xBBA1F1D158724A12ull,
+				0xBB445DA9CA61281Full, 0x2A8A6E45AE8EDC97ull,
+				0xEA1575143CF97226ull, 0xF52D09D71A3293BDull,
+				0x924D692CA61BE758ull, 0x593C2626705F9C56ull,
+				0xB6E0C377CFA2E12Eull, 0x6F8B2FB00C77836Cull,
+				0xE498F455C38B997Aull, 0x0B6DFB9C0F956447ull,
+				0x8EDF98B59A373FECull, 0x4724BD4189BD5EACull,
+				0xB2977EE300C50FE7ull, 0x58EDEC91EC2CB657ull,
+				0xDF3D5E9BC0F653E1ull, 0x2F2967B66737E3EDull,
+				0x8B865B215899F46Cull, 0xBD79E0D20082EE74ull,
+				0xAE67F1E9AEC07187ull, 0xECD8590680A3AA11ull,
+				0xDA01EE641A708DE9ull, 0xE80E6F4820CC9495ull,
+				0x884134FE908658B2ull, 0x3109058D147FDCDDull,
+				0xAA51823E34A7EEDEull, 0xBD4B46F0599FD415ull,
+				0xD4E5E2CDC1D1EA96ull, 0x6C9E18AC7007C91Aull,
+				0x850FADC09923329Eull, 0x03E2CF6BC604DDB0ull,
+				0xA6539930BF6BFF45ull, 0x84DB8346B786151Cull,
+				0xCFE87F7CEF46FF16ull, 0xE612641865679A63ull,
+				0x81F14FAE158C5F6Eull, 0x4FCB7E8F3F60C07Eull,
+				0xA26DA3999AEF7749ull, 0xE3BE5E330F38F09Dull,
+				0xCB090C8001AB551Cull, 0x5CADF5BFD3072CC5ull,
+				0xFDCB4FA002162A63ull, 0x73D9732FC7C8F7F6ull,
+				0x9E9F11C4014DDA7Eull, 0x2867E7FDDCDD9AFAull,
+				0xC646D63501A1511Dull, 0xB281E1FD541501B8ull,
+				0xF7D88BC24209A565ull, 0x1F225A7CA91A4226ull,
+				0x9AE757596946075Full, 0x3375788DE9B06958ull,
+				0xC1A12D2FC3978937ull, 0x0052D6B1641C83AEull,
+				0xF209787BB47D6B84ull, 0xC0678C5DBD23A49Aull,
+				0x9745EB4D50CE6332ull, 0xF840B7BA963646E0ull,
+				0xBD176620A501FBFFull, 0xB650E5A93BC3D898ull,
+				0xEC5D3FA8CE427AFFull, 0xA3E51F138AB4CEBEull,
+				0x93BA47C980E98CDFull, 0xC66F336C36B10137ull,
+				0xB8A8D9BBE123F017ull, 0xB80B0047445D4184ull,
+				0xE6D3102AD96CEC1Dull, 0xA60DC059157491E5ull,
+				0x9043EA1AC7E41392ull, 0x87C89837AD68DB2Full,
+				0xB454E4A179DD1877ull, 0x29BABE4598C311FBull,
+				0xE16A1DC9D8545E94ull, 0xF4296DD6FEF3D67Aull,
+				0x8CE2529E2734BB1Dull, 0x1899E4A65F58660Cull,
+				0xB01AE745B101E9E4ull, 0x5EC05DCFF72E7F8Full,
+				0xDC21A1171D42645Dull, 0x76707543F4FA1F73ull,
+				0x899504AE72497EBAull, 0x6A06494A791C53A8ull,
+				0xABFA45DA0EDBDE69ull, 0x0487DB9D17636892ull,
+				0xD6F8D7509292D603ull, 0x45A9D2845D3C42B6ull,
+				0x865B86925B9BC5C2ull, 0x0B8A2392BA45A9B2ull,
+				0xA7F26836F282B732ull, 0x8E6CAC7768D7141Eull,
+				0xD1EF0244AF2364FFull, 0x3207D795430CD926ull,
+				0x8335616AED761F1Full, 0x7F44E6BD49E807B8ull,
+				0xA402B9C5A8D3A6E7ull, 0x5F16206C9C6209A6ull,
+				0xCD036837130890A1ull, 0x36DBA887C37A8C0Full,
+				0x802221226BE55A64ull, 0xC2494954DA2C9789ull,
+				0xA02AA96B06DEB0FDull, 0xF2DB9BAA10B7BD6Cull,
+				0xC83553C5C8965D3Dull, 0x6F92829494E5ACC7ull,
+				0xFA42A8B73ABBF48Cull, 0xCB772339BA1F17F9ull,
+				0x9C69A97284B578D7ull, 0xFF2A760414536EFBull,
+				0xC38413CF25E2D70Dull, 0xFEF5138519684ABAull,
+				0xF46518C2EF5B8CD1ull, 0x7EB258665FC25D69ull,
+				0x98BF2F79D5993802ull, 0xEF2F773FFBD97A61ull,
+				0xBEEEFB584AFF8603ull, 0xAAFB550FFACFD8FAull,
+				0xEEAABA2E5DBF6784ull, 0x95BA2A53F983CF38ull,
+				0x952AB45CFA97A0B2ull, 0xDD945A747BF26183ull,
+				0xBA756174393D88DFull, 0x94F971119AEEF9E4ull,
+				0xE912B9D1478CEB17ull, 0x7A37CD5601AAB85Dull,
+				0x91ABB422CCB812EEull, 0xAC62E055C10AB33Aull,
+				0xB616A12B7FE617AAull, 0x577B986B314D6009ull,
+				0xE39C49765FDF9D94ull, 0xED5A7E85FDA0B80Bull,
+				0x8E41ADE9FBEBC27Dull, 0x14588F13BE847307ull,
+				0xB1D219647AE6B31Cull, 0x596EB2D8AE258FC8ull,
+				0xDE469FBD99A05FE3ull, 0x6FCA5F8ED9AEF3BBull,
+				0x8AEC23D680043BEEull, 0x25DE7BB9480D5854ull,
+				0xADA72CCC20054AE9ull, 0xAF561AA79A10AE6Aull,
+				0xD910F7FF28069DA4ull, 0x1B2BA1518094DA04ull,
+				0x87AA9AFF79042286ull, 0x90FB44D2F05D0842ull,
+				0xA99541BF57452B28ull, 0x353A1607AC744A53ull,
+				0xD3FA922F2D1675F2ull, 0x42889B8997915CE8ull,
+				0x847C9B5D7C2E09B7ull, 0x69956135FEBADA11ull,
+				0xA59BC234DB398C25ull, 0x43FAB9837E699095ull,
+				0xCF02B2C21207EF2Eull, 0x94F967E45E03F4BBull,
+				0x8161AFB94B44F57Dull, 0x1D1BE0EEBAC278F5ull,
+				0xA1BA1BA79E1632DCull, 0x6462D92A69731732ull,
+				0xCA28A291859BBF93ull, 0x7D7B8F7503CFDCFEull,
+				0xFCB2CB35E702AF78ull, 0x5CDA735244C3D43Eull,
+				0x9DEFBF01B061ADABull, 0x3A0888136AFA64A7ull,
+				0xC56BAEC21C7A1916ull, 0x088AAA1845B8FDD0ull,
+				0xF6C69A72A3989F5Bull, 0x8AAD549E57273D45ull,
+				0x9A3C2087A63F6399ull, 0x36AC54E2F678864Bull,
+				0xC0CB28A98FCF3C7Full, 0x84576A1BB416A7DDull,
+				0xF0FDF2D3F3C30B9Full, 0x656D44A2A11C51D5ull,
+				0x969EB7C47859E743ull, 0x9F644AE5A4B1B325ull,
+				0xBC4665B596706114ull, 0x873D5D9F0DDE1FEEull,
+				0xEB57FF22FC0C7959ull, 0xA90CB506D155A7EAull,
+				0x9316FF75DD87CBD8ull, 0x09A7F12442D588F2ull,
+				0xB7DCBF5354E9BECEull, 0x0C11ED6D538AEB2Full,
+				0xE5D3EF282A242E81ull, 0x8F1668C8A86DA5FAull,
+				0x8FA475791A569D10ull, 0xF96E017D694487BCull,
+				0xB38D92D760EC4455ull, 0x37C981DCC395A9ACull,
+				0xE070F78D3927556Aull, 0x85BBE253F47B1417ull,
+				0x8C469AB843B89562ull, 0x93956D7478CCEC8Eull,
+				0xAF58416654A6BABBull, 0x387AC8D1970027B2ull,
+				0xDB2E51BFE9D0696Aull, 0x06997B05FCC0319Eull,
+				0x88FCF317F22241E2ull, 0x441FECE3BDF81F03ull,
+				0xAB3C2FDDEEAAD25Aull, 0xD527E81CAD7626C3ull,
+				0xD60B3BD56A5586F1ull, 0x8A71E223D8D3B074ull,
+				0x85C7056562757456ull, 0xF6872D5667844E49ull,
+				0xA738C6BEBB12D16Cull, 0xB428F8AC016561DBull,
+				0xD106F86E69D785C7ull, 0xE13336D701BEBA52ull,
+				0x82A45B450226B39Cull, 0xECC0024661173473ull,
+				0xA34D721642B06084ull, 0x27F002D7F95D0190ull,
+				0xCC20CE9BD35C78A5ull, 0x31EC038DF7B441F4ull,
+				0xFF290242C83396CEull, 0x7E67047175A15271ull,
+				0x9F79A169BD203E41ull, 0x0F0062C6E984D386ull,
+				0xC75809C42C684DD1ull, 0x52C07B78A3E60868ull,
+				0xF92E0C3537826145ull, 0xA7709A56CCDF8A82ull,
+				0x9BBCC7A142B17CCBull, 0x88A66076400BB691ull,
+				0xC2ABF989935DDBFEull, 0x6ACFF893D00EA435ull,
+				0xF356F7EBF83552FEull, 0x0583F6B8C4124D43ull,
+				0x98165AF37B2153DEull, 0xC3727A337A8B704Aull,
+				0xBE1BF1B059E9A8D6ull, 0x744F18C0592E4C5Cull,
+				0xEDA2EE1C7064130Cull, 0x1162DEF06F79DF73ull,
+				0x9485D4D1C63E8BE7ull, 0x8ADDCB5645AC2BA8ull,
+				0xB9A74A0637CE2EE1ull, 0x6D953E2BD7173692ull,
+				0xE8111C87C5C1BA99ull, 0xC8FA8DB6CCDD0437ull,
+				0x910AB1D4DB9914A0ull, 0x1D9C9892400A22A2ull,
+				0xB54D5E4A127F59C8ull, 0x2503BEB6D00CAB4Bull,
+				0xE2A0B5DC971F303Aull, 0x2E44AE64840FD61Dull,
+				0x8DA471A9DE737E24ull, 0x5CEAECFED289E5D2ull,
+				0xB10D8E1456105DADull, 0x7425A83E872C5F47ull,
+				0xDD50F1996B947518ull, 0xD12F124E28F77719ull,
+				0x8A5296FFE33CC92Full, 0x82BD6B70D99AAA6Full,
+				0xACE73CBFDC0BFB7Bull, 0x636CC64D1001550Bull,
+				0xD8210BEFD30EFA5Aull, 0x3C47F7E05401AA4Eull,
+				0x8714A775E3E95C78ull, 0x65ACFAEC34810A71ull,
+				0xA8D9D1535CE3B396ull, 0x7F1839A741A14D0Dull,
+				0xD31045A8341CA07Cull, 0x1EDE48111209A050ull,
+				0x83EA2B892091E44Dull, 0x934AED0AAB460432ull,
+				0xA4E4B66B68B65D60ull, 0xF81DA84D5617853Full,
+				0xCE1DE40642E3F4B9ull, 0x36251260AB9D668Eull,
+				0x80D2AE83E9CE78F3ull, 0xC1D72B7C6B426019ull,
+				0xA1075A24E4421730ull, 0xB24CF65B8612F81Full,
+				0xC94930AE1D529CFCull, 0xDEE033F26797B627ull,
+				0xFB9B7CD9A4A7443Cull, 0x169840EF017DA3B1ull,
+				0x9D412E0806E88AA5ull, 0x8E1F289560EE864Eull,
+				0xC491798A08A2AD4Eull, 0xF1A6F2BAB92A27E2ull,
+				0xF5B5D7EC8ACB58A2ull, 0xAE10AF696774B1DBull,
+				0x9991A6F3D6BF1765ull, 0xACCA6DA1E0A8EF29ull,
+				0xBFF610B0CC6EDD3Full, 0x17FD090A58D32AF3ull,
+				0xEFF394DCFF8A948Eull, 0xDDFC4B4CEF07F5B0ull,
+				0x95F83D0A1FB69CD9ull, 0x4ABDAF101564F98Eull,
+				0xBB764C4CA7A4440Full, 0x9D6D1AD41ABE37F1ull,
+				0xEA53DF5FD18D5513ull, 0x84C86189216DC5EDull,
+				0x92746B9BE2F8552Cull, 0x32FD3CF5B4E49BB4ull,
+				0xB7118682DBB66A77ull, 0x3FBC8C33221DC2A1ull,
+				0xE4D5E82392A40515ull, 0x0FABAF3FEAA5334Aull,
+				0x8F05B1163BA6832Dull, 0x29CB4D87F2A7400Eull,
+				0xB2C71D5BCA9023F8ull, 0x743E20E9EF511012ull,
+				0xDF78E4B2BD342CF6ull, 0x914DA9246B255416ull,
+				0x8BAB8EEFB6409C1Aull, 0x1AD089B6C2F7548Eull,
+				0xAE9672ABA3D0C320ull, 0xA184AC2473B529B1ull,
+				0xDA3C0F568CC4F3E8ull, 0xC9E5D72D90A2741Eull,
+				0x8865899617FB1871ull, 0x7E2FA67C7A658892ull,
+				0xAA7EEBFB9DF9DE8Dull, 0xDDBB901B98FEEAB7ull,
+				0xD51EA6FA85785631ull, 0x552A74227F3EA565ull,
+				0x8533285C936B35DEull, 0xD53A88958F87275Full,
+				0xA67FF273B8460356ull, 0x8A892ABAF368F137ull,
+				0xD01FEF10A657842Cull, 0x2D2B7569B0432D85ull,
+				0x8213F56A67F6B29Bull, 0x9C3B29620E29FC73ull,
+				0xA298F2C501F45F42ull, 0x8349F3BA91B47B8Full,
+				0xCB3F2F7642717713ull, 0x241C70A936219A73ull,
+				0xFE0EFB53D30DD4D7ull, 0xED238CD383AA0110ull,
+				0x9EC95D1463E8A506ull, 0xF4363804324A40AAull,
+				0xC67BB4597CE2CE48ull, 0xB143C6053EDCD0D5ull,
+				0xF81AA16FDC1B81DAull, 0xDD94B7868E94050Aull,
+				0x9B10A4E5E9913128ull, 0xCA7CF2B4191C8326ull,
+				0xC1D4CE1F63F57D72ull, 0xFD1C2F611F63A3F0ull,
+				0xF24A01A73CF2DCCFull, 0xBC633B39673C8CECull,
+				0x976E41088617CA01ull, 0xD5BE0503E085D813ull,
+				0xBD49D14AA79DBC82ull, 0x4B2D8644D8A74E18ull,
+				0xEC9C459D51852BA2ull, 0xDDF8E7D60ED1219Eull,
+				0x93E1AB8252F33B45ull, 0xCABB90E5C942B503ull,
+				0xB8DA1662E7B00A17ull, 0x3D6A751F3B936243ull,
+				0xE7109BFBA19C0C9Dull, 0x0CC512670A783AD4ull,
+				0x906A617D450187E2ull, 0x27FB2B80668B24C5ull,
+				0xB484F9DC9641E9DAull, 0xB1F9F660802DEDF6ull,
+				0xE1A63853BBD26451ull, 0x5E7873F8A0396973ull,
+				0x8D07E33455637EB2ull, 0xDB0B487B6423E1E8ull,
+				0xB049DC016ABC5E5Full, 0x91CE1A9A3D2CDA62ull,
+				0xDC5C5301C56B75F7ull, 0x7641A140CC7810FBull,
+				0x89B9B3E11B6329BAull, 0xA9E904C87FCB0A9Dull,
+				0xAC2820D9623BF429ull, 0x546345FA9FBDCD44ull,
+				0xD732290FBACAF133ull, 0xA97C177947AD4095ull,
+				0x867F59A9D4BED6C0ull, 0x49ED8EABCCCC485Dull,
+				0xA81F301449EE8C70ull, 0x5C68F256BFFF5A74ull,
+				0xD226FC195C6A2F8Cull, 0x73832EEC6FFF3111ull,
+				0x83585D8FD9C25DB7ull, 0xC831FD53C5FF7EABull,
+				0xA42E74F3D032F525ull, 0xBA3E7CA8B77F5E55ull,
+				0xCD3A1230C43FB26Full, 0x28CE1BD2E55F35EBull,
+				0x80444B5E7AA7CF85ull, 0x7980D163CF5B81B3ull,
+				0xA0555E361951C366ull, 0xD7E105BCC332621Full,
+				0xC86AB5C39FA63440ull, 0x8DD9472BF3FEFAA7ull,
+				0xFA856334878FC150ull, 0xB14F98F6F0FEB951ull,
+				0x9C935E00D4B9D8D2ull, 0x6ED1BF9A569F33D3ull,
+				0xC3B8358109E84F07ull, 0x0A862F80EC4700C8ull,
+				0xF4A642E14C6262C8ull, 0xCD27BB612758C0FAull,
+				0x98E7E9CCCFBD7DBDull, 0x8038D51CB897789Cull,
+				0xBF21E44003ACDD2Cull, 0xE0470A63E6BD56C3ull,
+				0xEEEA5D5004981478ull, 0x1858CCFCE06CAC74ull,
+				0x95527A5202DF0CCBull, 0x0F37801E0C43EBC8ull,
+				0xBAA718E68396CFFDull, 0xD30560258F54E6BAull,
+				0xE950DF20247C83FDull, 0x47C6B82EF32A2069ull,
+				0x91D28B7416CDD27Eull, 0x4CDC331D57FA5441ull,
+				0xB6472E511C81471Dull, 0xE0133FE4ADF8E952ull,
+				0xE3D8F9E563A198E5ull, 0x58180FDDD97723A6ull,
+				0x8E679C2F5E44FF8Full, 0x570F09EAA7EA7648ull
+			};
+			return table;
+		}
+
+		struct Decimal
+		{
+			uint64_t Mantissa{ 0 };
+			int64_t Exponent{ 0 };
+			bool Negative{ false };
+			bool Truncated{ false };
+		};
+
+		static bool IsDigit(char c)
+		{
+			return static_cast<unsigned char>(c - '0') <= 9;
+		}
+
+		//
+		// Splits the text into up to 19 significant digits and a power of ten.
+		//
+		static bool Scan(const char* p, const char* end, Decimal* d)
+		{
+			if (p < end && (*p == '-' || *p == '+')) {
+				d->Negative = (*p == '-');
+				p++;
+			}
+
+			const char* start = p;
+			uint64_t mantissa = 0;
+			int digits = 0;
+			int64_t exponent = 0;
+			size_t seen = 0;
+
+			while (p < end && *p == '0') {
+				p++;
+				seen++;
+			}
+			while (p < end && ItsDecimal::IsDigit(*p))
+			{
+				if (digits < 19) {
+					mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+					digits++;
+				}
+				else {
+					exponent++;
+					if (*p != '0') {
+						d->Truncated = true;
+					}
+				}
+				p++;
+				seen++;
+			}
+
+			if (p < end && *p == '.')
+			{
+				p++;
+				if (digits == 0)
+				{
+					while (p < end && *p == '0') {
+						p++;
+						seen++;
+						exponent--;
+					}
+				}
+				while (p < end && ItsDecimal::IsDigit(*p))
+				{
+					if (digits < 19) {
+						mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+						digits++;
+						exponent--;
+					}
+					else if (*p != '0') {
+						d->Truncated = true;
+					}
+					p++;
+					seen++;
+				}
+			}
+			if (seen == 0 || p == start) {
+				return false;
+			}
+
+			if (p < end && (*p == 'e' || *p == 'E'))
+			{
+				p++;
+				bool negative = false;
+				if (p < end && (*p == '-' || *p == '+')) {
+					negative = (*p == '-');
+					p++;
+				}
+				if (p == end || !ItsDecimal::IsDigit(*p)) {
+					return false;
+				}
+				int64_t e = 0;
+				while (p < end && ItsDecimal::IsDigit(*p))
+				{
+					if (e < 100000) {
+						e = e * 10 + (*p - '0');
+					}
+					p++;
+				}
+				exponent += negative ? -e : e;
+			}
+
+			d->Mantissa = mantissa;
+			d->Exponent = exponent;
+			return p == end;
+		}
+
+		//
+		// Eisel-Lemire. Returns the IEEE bits without sign.
+		//
+		template<typename T>
+		static uint64_t Compute(int64_t q, uint64_t w)
+		{
+			using F = Format<T>;
+			if (w == 0 || q < F::SmallestPowerOfTen) {
+				return 0;
+			}
+			if (q > F::LargestPowerOfTen) {
+				return static_cast<uint64_t>(F::InfinitePower) << F::MantissaBits;
+			}
+
+			int lz = std::countl_zero(w);
+			w <<= lz;
+
+			const uint64_t* pow5 = ItsDecimal::PowersOfFive() + 2 * (q + 342);
+			ItsUInt128 product = ItsUInt128::Multiply(w, pow5[0]);
+			uint64_t high = product.High;
+			uint64_t low = product.Low;
+			const uint64_t precisionMask = 0xFFFFFFFFFFFFFFFFull >> (F::MantissaBits + 3);
+			if ((high & precisionMask) == precisionMask)
+			{
+				uint64_t secondHigh = ItsUInt128::Multiply(w, pow5[1]).High;
+				low += secondHigh;
+				if (secondHigh > low) {
+					high++;
+				}
+			}
+
+			int upperbit = static_cast<int>(high >> 63);
+			int shift = upperbit + 64 - F::MantissaBits - 3;
+			uint64_t mantissa = high >> shift;
+			int64_t power2 = (((152170 + 65536) * q) >> 16) + 63 + upperbit - lz - F::MinimumExponent;
+
+			if (power2 <= 0)
+			{
+				if (-power2 + 1 >= 64) {
+					return 0;
+				}
+				mantissa >>= -power2 + 1;
+				mantissa += (mantissa & 1);
+				mantissa >>= 1;
+				power2 = (mantissa < (uint64_t(1) << F::MantissaBits)) ? 0 : 1;
+				return (static_cast<uint64_t>(power2) << F::MantissaBits) | (mantissa & ((uint64_t(1) << F::MantissaBits) - 1));
+			}
+
+			if (low <= 1 && q >= F::MinRoundToEven && q <= F::MaxRoundToEven && (mantissa & 3) == 1)
+			{
+				if ((mantissa << shift) == high) {
+					mantissa &= ~uint64_t(1);
+				}
+			}
+
+			mantissa += (mantissa & 1);
+			mantissa >>= 1;
+			if (mantissa >= (uint64_t(2) << F::MantissaBits)) {
+				mantissa = uint64_t(1) << F::MantissaBits;
+				power2++;
+			}
+			mantissa &= ~(uint64_t(1) << F::MantissaBits);
+			if (power2 >= F::InfinitePower) {
+				return static_cast<uint64_t>(F::InfinitePower) << F::MantissaBits;
+			}
+			return (static_cast<uint64_t>(power2) << F::MantissaBits) | mantissa;
+		}
+
+		template<typename T>
+		static T FromBits(uint64_t bits, bool negative)
+		{
+			using F = Format<T>;
+			using U = typename F::Bits;
+			U u = static_cast<U>(bits) | (negative ? (U(1) << (sizeof(U) * 8 - 1)) : U(0));
+			return std::bit_cast<T>(u);
+		}
+
+		template<typename T>
+		static bool Fallback(const char* p, const char* end, T* value)
+		{
+			bool negative = false;
+			if (p < end && (*p == '-' || *p == '+')) {
+				negative = (*p == '-');
+				p++;
+			}
+			if (p < end && (*p == '-' || *p == '+')) {
+				return false;
+			}
+			T v{};
+			auto r = std::from_chars(p, end, v);
+			if (r.ec != std::errc() && r.ec != std::errc::result_out_of_range) {
+				return false;
+			}
+			if (r.ptr != end) {
+				return false;
+			}
+			*value = negative ? -v : v;
+			return true;
+		}
+	public:
+		template<typename T>
+		static bool Parse(const char* p, size_t size, T* value)
+		{
+			static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "ItsDecimal::Parse supports float and double");
+			using F = Format<T>;
+
+			const char* end = p + size;
+			Decimal d;
+			if (!ItsDecimal::Scan(p, end, &d)) {
+				// inf, nan and anything else from_chars accepts, or malformed.
+				return ItsDecimal::Fallback(p, end, value);
+			}
+
+			// Clinger: exact when both mantissa and power of ten are exact in T.
+			if (!d.Truncated && d.Exponent >= -F::MaxExactPowerOfTen && d.Exponent <= F::MaxExactPowerOfTen && d.Mantissa <= F::MaxExactMantissa)
+			{
+				static constexpr T powers[] = { T(1e0), T(1e1), T(1e2), T(1e3), T(1e4), T(1e5), T(1e6), T(1e7), T(1e8), T(1e9), T(1e10),
+					T(1e11), T(1e12), T(1e13), T(1e14), T(1e15), T(1e16), T(1e17), T(1e18), T(1e19), T(1e20), T(1e21), T(1e22) };
+				T v = static_cast<T>(d.Mantissa);
+				v = (d.Exponent < 0) ? v / powers[-d.Exponent] : v * powers[d.Exponent];
+				*value = d.Negative ? -v : v;
+				return true;
+			}
+
+			uint64_t bits = ItsDecimal::Compute<T>(d.Exponent, d.Mantissa);
+			if (d.Truncated && bits != ItsDecimal::Compute<T>(d.Exponent, d.Mantissa + 1)) {
+				return ItsDecimal::Fallback(p, end, value);
+			}
+			*value = ItsDecimal::FromBits<T>(bits, d.Negative);
+			return true;
+		}
+
+		template<typename T>
+		static bool Parse(const wchar_t* p, size_t size, T* value)
+		{
+			char narrow[128];
+			if (size > sizeof(narrow)) {
+				string copy(size, '\0');
+				for (size_t i = 0; i < size; i++) {
+					copy[i] = (static_cast<uint32_t>(p[i]) < 0x80) ? static_cast<char>(p[i]) : '\x80';
+				}
+				return ItsDecimal::Parse(copy.data(), size, value);
+			}
+			for (size_t i = 0; i < size; i++) {
+				narrow[i] = (static_cast<uint32_t>(p[i]) < 0x80) ? static_cast<char>(p[i]) : '\x80';
+			}
+			return ItsDecimal::Parse(narrow, size, value);
+		}
+
+		//
+		// Any arithmetic T: float/double through Parse, the rest through std::from_chars.
+		//
+		template<typename T, typename Char>
+		static bool ParseNumber(const Char* p, size_t size, T* value)
+		{
+			if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+			{
+				return ItsDecimal::Parse(p, size, value);
+			}
+			else if constexpr (sizeof(Char) == 1)
+			{
+				const char* q = reinterpret_cast<const char*>(p);
+				if (size > 0 && *q == '+' && (size == 1 || q[1] != '-')) {
+					q++;
+					size--;
+				}
+				auto r = std::from_chars(q, q + size, *value);
+				return r.ec == std::errc() && r.ptr == q + size;
+			}
+			else
+			{
+				string narrow(size, '\0');
+				for (size_t i = 0; i < size; i++) {
+					narrow[i] = (static_cast<uint32_t>(p[i]) < 0x80) ? static_cast<char>(p[i]) : '\x80';
+				}
+				return ItsDecimal::ParseNumber(narrow.data(), size, value);
+			}
+		}
+
+		//
+		// Parses texts into values row by row. Failed rows get T{} and are listed in failedRows
+		// (ascending) when given. Columns of at least parallelThreshold rows are split across threads,
+		// at least 4096 rows per thread.
+		// Returns number of failed rows.
+		//
+		template<typename T, typename StringView>
+		static size_t ParseColumn(std::span<const StringView> texts, std::span<T> values, vector<size_t>* failedRows = nullptr, size_t parallelThreshold = 1 << 16)
+		{
+			const size_t count = (texts.size() < values.size()) ? texts.size() : values.size();
+
+			auto work = [&texts, &values](size_t from, size_t to, vector<size_t>& failed) {
+				for (size_t i = from; i < to; i++)
+				{
+					if (!ItsDecimal::ParseNumber(texts[i].data(), texts[i].size(), &values[i])) {
+						values[i] = T{};
+						failed.push_back(i);
+					}
+				}
+			};
+
+			size_t threads = std::thread::hardware_concurrency();
+			if (threads > count / 4096) {
+				threads = count / 4096;
+			}
+			if (count < parallelThreshold || threads < 2)
+			{
+				vector<size_t> failed;
+				work(0, count, failed);
+				if (failedRows != nullptr) {
+					failedRows->insert(failedRows->end(), failed.begin(), failed.end());
+				}
+				return failed.size();
+			}
+
+			vector<vector<size_t>> failed(threads);
+			vector<std::thread> workers;
+			workers.reserve(threads - 1);
+			size_t chunk = (count + threads - 1) / threads;
+			for (size_t t = 1; t < threads; t++)
+			{
+				size_t from = t * chunk;
+				size_t to = (from + chunk < count) ? from + chunk : count;
+				workers.emplace_back(work, from, to, std::ref(failed[t]));
+			}
+			work(0, chunk, failed[0]);
+			for (auto& w : workers) {
+				w.join();
+			}
+
+			size_t total = 0;
+			for (auto& f : failed)
+			{
+				total += f.size();
+				if (failedRows != nullptr) {
+					failedRows->insert(failedRows->end(), f.begin(), f.end());
+				}
+			}
+			return total;
+		}
+	};
+
+	template<>
+	struct ItsDecimal::Format<double>
+	{
+		using Bits = uint64_t;
+		static constexpr int MantissaBits = 52;
+		static constexpr int MinimumExponent = -1023;
+		static constexpr int InfinitePower = 0x7FF;
+		static constexpr int64_t SmallestPowerOfTen = -342;
+		static constexpr int64_t LargestPowerOfTen = 308;
+		static constexpr int64_t MinRoundToEven = -4;
+		static constexpr int64_t MaxRoundToEven = 23;
+		static constexpr int64_t MaxExactPowerOfTen = 22;
+		static constexpr uint64_t MaxExactMantissa = uint64_t(1) << 53;
+	};
+
+	template<>
+	struct ItsDecimal::Format<float>
+	{
+		using Bits = uint32_t;
+		static constexpr int MantissaBits = 23;
+		static constexpr int MinimumExponent = -127;
+		static constexpr int InfinitePower = 0xFF;
+		static constexpr int64_t SmallestPowerOfTen = -65;
+		static constexpr int64_t LargestPowerOfTen = 38;
+		static constexpr int64_t MinRoundToEven = -17;
+		static constexpr int64_t MaxRoundToEven = 10;
+		static constexpr int64_t MaxExactPowerOfTen = 10;
+		static constexpr uint64_t MaxExactMantissa = uint64_t(1) << 24;
+	};
+
+	//
+	// enum: ItsColorFormat
+	//
+	// (i): Text forms handled by ItsColor.
+	//
+	enum class ItsColorFormat
+	{
+		RGB,		// r,g,b
+		Hex,		// #rrggbb, #rrggbbaa when alpha is not opaque
+		HSL			// hsl(h, s%, l%)
+	};
+
+	//
+	// enum: ItsPixelFormat
+	//
+	// (i): Byte order of a 32 bit pixel in memory.
+	//
+	enum class ItsPixelFormat
+	{
+		RGBA,
+		BGRA,
+		ARGB,
+		ABGR
+	};
+
+	//
+	// struct: ItsHSV
+	//
+	// (i): Hue in degrees [0, 360), saturation, value and alpha in [0, 1].
+	//
+	struct ItsHSV
+	{
+		float H{ 0 };
+		float S{ 0 };
+		float V{ 0 };
+		float A{ 1 };
+	};
+
+	//
+	// struct: ItsColor
+	//
+	// (i): Portable RGBA color, stored as R, G, B, A bytes. COLORREF (0x00BBGGRR) compatible packing.
+	//
+	struct ItsColor
+	{
+		uint8_t R{ 0 };
+		uint8_t G{ 0 };
+		uint8_t B{ 0 };
+		uint8_t A{ 255 };
+
+		constexpr ItsColor() = default;
+
+		constexpr ItsColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255)
+			: R(r), G(g), B(b), A(a)
+		{
+		}
+
+		static constexpr ItsColor FromCOLORREF(uint32_t colorref)
+		{
+			return ItsColor(static_cast<uint8_t>(colorref), static_cast<uint8_t>(colorref >> 8), static_cast<uint8_t>(colorref >> 16));
+		}
+
+		constexpr uint32_t ToCOLORREF() const
+		{
+			return static_cast<uint32_t>(this->R) | (static_cast<uint32_t>(this->G) << 8) | (static_cast<uint32_t>(this->B) << 16);
+		}
+
+		constexpr bool operator==(const ItsColor& other) const = default;
+
+		static ItsColor FromHSL(float h, float s, float l, uint8_t a = 255)
+		{
+			h = h - 360.0f * std::floor(h / 360.0f);
+			float chroma = s * ((l < 1.0f - l) ? l : 1.0f - l);
+			auto channel = [h, l, chroma](float n) {
+				float k = n + h / 30.0f;
+				k -= 12.0f * std::floor(k / 12.0f);
+				float t = std::min({ k - 3.0f, 9.0f - k, 1.0f });
+				return static_cast<uint8_t>(std::lround(255.0f * (l - chroma * ((t > -1.0f) ? t : -1.0f))));
+			};
+			return ItsColor(channel(0.0f), channel(8.0f), channel(4.0f), a);
+		}
+
+		void ToHSL(float* h, float* s, float* l) const
+		{
+			float r = this->R / 255.0f, g = this->G / 255.0f, b = this->B / 255.0f;
+			float max = std::max({ r, g, b }), min = std::min({ r, g, b });
+			float delta = max - min;
+			*l = (max + min) / 2.0f;
+			*s = (delta == 0.0f) ? 0.0f : delta / (1.0f - std::fabs(2.0f * *l - 1.0f));
+			if (delta == 0.0f) {
+				*h = 0.0f;
+			}
+			else if (max == r) {
+				*h = 60.0f * std::fmod((g - b) / delta + 6.0f, 6.0f);
+			}
+			else if (max == g) {
+				*h = 60.0f * ((b - r) / delta + 2.0f);
+			}
+			else {
+				*h = 60.0f * ((r - g) / delta + 4.0f);
+			}
+		}
+
+	private:
+		template<typename Char>
+		static void SkipSpace(const Char*& p, const Char* end)
+		{
+			while (p < end && (*p == ' ' || *p == '\t')) {
+				p++;
+			}
+		}
+
+		template<typename Char>
+		static bool ParseByte(const Char*& p, const Char* end, uint8_t* value)
+		{
+			ItsColor::SkipSpace(p, end);
+			unsigned int v = 0;
+			int digits = 0;
+			while (p < end && digits < 4 && *p >= '0' && *p <= '9') {
+				v = v * 10 + static_cast<unsigned int>(*p - '0');
+				p++;
+				digits++;
+			}
+			ItsColor::SkipSpace(p, end);
+			if (digits == 0 || v > 255) {
+				return false;
+			}
+			*value = static_cast<uint8_t>(v);
+			return true;
+		}
+
+		template<typename Char>
+		static bool ParseFloat(const Char*& p, const Char* end, float* value)
+		{
+			ItsColor::SkipSpace(p, end);
+			char buffer[16];
+			size_t n = 0;
+			while (p < end && n < sizeof(buffer) && ((*p >= '0' && *p <= '9') || *p == '.' || *p == '-' || *p == '+')) {
+				buffer[n++] = static_cast<char>(*p++);
+			}
+			ItsColor::SkipSpace(p, end);
+			return n > 0 && ItsDecimal::Parse(buffer, n, value);
+		}
+
+		template<typename Char>
+		static int HexDigit(Char c)
+		{
+			if (c >= '0' && c <= '9') return c - '0';
+			if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+			if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+			return -1;
+		}
+
+		template<typename Char>
+		static Char* PutByte(Char* p, uint8_t v)
+		{
+			if (v >= 100) {
+				*p++ = static_cast<Char>('0' + v / 100);
+			}
+			if (v >= 10) {
+				*p++ = static_cast<Char>('0' + (v / 10) % 10);
+			}
+			*p++ = static_cast<Char>('0' + v % 10);
+			return p;
+		}
+
+		template<typename Char>
+		static Char* PutHex(Char* p, uint8_t v)
+		{
+			*p++ = static_cast<Char>("0123456789abcdef"[v >> 4]);
+			*p++ = static_cast<Char>("0123456789abcdef"[v & 0xF]);
+			return p;
+		}
+
+		template<typename Char>
+		static Char* PutInt(Char* p, int v)
+		{
+			Char digits[12];
+			int n = 0;
+			do {
+				digits[n++] = static_cast<Char>('0' + v % 10);
+				v /= 10;
+			} while (v > 0);
+			while (n > 0) {
+				*p++ = digits[--n];
+			}
+			return p;
+		}
+	public:
+		inline static constexpr size_t MaxLength = 24;
+
+		//
+		// Accepts "r,g,b", "#rgb", "#rrggbb", "#rrggbbaa" and "hsl(h, s%, l%)".
+		//
+		template<typename Char>
+		static bool Parse(const Char* p, size_t size, ItsColor* color)
+		{
+			const Char* end = p + size;
+			ItsColor::SkipSpace(p, end);
+			while (end > p && (end[-1] == ' ' || end[-1] == '\t')) {
+				end--;
+			}
+			size = static_cast<size_t>(end - p);
+
+			if (size > 0 && *p == '#')
+			{
+				size_t n = size - 1;
+				if (n != 3 && n != 6 && n != 8) {
+					return false;
+				}
+				int v[8]{ 0 };
+				for (size_t i = 0; i < n; i++)
+				{
+					v[i] = ItsColor::HexDigit(p[i + 1]);
+					if (v[i] < 0) {
+						return false;
+					}
+				}
+				if (n == 3) {
+					*color = ItsColor(static_cast<uint8_t>(v[0] * 17), static_cast<uint8_t>(v[1] * 17), static_cast<uint8_t>(v[2] * 17));
+				}
+				else {
+					*color = ItsColor(static_cast<uint8_t>(v[0] * 16 + v[1]), static_cast<uint8_t>(v[2] * 16 + v[3]), static_cast<uint8_t>(v[4] * 16 + v[5]),
+						(n == 8) ? static_cast<uint8_t>(v[6] * 16 + v[7]) : static_cast<uint8_t>(255));
+				}
+				return true;
+			}
+
+			if (size > 4 && (p[0] == 'h' || p[0] == 'H') && (p[1] == 's' || p[1] == 'S') && (p[2] == 'l' || p[2] == 'L') && p[3] == '(' && end[-1] == ')')
+			{
+				const Char* q = p + 4;
+				const Char* e = end - 1;
+				float h = 0, s = 0, l = 0;
+				if (!ItsColor::ParseFloat(q, e, &h) || q == e || *q++ != ',') {
+					return false;
+				}
+				if (!ItsColor::ParseFloat(q, e, &s) || q == e || *q++ != '%') {
+					return false;
+				}
+				ItsColor::SkipSpace(q, e);
+				if (q == e || *q++ != ',') {
+					return false;
+				}
+				if (!ItsColor::ParseFloat(q, e, &l) || q == e || *q++ != '%') {
+					return false;
+				}
+				ItsColor::SkipSpace(q, e);
+				if (q != e || s < 0 || s > 100 || l < 0 || l > 100) {
+					return false;
+				}
+				*color = ItsColor::FromHSL(h, s / 100.0f, l / 100.0f);
+				return true;
+			}
+
+			uint8_t r = 0, g = 0, b = 0;
+			if (!ItsColor::ParseByte(p, end, &r) || p == end || *p++ != ',') {
+				return false;
+			}
+			if (!ItsColor::ParseByte(p, end, &g) || p == end || *p++ != ',') {
+				return false;
+			}
+			if (!ItsColor::ParseByte(p, end, &b) || p != end) {
+				return false;
+			}
+			*color = ItsColor(r, g, b);
+			return true;
+		}
+
+		static bool Parse(std::string_view text, ItsColor* color)
+		{
+			return ItsColor::Parse(text.data(), text.size(), color);
+		}
+
+		static bool Parse(std::wstring_view text, ItsColor* color)
+		{
+			return ItsColor::Parse(text.data(), text.size(), color);
+		}
+
+		//
+		// Writes at most MaxLength chars. Returns chars written.
+		//
+		template<typename Char>
+		size_t Format(Char* out, ItsColorFormat format) const
+		{
+			Char* p = out;
+			if (format == ItsColorFormat::Hex)
+			{
+				*p++ = static_cast<Char>('#');
+				p = ItsColor::PutHex(p, this->R);
+				p = ItsColor::PutHex(p, this->G);
+				p = ItsColor::PutHex(p, this->B);
+				if (this->A != 255) {
+					p = ItsColor::PutHex(p, this->A);
+				}
+			}
+			else if (format == ItsColorFormat::HSL)
+			{
+				float h = 0, s = 0, l = 0;
+				this->ToHSL(&h, &s, &l);
+				for (const char* c = "hsl("; *c; c++) {
+					*p++ = static_cast<Char>(*c);
+				}
+				p = ItsColor::PutInt(p, static_cast<int>(std::lround(h)) % 360);
+				*p++ = static_cast<Char>(',');
+				*p++ = static_cast<Char>(' ');
+				p = ItsColor::PutInt(p, static_cast<int>(std::lround(s * 100.0f)));
+				*p++ = static_cast<Char>('%');
+				*p++ = static_cast<Char>(',');
+				*p++ = static_cast<Char>(' ');
+				p = ItsColor::PutInt(p, static_cast<int>(std::lround(l * 100.0f)));
+				*p++ = static_cast<Char>('%');
+				*p++ = static_cast<Char>(')');
+			}
+			else
+			{
+				p = ItsColor::PutByte(p, this->R);
+				*p++ = static_cast<Char>(',');
+				p = ItsColor::PutByte(p, this->G);
+				*p++ = static_cast<Char>(',');
+				p = ItsColor::PutByte(p, this->B);
+			}
+			return static_cast<size_t>(p - out);
+		}
+
+		wstring ToString(ItsColorFormat format = ItsColorFormat::RGB) const
+		{
+			wchar_t buffer[MaxLength];
+			return wstring(buffer, this->Format(buffer, format));
+		}
+	};
+
+	//
+	// struct: ItsPixels
+	//
+	// (i): Bulk conversions over ItsColor spans. SSSE3/AVX2 kernels picked at runtime, scalar tail.
+	//
+	struct ItsPixels
+	{
+	private:
+		//
+		// Byte index in source pixel for each destination byte.
+		//
+		static std::array<uint8_t, 4> SwapOrder(ItsPixelFormat from, ItsPixelFormat to)
+		{
+			// Position of R, G, B, A bytes in each format.
+			static constexpr uint8_t positions[4][4] = {
+				{ 0, 1, 2, 3 },	// RGBA
+				{ 2, 1, 0, 3 },	// BGRA
+				{ 1, 2, 3, 0 },	// ARGB
+				{ 3, 2, 1, 0 }	// ABGR
+			};
+			const uint8_t* src = positions[static_cast<int>(from)];
+			const uint8_t* dst = positions[static_cast<int>(to)];
+			std::array<uint8_t, 4> order{};
+			for (int channel = 0; channel < 4; channel++) {
+				order[dst[channel]] = src[channel];
+			}
+			return order;
+		}
+
+		static uint8_t ToByte(float v)
+		{
+			v = std::min(std::max(v, 0.0f), 1.0f);
+			return static_cast<uint8_t>(static_cast<int>(v * 255.0f + 0.5f));
+		}
+
+		static void ToHSVScalar(const ItsColor& c, ItsHSV* hsv)
+		{
+			float r = c.R, g = c.G, b = c.B;
+			float max = std::max(r, std::max(g, b));
+			float min = std::min(r, std::min(g, b));
+			float delta = max - min;
+			float h = 0.0f;
+			if (delta > 0.0f)
+			{
+				if (max == r) {
+					h = (g - b) / delta;
+				}
+				else if (max == g) {
+					h = (b - r) / delta + 2.0f;
+				}
+				else {
+					h = (r - g) / delta + 4.0f;
+				}
+				h = h * 60.0f;
+				if (h < 0.0f) {
+					h = h + 360.0f;
+				}
+			}
+			hsv->H = h;
+			hsv->S = (max > 0.0f) ? delta / max : 0.0f;
+			hsv->V = max * (1.0f / 255.0f);
+			hsv->A = c.A * (1.0f / 255.0f);
+		}
+
+		//
+		// f(n) = V - V * S * clamp(min(k, 4 - k), 0, 1), k = (n + H / 60) mod 6.
+		//
+		static float HSVChannel(float n, const ItsHSV& hsv)
+		{
+			float k = n + hsv.H * (1.0f / 60.0f);
+			k = k - 6.0f * static_cast<float>(static_cast<int>(k * (1.0f / 6.0f)));
+			float t = std::min(k, 4.0f - k);
+			t = std::max(0.0f, std::min(t, 1.0f));
+			return hsv.V - hsv.V * hsv.S * t;
+		}
+
+		static void FromHSVScalar(const ItsHSV& hsv, ItsColor* c)
+		{
+			c->R = ItsPixels::ToByte(ItsPixels::HSVChannel(5.0f, hsv));
+			c->G = ItsPixels::ToByte(ItsPixels::HSVChannel(3.0f, hsv));
+			c->B = ItsPixels::ToByte(ItsPixels::HSVChannel(1.0f, hsv));
+			c->A = ItsPixels::ToByte(hsv.A);
+		}
+
+		static uint8_t Premultiply(uint8_t c, uint8_t a)
+		{
+			unsigned int x = static_cast<unsigned int>(c) * a + 128;
+			return static_cast<uint8_t>((x + (x >> 8)) >> 8);
+		}
+
+#if defined(ITS_X86)
+		ITS_TARGET("ssse3")
+		static size_t SwapSSSE3(const uint8_t* in, uint8_t* out, size_t pixels, const std::array<uint8_t, 4>& order)
+		{
+			alignas(16) int8_t m[16];
+			for (int i = 0; i < 16; i++) {
+				m[i] = static_cast<int8_t>((i & ~3) + order[i & 3]);
+			}
+			const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(m));
+			size_t i = 0;
+			for (; i + 4 <= pixels; i += 4) {
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 4), _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 4)), mask));
+			}
+			return i;
+		}
+
+		ITS_TARGET("avx2")
+		static size_t SwapAVX2(const uint8_t* in, uint8_t* out, size_t pixels, const std::array<uint8_t, 4>& order)
+		{
+			alignas(16) int8_t m[16];
+			for (int i = 0; i < 16; i++) {
+				m[i] = static_cast<int8_t>((i & ~3) + order[i & 3]);
+			}
+			const __m256i mask = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(m)));
+			size_t i = 0;
+			for (; i + 8 <= pixels; i += 8) {
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 4), _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i * 4)), mask));
+			}
+			return i;
+		}
+
+		ITS_TARGET("ssse3")
+		static size_t PremultiplySSSE3(const uint8_t* in, uint8_t* out, size_t pixels)
+		{
+			// Alpha of each pixel in every 16 bit lane; alpha lane itself multiplied by 255 -> unchanged.
+			const __m128i alphaLo = _mm_setr_epi8(3, -1, 3, -1, 3, -1, -1, -1, 7, -1, 7, -1, 7, -1, -1, -1);
+			const __m128i alphaHi = _mm_setr_epi8(11, -1, 11, -1, 11, -1, -1, -1, 15, -1, 15, -1, 15, -1, -1, -1);
+			const __m128i opaque = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i bias = _mm_set1_epi16(128);
+			size_t i = 0;
+			for (; i + 4 <= pixels; i += 4)
+			{
+				__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 4));
+				__m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(v, zero), _mm_or_si128(_mm_shuffle_epi8(v, alphaLo), opaque));
+				__m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(v, zero), _mm_or_si128(_mm_shuffle_epi8(v, alphaHi), opaque));
+				lo = _mm_add_epi16(lo, bias);
+				hi = _mm_add_epi16(hi, bias);
+				lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+				hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 4), _mm_packus_epi16(lo, hi));
+			}
+			return i;
+		}
+
+		//
+		// 4 pixels per iteration, channels de-interleaved into float lanes.
+		//
+		ITS_TARGET("ssse3")
+		static size_t ToHSVSSSE3(const ItsColor* in, ItsHSV* out, size_t pixels)
+		{
+			const __m128i takeR = _mm_setr_epi8(0, -1, -1, -1, 4, -1, -1, -1, 8, -1, -1, -1, 12, -1, -1, -1);
+			const __m128i takeG = _mm_setr_epi8(1, -1, -1, -1, 5, -1, -1, -1, 9, -1, -1, -1, 13, -1, -1, -1);
+			const __m128i takeB = _mm_setr_epi8(2, -1, -1, -1, 6, -1, -1, -1, 10, -1, -1, -1, 14, -1, -1, -1);
+			const __m128i takeA = _mm_setr_epi8(3, -1, -1, -1, 7, -1, -1, -1, 11, -1, -1, -1, 15, -1, -1, -1);
+			const __m128 zero = _mm_setzero_ps();
+			size_t i = 0;
+			for (; i + 4 <= pixels; i += 4)
+			{
+				__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+				__m128 r = _mm_cvtepi32_ps(_mm_shuffle_epi8(v, takeR));
+				__m128 g = _mm_cvtepi32_ps(_mm_shuffle_epi8(v, takeG));
+				__m128 b = _mm_cvtepi32_ps(_mm_shuffle_epi8(v, takeB));
+				__m128 a = _mm_cvtepi32_ps(_mm_shuffle_epi8(v, takeA));
+
+				__m128 max = _mm_max_ps(r, _mm_max_ps(g, b));
+				__m128 min = _mm_min_ps(r, _mm_min_ps(g, b));
+				__m128 delta = _mm_sub_ps(max, min);
+				__m128 isR = _mm_cmpeq_ps(max, r);
+				__m128 isG = _mm_andnot_ps(isR, _mm_cmpeq_ps(max, g));
+				__m128 isB = _mm_andnot_ps(_mm_or_ps(isR, isG), _mm_cmpeq_ps(zero, zero));
+				__m128 hr = _mm_div_ps(_mm_sub_ps(g, b), delta);
+				__m128 hg = _mm_add_ps(_mm_div_ps(_mm_sub_ps(b, r), delta), _mm_set1_ps(2.0f));
+				__m128 hb = _mm_add_ps(_mm_div_ps(_mm_sub_ps(r, g), delta), _mm_set1_ps(4.0f));
+				__m128 h = _mm_or_ps(_mm_and_ps(isR, hr), _mm_or_ps(_mm_and_ps(isG, hg), _mm_and_ps(isB, hb)));
+				h = _mm_mul_ps(h, _mm_set1_ps(60.0f));
+				h = _mm_add_ps(h, _mm_and_ps(_mm_cmplt_ps(h, zero), _mm_set1_ps(360.0f)));
+				h = _mm_and_ps(h, _mm_cmpgt_ps(delta, zero));
+				__m128 s = _mm_and_ps(_mm_div_ps(delta, max), _mm_cmpgt_ps(max, zero));
+				__m128 val = _mm_mul_ps(max, _mm_set1_ps(1.0f / 255.0f));
+				a = _mm_mul_ps(a, _mm_set1_ps(1.0f / 255.0f));
+
+				_MM_TRANSPOSE4_PS(h, s, val, a);
+				float* o = reinterpret_cast<float*>(out + i);
+				_mm_storeu_ps(o, h);
+				_mm_storeu_ps(o + 4, s);
+				_mm_storeu_ps(o + 8, val);
+				_mm_storeu_ps(o + 12, a);
+			}
+			return i;
+		}
+
+		static __m128i ToBytes(__m128 v)
+		{
+			v = _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+			return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f)));
+		}
+
+		static __m128 HSVChannel(__m128 n, __m128 h, __m128 vs, __m128 v)
+		{
+			__m128 k = _mm_add_ps(n, _mm_mul_ps(h, _mm_set1_ps(1.0f / 60.0f)));
+			__m128 q = _mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_mul_ps(k, _mm_set1_ps(1.0f / 6.0f))));
+			k = _mm_sub_ps(k, _mm_mul_ps(_mm_set1_ps(6.0f), q));
+			__m128 t = _mm_min_ps(k, _mm_sub_ps(_mm_set1_ps(4.0f), k));
+			t = _mm_max_ps(_mm_setzero_ps(), _mm_min_ps(t, _mm_set1_ps(1.0f)));
+			return _mm_sub_ps(v, _mm_mul_ps(vs, t));
+		}
+
+		ITS_TARGET("ssse3")
+		static size_t FromHSVSSSE3(const ItsHSV* in, ItsColor* out, size_t pixels)
+		{
+			size_t i = 0;
+			for (; i + 4 <= pixels; i += 4)
+			{
+				const float* p = reinterpret_cast<const float*>(in + i);
+				__m128 h = _mm_loadu_ps(p);
+				__m128 s = _mm_loadu_ps(p + 4);
+				__m128 v = _mm_loadu_ps(p + 8);
+				__m128 a = _mm_loadu_ps(p + 12);
+				_MM_TRANSPOSE4_PS(h, s, v, a);
+
+				__m128 vs = _mm_mul_ps(v, s);
+				__m128i r = ItsPixels::ToBytes(ItsPixels::HSVChannel(_mm_set1_ps(5.0f), h, vs, v));
+				__m128i g = ItsPixels::ToBytes(ItsPixels::HSVChannel(_mm_set1_ps(3.0f), h, vs, v));
+				__m128i b = ItsPixels::ToBytes(ItsPixels::HSVChannel(_mm_set1_ps(1.0f), h, vs, v));
+				__m128i al = ItsPixels::ToBytes(a);
+
+				__m128i rgba = _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 8)), _mm_or_si128(_mm_slli_epi32(b, 16), _mm_slli_epi32(al, 24)));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), rgba);
+			}
+			return i;
+		}
+#endif
+	public:
+		//
+		// Reorders bytes of each 32 bit pixel. in and out may be the same buffer.
+		//
+		static void Swap(std::span<const uint32_t> in, std::span<uint32_t> out, ItsPixelFormat from, ItsPixelFormat to)
+		{
+			size_t pixels = (in.size() < out.size()) ? in.size() : out.size();
+			const uint8_t* src = reinterpret_cast<const uint8_t*>(in.data());
+			uint8_t* dst = reinterpret_cast<uint8_t*>(out.data());
+			auto order = ItsPixels::SwapOrder(from, to);
+
+			size_t i = 0;
+#if defined(ITS_X86)
+			if (ItsCpu::HasAVX2()) {
+				i += ItsPixels::SwapAVX2(src, dst, pixels, order);
+			}
+			if (ItsCpu::HasSSSE3()) {
+				i += ItsPixels::SwapSSSE3(src + i * 4, dst + i * 4, pixels - i, order);
+			}
+#endif
+			for (; i < pixels; i++)
+			{
+				uint8_t p[4] = { src[i * 4], src[i * 4 + 1], src[i * 4 + 2], src[i * 4 + 3] };
+				for (int k = 0; k < 4; k++) {
+					dst[i * 4 + k] = p[order[k]];
+				}
+			}
+		}
+
+		static void ToCOLORREF(std::span<const ItsColor> in, std::span<uint32_t> out)
+		{
+			size_t pixels = (in.size() < out.size()) ? in.size() : out.size();
+			for (size_t i = 0; i < pixels; i++) {
+				out[i] = in[i].ToCOLORREF();
+			}
+		}
+
+		//
+		// c = round(c * a / 255) for R, G and B; alpha unchanged.
+		//
+		static void Premultiply(std::span<const ItsColor> in, std::span<ItsColor> out)
+		{
+			size_t pixels = (in.size() < out.size()) ? in.size() : out.size();
+			size_t i = 0;
+#if defined(ITS_X86)
+			if (ItsCpu::HasSSSE3()) {
+				i = ItsPixels::PremultiplySSSE3(reinterpret_cast<const uint8_t*>(in.data()), reinterpret_cast<uint8_t*>(out.data()), pixels);
+			}
+#endif
+			for (; i < pixels; i++)
+			{
+				ItsColor c = in[i];
+				out[i] = ItsColor(ItsPixels::Premultiply(c.R, c.A), ItsPixels::Premultiply(c.G, c.A), ItsPixels::Premultiply(c.B, c.A), c.A);
+			}
+		}
+
+		static void ToHSV(std::span<const ItsColor> in, std::span<ItsHSV> out)
+		{
+			size_t pixels = (in.size() < out.size()) ? in.size() : out.size();
+			size_t i = 0;
+#if defined(ITS_X86)
+			if (ItsCpu::HasSSSE3()) {
+				i = ItsPixels::ToHSVSSSE3(in.data(), out.data(), pixels);
+			}
+#endif
+			for (; i < pixels; i++) {
+				ItsPixels::ToHSVScalar(in[i], &out[i]);
+			}
+		}
+
+		static void FromHSV(std::span<const ItsHSV> in, std::span<ItsColor> out)
+		{
+			size_t pixels = (in.size() < out.size()) ? in.size() : out.size();
+			size_t i = 0;
+#if defined(ITS_X86)
+			if (ItsCpu::HasSSSE3()) {
+				i = ItsPixels::FromHSVSSSE3(in.data(), out.data(), pixels);
+			}
+#endif
+			for (; i < pixels; i++) {
+				ItsPixels::FromHSVScalar(in[i], &out[i]);
+			}
+		}
+	};
+
+	//
+	// enum: DataSizeStringType
+	//
+	// (i): Enum for string representation of ToDataSizeString ItsConvert function.
+	//
+	enum class ItsDataSizeStringType {
+		Recommended,
+		IEC
+	};
+
+	//
+	// struct: ItsConvert
+	//
+	// (i): Misc. convertion routines in one place.
+	//
+	struct ItsConvert
+	{
+		static wstring ToDataSizeString(size_t size)
+		{
+			return ItsConvert::ToDataSizeString(size, 0);
+		}
+		static wstring ToDataSizeString(size_t size, int digits)
+		{
+			return ItsConvert::ToDataSizeString(size, digits, ItsDataSizeStringType::Recommended);
+		}
+		static wstring ToDataSizeString(size_t size, int digits, ItsDataSizeStringType type)
+		{
+			if (digits < 0)
+			{
+				digits = 0;
+			}
+			else if (digits > 3)
+			{
+				digits = 3;
+			}
+
+			wstringstream ss;
+			double dSize = (double)size;
+
+			int index = 0;
+			while (dSize >= 1024)
+			{
+				dSize /= 1024;
+				index++;
+			}
+
+			vector<wstring> szSize;
+			if (type == ItsDataSizeStringType::IEC) {
+				szSize = { L"Bi", L"KiB", L"MiB", L"GiB", L"TiB", L"PiB", L"EiB", L"ZiB", L"YiB", L"BB", L"GP" };
+			}
+			else {//(type == ItsDataSizeStringType::Recommended) { // defaults to this notation
+				szSize = { L"B", L"KB", L"MB", L"GB", L"TB", L"PB", L"EB", L"ZB", L"YB", L"BB", L"GP" };
+			}
+
+			size_t tst = (size_t)dSize;
+			ss << tst;
+			if (digits > 0) {
+				double t = dSize - tst;
+				wstring ws = ItsConvert::ToString<double>(t);
+				if (ws[0] == '0' && t != 0.0) {
+					ws += L"000";
+				}
+				else {
+					ws += L".000";
+				}
+				ss << ws.substr(1, static_cast<size_t>(digits) + 1);
+			}
+			ss << L" ";
+			ss << ((index > (szSize.size() - 1) || index < 0) ? L"?" : szSize[index]);
+
+			wstring retVal = ss.str();
+			return retVal;
+		}
+
+#pragma warning(disable:4244)
+		template<typename Numeric>
+		static Numeric ToNumber(const wstring& str)
+		{
+			if (std::is_same_v<Numeric, char>)
+			{
+				return static_cast<char>(std::stoi(str));
+			}
+			else if (std::is_same_v<Numeric, unsigned char>)
+			{
+				return static_cast<unsigned char>(std::stoi(str));
+			}
+			else if (std::is_same_v<Numeric, short>)
+			{
+				return static_cast<short>(std::stoi(str));
+			}
+			else if (std::is_same_v<Numeric, unsigned short>)
+			{
+				return static_cast<unsigned short>(std::stoi(str));
+			}
+			else if (std::is_same_v<Numeric, float>)
+			{
+				return std::stof(str);
+			}
+			else if (std::is_same_v<Numeric, double>)
+			{
+				return std::stod(str);
+			}
+			else if (std::is_same_v <Numeric, long double>)
+			{
+				return std::stold(str);
+			}
+			else if (std::is_same_v<Numeric, int>)
+			{
+				return std::stoi(str);
+			}
+			else if (std::is_same_v<Numeric, long>)
+			{
+				return std::stol(str);
+			}
+			else if (std::is_same_v<Numeric, long long>)
+			{
+				return std::stoll(str);
+			}
+			else if (std::is_same_v<Numeric, unsigned int>)
+			{
+				return static_cast<unsigned int>(std::stoul(str));
+			}
+			else if (std::is_same_v<Numeric, unsigned long>)
+			{
+				return std::stoul(str);
+			}
+			else if (std::is_same_v<Numeric, unsigned long long>)
+			{
+				return std::stoull(str);
+			}
+
+			Numeric x = std::stoull(str);
+			return x;
+		}
+#pragma warning(error: 4244)
+		//
+		// Non throwing, locale independent counterpart of ToNumber. Accepts narrow or wide text.
+		//
+		template<typename Numeric>
+		static bool TryToNumber(std::string_view str, Numeric* number)
+		{
+			return ItsDecimal::ParseNumber(str.data(), str.size(), number);
+		}
+
+		template<typename Numeric>
+		static bool TryToNumber(std::wstring_view str, Numeric* number)
+		{
+			return ItsDecimal::ParseNumber(str.data(), str.size(), number);
+		}
+
+		template<typename Numeric>
+		static size_t ParseColumn(std::span<const std::string_view> texts, std::span<Numeric> numbers, vector<size_t>* failedRows = nullptr)
+		{
+			return ItsDecimal::ParseColumn(texts, numbers, failedRows);
+		}
+
+		template<typename Numeric>
+		static size_t ParseColumn(std::span<const std::wstring_view> texts, std::span<Numeric> numbers, vector<size_t>* failedRows = nullptr)
+		{
+			return ItsDecimal::ParseColumn(texts, numbers, failedRows);
+		}
+
+		static long ToLongFromHex(const wstring& str)
+		{
+			wchar_t* p;
+			long n = wcstol(str.c_str(), &p, 16);
+			if (*p != 0) {
+				return 0;
+			}
+			return n;
+		}
+
+		static wstring ToString(const bool flag)
+		{
+			if (flag)
+			{
+				return wstring(L"True");
+			}
+			return wstring(L"False");
+		}
+
+		template<typename Numeric>
+		static wstring ToString(Numeric number)
+		{
+			wstringstream ss;
+			if (std::is_same_v<Numeric, float>)
+			{
+				ss << std::setprecision(std::numeric_limits<float>::digits10);
+			}
+			else if (std::is_same_v<Numeric, double>)
+			{
+				ss << std::setprecision(std::numeric_limits<double>::digits10);
+			}
+			else if (std::is_same_v<Numeric, long double>)
+			{
+				ss << std::setprecision(std::numeric_limits<long double>::digits10);
+			}
+			ss << number;
+
+			wstring tos = ss.str();
+			return tos;
+		}
+
+		static wstring ToStringFormatted(size_t number, wchar_t thousandSep = L',')
+		{
+			wstring txt = ItsConvert::ToString(number);
+
+			wstringstream ss;
+
+			int groupSize = 3;
+			int i = groupSize;
+			size_t iCount = 0;
+			size_t iSize = txt.size();
+			for (auto itr = txt.rbegin(); itr < txt.rend(); itr++)
+			{
+				if (i-- > 0)
+				{
+					ss << *itr;
+					iCount++;
+				}
+				else
+				{
+					if (iCount < iSize)
+					{
+						ss << thousandSep;
+						ss << *itr;
+						iCount++;
+						i = groupSize - 1;
+					}
+					else {
+						i = groupSize;
+					}
+				}
+
+			}
+
+			txt = ss.str();
+			wstringstream ss2;
+			for (auto itr = txt.rbegin(); itr < txt.rend(); itr++)
+			{
+				ss2 << *itr;
+			}
+
+			wstring retVal = ss2.str();
+
+			return retVal;
+		}
+
+		template<typename Numeric>
+		static string ToHexString(Numeric number, bool uppercase = true, uint32_t width = 0, wchar_t fillChar = L'0', bool showBase = false)
+		{
+			wstringstream ss;
+			ss << std::hex;
+			if (showBase)
+			{
+				ss << "0x";
+			}
+			if (uppercase)
+			{
+				ss << std::uppercase;
+			}
+			if (width > 0)
+			{
+				ss << std::setfill(fillChar) << std::setw(width);
+			}
+			ss << number;
+
+			wstring tos = ss.str();
+			return tos;
+		}
+
+		static wstring ToString(tm dateTime) {
+			wchar_t buffer[ItsISO8601::MaxLength];
+			size_t length = ItsISO8601::Format(dateTime, buffer);
+			return wstring(buffer, length);
+		}
+
+		static wstring ToString(const ItsTimestamp& timestamp, int fractionDigits)
+		{
+			wchar_t buffer[ItsISO8601::MaxLength];
+			size_t length = ItsISO8601::Format(timestamp.DateTime, buffer, timestamp.Nanosecond, fractionDigits, timestamp.HasOffset, timestamp.OffsetMinutes);
+			return wstring(buffer, length);
+		}
+
+		static tm ToTM(const wstring& dateTime)
+		{
+			ItsTimestamp timestamp;
+			if (!ItsISO8601::Parse(dateTime.data(), dateTime.size(), &timestamp)) {
+				throw std::invalid_argument("ItsConvert::ToTM: malformed ISO-8601 date time");
+			}
+			return timestamp.DateTime;
+		}
+
+		static bool ToTimestamp(std::string_view text, ItsTimestamp* timestamp)
+		{
+			return ItsISO8601::Parse(text.data(), text.size(), timestamp);
+		}
+
+		static bool ToTimestamp(std::wstring_view text, ItsTimestamp* timestamp)
+		{
+			return ItsISO8601::Parse(text.data(), text.size(), timestamp);
+		}
+
+		static size_t ToTimestamps(std::span<const std::string_view> texts, std::span<ItsTimestamp> timestamps, vector<size_t>* failedRows = nullptr)
+		{
+			return ItsISO8601::ParseColumn(texts, timestamps, failedRows);
+		}
+
+		static size_t ToTimestamps(std::span<const std::wstring_view> texts, std::span<ItsTimestamp> timestamps, vector<size_t>* failedRows = nullptr)
+		{
+			return ItsISO8601::ParseColumn(texts, timestamps, failedRows);
+		}
+
+		static bool ToBool(wstring flag) {
+
+			flag = ItsString::ToLowerCase(flag);
+
+			if (!wcscmp(flag.c_str(), L"true")) {
+				return true;
+			}
+			else if (!wcscmp(flag.c_str(), L"1")) {
+				return true;
+			}
+			else if (!wcscmp(flag.c_str(), L"yes")) {
+				return true;
+			}
+			else if (!wcscmp(flag.c_str(), L"on")) {
+				return true;
+			}
+			return false;
+		}
+
+		static COLORREF ToRGB(const wstring& color)
+		{
+			ItsColor c;
+			if (!ItsColor::Parse(color, &c)) {
+				throw std::invalid_argument("ItsConvert::ToRGB: malformed color");
+			}
+			return static_cast<COLORREF>(c.ToCOLORREF());
+		}
+
+		static wstring ToString(const vector<long long>& pks)
+		{
+			wstring tos(ItsPKList::FormattedLength(pks), L'\0');
+			ItsPKList::Format(std::span<const long long>(pks), tos.data());
+			return tos;
+		}
+
+		static string ToPKString(std::span<const long long> pks)
+		{
+			string tos(ItsPKList::FormattedLength(pks), '\0');
+			ItsPKList::Format(pks, tos.data());
+			return tos;
+		}
+
+		static vector<long long> ToPK(const wstring& pks)
+		{
+			// Ids and delimiters are ASCII; anything else becomes an invalid char.
+			string narrow(pks.size(), '\0');
+			for (size_t i = 0; i < pks.size(); i++) {
+				narrow[i] = (pks[i] < 0x80) ? static_cast<char>(pks[i]) : '\x80';
+			}
+
+			vector<long long> topk;
+			if (!ItsConvert::ToPK(narrow, topk)) {
+				throw std::invalid_argument("ItsConvert::ToPK: malformed primary key list");
+			}
+			return topk;
+		}
+
+		static bool ToPK(std::string_view pks, vector<long long>& out)
+		{
+			out.clear();
+			out.reserve(ItsPKList::CountDelimiters(pks.data(), pks.size()) + 1);
+			return ItsPKList::Parse(pks.data(), pks.size(), [&out](long long pk) {
+				out.push_back(pk);
+				return true;
+			});
+		}
+
+		static bool ToPK(std::string_view pks, std::span<long long> out, size_t* count)
+		{
+			size_t n = 0;
+			bool ok = ItsPKList::Parse(pks.data(), pks.size(), [&out, &n](long long pk) {
+				if (n == out.size()) {
+					return false;
+				}
+				out[n++] = pk;
+				return true;
+			});
+			*count = n;
+			return ok;
+		}
+
+		static vector<uint8_t> ToPKBinary(std::span<const long long> pks)
+		{
+			return ItsPKList::EncodeBinary(pks);
+		}
+
+		static bool FromPKBinary(const vector<uint8_t>& data, vector<long long>& pks)
+		{
+			return ItsPKList::DecodeBinary(data.data(), data.size(), pks);
+		}
+
+		static SYSTEMTIME ToSYSTEMTIME(tm dateTime)
+		{
+			SYSTEMTIME st = { 0 };
+
+			st.wYear = static_cast<WORD>(dateTime.tm_year + 1900);
+			st.wMonth = static_cast<WORD>(dateTime.tm_mon + 1);
+			st.wDay = static_cast<WORD>(dateTime.tm_mday);
+			st.wHour = static_cast<WORD>(dateTime.tm_hour);
+			st.wMinute = static_cast<WORD>(dateTime.tm_min);
+			st.wSecond = static_cast<WORD>(dateTime.tm_sec);
+
+			return st;
+		}
+
+		static tm ToTM(SYSTEMTIME st)
+		{
+			tm t = { 0 };
+
+			t.tm_year = st.wYear - 1900;
+			t.tm_mon = st.wMonth - 1;
+			t.tm_mday = st.wDay;
+			t.tm_hour = st.wHour;
+			t.tm_min = st.wMinute;
+			t.tm_sec = st.wSecond;
+
+			return t;
+		}
+
+		static string Base64Encode(const void* data, size_t size, ItsBase64Variant variant = ItsBase64Variant::Standard)
+		{
+			string text(ItsBase64::EncodedLength(size, variant), '\0');
+			if (size > 0) {
+				ItsBase64::Encode(static_cast<const uint8_t*>(data), size, text.data(), variant);
+			}
+			return text;
+		}
+
+		static string Base64Encode(const vector<uint8_t>& data, ItsBase64Variant variant = ItsBase64Variant::Standard)
+		{
+			return ItsConvert::Base64Encode(data.data(), data.size(), variant);
+		}
+
+		static bool Base64Decode(const string& text, vector<uint8_t>& data, ItsBase64Variant variant = ItsBase64Variant::Standard)
+		{
+			data.resize(ItsBase64::DecodedMaxLength(text.size()));
+			size_t written = 0;
+			bool ok = ItsBase64::Decode(text.data(), text.size(), data.data(), &written, variant);
+			data.resize(ok ? written : 0);
+			return ok;
+		}
+
+		static string Base32Encode(const void* data, size_t size, ItsBase32Variant variant = ItsBase32Variant::Standard)
+		{
+			string text(ItsBase32::EncodedLength(size, variant), '\0');
+			if (size > 0) {
+				ItsBase32::Encode(static_cast<const uint8_t*>(data), size, text.data(), variant);
+			}
+			return text;
+		}
+
+		static string Base32Encode(const vector<uint8_t>& data, ItsBase32Variant variant = ItsBase32Variant::Standard)
+		{
+			return ItsConvert::Base32Encode(data.data(), data.size(), variant);
+		}
+
+		static bool Base32Decode(const string& text, vector<uint8_t>& data, ItsBase32Variant variant = ItsBase32Variant::Standard)
+		{
+			data.resize(ItsBase32::DecodedMaxLength(text.size()));
+			size_t written = 0;
+			bool ok = ItsBase32::Decode(text.data(), text.size(), data.data(), &written, variant);
+			data.resize(ok ? written : 0);
+			return ok;
+		}
+	};
+
+	//
+	// struct: ItsSplitMix64
+	//
+	// (i): SplitMix64 generator. Used to expand a 64 bit seed into generator state.
+	//
+	struct ItsSplitMix64
+	{
+		using result_type = uint64_t;
+
+		uint64_t State{ 0 };
+
+		explicit ItsSplitMix64(uint64_t seed = 0)
+			: State(seed)
+		{
+		}
+
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return 0xFFFFFFFFFFFFFFFFull; }
+
+		result_type operator()()
+		{
+			uint64_t z = (this->State += 0x9E3779B97F4A7C15ull);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			return z ^ (z >> 31);
+		}
+	};
+
+	//
+	// struct: ItsXoshiro256
+	//
+	// (i): xoshiro256** generator. 32 bytes of state, period 2^256 - 1.
+	//      Jump advances 2^128 draws, LongJump 2^192 draws.
+	//
+	struct ItsXoshiro256
+	{
+		using result_type = uint64_t;
+
+		std::array<uint64_t, 4> State{};
+
+		explicit ItsXoshiro256(uint64_t seed = 0)
+		{
+			this->seed(seed);
+		}
+
+		void seed(uint64_t seed)
+		{
+			ItsSplitMix64 sm(seed);
+			for (auto& s : this->State) {
+				s = sm();
+			}
+		}
+
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return 0xFFFFFFFFFFFFFFFFull; }
+
+		result_type operator()()
+		{
+			auto& s = this->State;
+			const uint64_t result = std::rotl(s[1] * 5, 7) * 9;
+			const uint64_t t = s[1] << 17;
+			s[2] ^= s[0];
+			s[3] ^= s[1];
+			s[1] ^= s[2];
+			s[0] ^= s[3];
+			s[2] ^= t;
+			s[3] = std::rotl(s[3], 45);
+			return result;
+		}
+
+		void Jump()
+		{
+			static constexpr uint64_t jump[] = { 0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull };
+			this->Polynomial(jump);
+		}
+
+		void LongJump()
+		{
+			static constexpr uint64_t jump[] = { 0x76E15D3EFEFDCBBFull, 0xC5004E441C522FB3ull, 0x77710069854EE241ull, 0x39109BB02ACBE635ull };
+			this->Polynomial(jump);
+		}
+
+	private:
+		void Polynomial(const uint64_t(&jump)[4])
+		{
+			std::array<uint64_t, 4> acc{};
+			for (uint64_t word : jump) {
+				for (int b = 0; b < 64; b++) {
+					if (word & (1ull << b)) {
+						for (size_t i = 0; i < 4; i++) {
+							acc[i] ^= this->State[i];
+						}
+					}
+					(*this)();
+				}
+			}
+			this->State = acc;
+		}
+	};
+
+	//
+	// struct: ItsPCG64
+	//
+	// (i): PCG XSL RR 128/64 generator. 128 bit LCG state, period 2^128.
+	//      Advance skips any number of draws in O(log n); Jump is 2^64 draws, LongJump 2^96.
+	//
+	struct ItsPCG64
+	{
+		using result_type = uint64_t;
+
+		ItsUInt128 State{};
+		ItsUInt128 Increment{ 0x5851F42D4C957F2Dull, 0x14057B7EF767814Full };
+
+		explicit ItsPCG64(uint64_t seed = 0, uint64_t stream = 0)
+		{
+			this->seed(seed, stream);
+		}
+
+		void seed(uint64_t seed, uint64_t stream = 0)
+		{
+			ItsSplitMix64 sm(seed);
+			ItsUInt128 initial(sm(), sm());
+			if (stream != 0) {
+				ItsSplitMix64 ss(stream);
+				this->Increment = ItsUInt128(ss(), ss());
+			}
+			this->Increment.Low |= 1;
+			this->State = ItsUInt128();
+			this->Step();
+			this->State = this->State + initial;
+			this->Step();
+		}
+
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return 0xFFFFFFFFFFFFFFFFull; }
+
+		result_type operator()()
+		{
+			this->Step();
+			return std::rotr(this->State.High ^ this->State.Low, static_cast<int>(this->State.High >> 58));
+		}
+
+		void Advance(ItsUInt128 delta)
+		{
+			ItsUInt128 accMult(0, 1);
+			ItsUInt128 accPlus;
+			ItsUInt128 curMult = ItsPCG64::Multiplier();
+			ItsUInt128 curPlus = this->Increment;
+			while (!delta.IsZero()) {
+				if (delta.Low & 1) {
+					accMult = accMult * curMult;
+					accPlus = accPlus * curMult + curPlus;
+				}
+				curPlus = (curMult + ItsUInt128(0, 1)) * curPlus;
+				curMult = curMult * curMult;
+				delta = delta.ShiftRight1();
+			}
+			this->State = accMult * this->State + accPlus;
+		}
+
+		void Jump()
+		{
+			this->Advance(ItsUInt128(1, 0));
+		}
+
+		void LongJump()
+		{
+			this->Advance(ItsUInt128(1ull << 32, 0));
+		}
+
+	private:
+		static constexpr ItsUInt128 Multiplier()
+		{
+			return ItsUInt128(0x2360ED051FC65DA4ull, 0x4385DF649FCCF645ull);
+		}
+
+		void Step()
+		{
+			this->State = this->State * ItsPCG64::Multiplier() + this->Increment;
+		}
+	};
+
+	//
+	// struct: ItsWyRand
+	//
+	// (i): wyrand generator. 8 bytes of state, period 2^64.
+	//      Advance is O(1); Jump is 2^32 draws, LongJump 2^48.
+	//
+	struct ItsWyRand
+	{
+		using result_type = uint64_t;
+
+		uint64_t State{ 0 };
+
+		explicit ItsWyRand(uint64_t seed = 0)
+		{
+			this->seed(seed);
+		}
+
+		void seed(uint64_t seed)
+		{
+			this->State = ItsSplitMix64(seed)();
+		}
+
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return 0xFFFFFFFFFFFFFFFFull; }
+
+		result_type operator()()
+		{
+			this->State += ItsWyRand::Increment;
+			ItsUInt128 r = ItsUInt128::Multiply(this->State, this->State ^ 0xE7037ED1A0B428DBull);
+			return r.High ^ r.Low;
+		}
+
+		void Advance(uint64_t delta)
+		{
+			this->State += delta * ItsWyRand::Increment;
+		}
+
+		void Jump()
+		{
+			this->Advance(1ull << 32);
+		}
+
+		void LongJump()
+		{
+			this->Advance(1ull << 48);
+		}
+
+	private:
+		static constexpr uint64_t Increment = 0xA0761D6478BD642Full;
+	};
+
+	//
+	// Function: ItsRandomEngine
+	//
+	// (i): Per-thread generator shared by every ItsRandom instantiation using Generator.
+	//      Standard engines are seeded from a seed_seq, library engines from 64 bits.
+	//
+	template<typename Generator = std::mt19937>
+	Generator& ItsRandomEngine()
+	{
+		thread_local static Generator gen = []() {
+			std::random_device rd;
+			if constexpr (std::is_constructible_v<Generator, std::seed_seq&>) {
+				std::seed_seq seq{ rd(), rd(), rd(), rd(), rd(), rd(), rd(), rd() };
+				return Generator(seq);
+			}
+			else {
+				return Generator((static_cast<uint64_t>(rd()) << 32) | rd());
+			}
+		}();
+		return gen;
+	}
+
+	//
+	// struct: ItsRandomRange
+	//
+	// (i): Uniform integers in [from, to] using Lemire's multiply-shift reduction.
+	//      The rejection threshold is computed once so each draw is a multiply and a compare.
+	//      Generators that do not produce full 32 or 64 bit words (minstd_rand, ranlux24, ...)
+	//      go through std::uniform_int_distribution instead.
+	//
+	template<typename T, typename Generator = std::mt19937>
+	struct ItsRandomRange
+	{
+		static_assert(std::is_integral_v<T>, "ItsRandomRange requires an integral type");
+
+	private:
+		using U = std::make_unsigned_t<T>;
+		static constexpr bool Wide = Generator::max() == 0xFFFFFFFFFFFFFFFFull;
+		static constexpr bool FullWidth = Generator::min() == 0 && (Generator::max() == 0xFFFFFFFFull || Generator::max() == 0xFFFFFFFFFFFFFFFFull);
+
+		T m_from;
+		uint64_t m_span;
+		uint64_t m_threshold;
+
+	public:
+		ItsRandomRange(T from, T to)
+			: m_from(from), m_span(static_cast<uint64_t>(static_cast<U>(static_cast<U>(to) - static_cast<U>(from))) + 1), m_threshold(0)
+		{
+			if (this->m_span == 0) {
+				return;
+			}
+			if (!Wide && this->m_span <= 0xFFFFFFFFull) {
+				uint32_t s = static_cast<uint32_t>(this->m_span);
+				this->m_threshold = static_cast<uint32_t>(0 - s) % s;
+			}
+			else {
+				this->m_threshold = (0 - this->m_span) % this->m_span;
+			}
+		}
+
+		T From() const { return this->m_from; }
+		T To() const { return this->Offset(this->m_span - 1); }
+
+		T operator()()
+		{
+			return (*this)(ItsRandomEngine<Generator>());
+		}
+
+		T operator()(Generator& gen) const
+		{
+			if constexpr (!FullWidth) {
+				std::uniform_int_distribution<T> dist(this->m_from, this->To());
+				return dist(gen);
+			}
+			else {
+				if (this->m_span == 0) {
+					return this->Offset(ItsRandomRange::Draw64(gen));
+				}
+				if (!Wide && this->m_span <= 0xFFFFFFFFull) {
+					uint32_t s = static_cast<uint32_t>(this->m_span);
+					uint64_t m = static_cast<uint64_t>(static_cast<uint32_t>(gen())) * s;
+					while (static_cast<uint32_t>(m) < this->m_threshold) {
+						m = static_cast<uint64_t>(static_cast<uint32_t>(gen())) * s;
+					}
+					return this->Offset(m >> 32);
+				}
+				ItsUInt128 m = ItsUInt128::Multiply(ItsRandomRange::Draw64(gen), this->m_span);
+				while (m.Low < this->m_threshold) {
+					m = ItsUInt128::Multiply(ItsRandomRange::Draw64(gen), this->m_span);
+				}
+				return this->Offset(m.High);
+			}
+		}
+
+		//
+		// One-off draw; the threshold division only happens on the rare rejection path.
+		//
+		static T Next(Generator& gen, T from, T to)
+		{
+			if constexpr (!FullWidth) {
+				std::uniform_int_distribution<T> dist(from, to);
+				return dist(gen);
+			}
+			else {
+				uint64_t span = static_cast<uint64_t>(static_cast<U>(static_cast<U>(to) - static_cast<U>(from))) + 1;
+				if (span == 0) {
+					return static_cast<T>(static_cast<U>(static_cast<U>(from) + static_cast<U>(ItsRandomRange::Draw64(gen))));
+				}
+				uint64_t value = 0;
+				if (!Wide && span <= 0xFFFFFFFFull) {
+					uint32_t s = static_cast<uint32_t>(span);
+					uint64_t m = static_cast<uint64_t>(static_cast<uint32_t>(gen())) * s;
+					if (static_cast<uint32_t>(m) < s) {
+						uint32_t threshold = static_cast<uint32_t>(0 - s) % s;
+						while (static_cast<uint32_t>(m) < threshold) {
+							m = static_cast<uint64_t>(static_cast<uint32_t>(gen())) * s;
+						}
+					}
+					value = m >> 32;
+				}
+				else {
+					ItsUInt128 m = ItsUInt128::Multiply(ItsRandomRange::Draw64(gen), span);
+					if (m.Low < span) {
+						uint64_t threshold = (0 - span) % span;
+						while (m.Low < threshold) {
+							m = ItsUInt128::Multiply(ItsRandomRange::Draw64(gen), span);
+						}
+					}
+					value = m.High;
+				}
+				return static_cast<T>(static_cast<U>(static_cast<U>(from) + static_cast<U>(value)));
+			}
+		}
+
+	private:
+		T Offset(uint64_t value) const
+		{
+			return static_cast<T>(static_cast<U>(static_cast<U>(this->m_from) + static_cast<U>(value)));
+		}
+
+		static uint64_t Draw64(Generator& gen)
+		{
+			if constexpr (Wide) {
+				return static_cast<uint64_t>(gen());
+			}
+			else {
+				uint64_t high = static_cast<uint32_t>(gen());
+				return (high << 32) | static_cast<uint32_t>(gen());
+			}
+		}
+	};
+
+	//
+	// Function: ItsRandom
+	//
+	// (i): A random number wrapper.
+	//
+	template<typename Numeric, typename Generator = std::mt19937>
+	Numeric ItsRandom(Numeric from, Numeric to)
+	{
+		if constexpr (std::is_integral<Numeric>::value) {
+			return ItsRandomRange<Numeric, Generator>::Next(ItsRandomEngine<Generator>(), from, to);
+		}
+		else {
+			std::uniform_real_distribution<Numeric> dist{};
+			return dist(ItsRandomEngine<Generator>(), typename std::uniform_real_distribution<Numeric>::param_type{ from, to });
+		}
+	}
+
+	//
+	// struct: ItsPhilox4x32
+	//
+	// (i): Philox4x32-10 counter-based block function (Salmon et al.). Stateless:
+	//      the same key and counter always give the same four words.
+	//
+	struct ItsPhilox4x32
+	{
+		static std::array<uint32_t, 4> Block(std::array<uint32_t, 4> counter, std::array<uint32_t, 2> key)
+		{
+			for (int round = 0; round < 10; round++)
+			{
+				const uint64_t p0 = static_cast<uint64_t>(0xD2511F53u) * counter[0];
+				const uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u) * counter[2];
+				counter = {
+					static_cast<uint32_t>(p1 >> 32) ^ counter[1] ^ key[0],
+					static_cast<uint32_t>(p1),
+					static_cast<uint32_t>(p0 >> 32) ^ counter[3] ^ key[1],
+					static_cast<uint32_t>(p0)
+				};
+				key[0] += 0x9E3779B9u;
+				key[1] += 0xBB67AE85u;
+			}
+			return counter;
+		}
+	};
+
+	//
+	// struct: ItsRandomStream
+	//
+	// (i): Reproducible random stream identified by (seed, stream id). Draw n of a stream is
+	//      Philox(key = seed, counter = { n / 2, stream }), so streams never overlap and any
+	//      draw can be reached in O(1). Give each work item its own stream id and a parallel
+	//      run is bit-identical for any thread count.
+	//
+	struct ItsRandomStream
+	{
+		using result_type = uint64_t;
+
+	private:
+		uint64_t m_seed;
+		uint64_t m_stream;
+		uint64_t m_position{ 0 };
+		uint64_t m_block[2]{};
+
+	public:
+		explicit ItsRandomStream(uint64_t seed, uint64_t stream = 0)
+			: m_seed(seed), m_stream(stream)
+		{
+		}
+
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return 0xFFFFFFFFFFFFFFFFull; }
+
+		uint64_t Seed() const { return this->m_seed; }
+		uint64_t Stream() const { return this->m_stream; }
+		uint64_t Position() const { return this->m_position; }
+
+		//
+		// Independent child stream. Deterministic in (seed, this stream, id).
+		//
+		ItsRandomStream Child(uint64_t id) const
+		{
+			ItsSplitMix64 mix(this->m_stream ^ std::rotl(id, 32));
+			mix();
+			return ItsRandomStream(this->m_seed, mix() ^ id);
+		}
+
+		result_type operator()()
+		{
+			if ((this->m_position & 1) == 0) {
+				this->Generate(this->m_position >> 1);
+			}
+			return this->m_block[this->m_position++ & 1];
+		}
+
+		void Discard(uint64_t n)
+		{
+			this->m_position += n;
+			if (this->m_position & 1) {
+				this->Generate(this->m_position >> 1);
+			}
+		}
+
+		void Seek(uint64_t position)
+		{
+			this->m_position = 0;
+			this->Discard(position);
+		}
+
+		//
+		// Uniform value in [from, to] (integers) or [from, to) (floating point).
+		//
+		template<typename Numeric>
+		Numeric Next(Numeric from, Numeric to)
+		{
+			if constexpr (std::is_integral_v<Numeric>) {
+				return ItsRandomRange<Numeric, ItsRandomStream>::Next(*this, from, to);
+			}
+			else {
+				double unit = std::bit_cast<double>(((*this)() >> 12) | 0x3FF0000000000000ull) - 1.0;
+				return static_cast<Numeric>(from + static_cast<Numeric>(unit) * (to - from));
+			}
+		}
+
+	private:
+		void Generate(uint64_t block)
+		{
+			auto r = ItsPhilox4x32::Block(
+				{ static_cast<uint32_t>(block), static_cast<uint32_t>(block >> 32), static_cast<uint32_t>(this->m_stream), static_cast<uint32_t>(this->m_stream >> 32) },
+				{ static_cast<uint32_t>(this->m_seed), static_cast<uint32_t>(this->m_seed >> 32) });
+			this->m_block[0] = (static_cast<uint64_t>(r[1]) << 32) | r[0];
+			this->m_block[1] = (static_cast<uint64_t>(r[3]) << 32) | r[2];
+		}
+	};
+
+	//
+	// struct: ItsRandomLanes
+	//
+	// (i): Eight xoshiro256** streams, each a Jump() apart, stepped together for bulk output.
+	//      Word k comes from lane k % 8 on every code path, so a seed always gives the same bytes.
+	//
+	struct ItsRandomLanes
+	{
+		static constexpr size_t Lanes = 8;
+
+	private:
+		alignas(32) uint64_t m_state[4][Lanes];
+
+		void BlockScalar(uint64_t* out)
+		{
+			auto& s = this->m_state;
+			for (size_t l = 0; l < Lanes; l++)
+			{
+				out[l] = std::rotl(s[1][l] * 5, 7) * 9;
+				const uint64_t t = s[1][l] << 17;
+				s[2][l] ^= s[0][l];
+				s[3][l] ^= s[1][l];
+				s[1][l] ^= s[2][l];
+				s[0][l] ^= s[3][l];
+				s[2][l] ^= t;
+				s[3][l] = std::rotl(s[3][l], 45);
+			}
+		}
+
+#if defined(ITS_X86)
+		ITS_TARGET("avx2")
+		static inline __m256i Rotl(__m256i x, int k)
+		{
+			return _mm256_or_si256(_mm256_slli_epi64(x, k), _mm256_srli_epi64(x, 64 - k));
+		}
+
+		ITS_TARGET("avx2")
+		static inline __m256i Step(__m256i& s0, __m256i& s1, __m256i& s2, __m256i& s3)
+		{
+			// rotl(s1 * 5, 7) * 9 with shifts, AVX2 has no 64 bit multiply.
+			__m256i r = _mm256_add_epi64(_mm256_slli_epi64(s1, 2), s1);
+			r = Rotl(r, 7);
+			r = _mm256_add_epi64(_mm256_slli_epi64(r, 3), r);
+			const __m256i t = _mm256_slli_epi64(s1, 17);
+			s2 = _mm256_xor_si256(s2, s0);
+			s3 = _mm256_xor_si256(s3, s1);
+			s1 = _mm256_xor_si256(s1, s2);
+			s0 = _mm256_xor_si256(s0, s3);
+			s2 = _mm256_xor_si256(s2, t);
+			s3 = Rotl(s3, 45);
+			return r;
+		}
+
+		ITS_TARGET("avx2")
+		static size_t NextAVX2(uint64_t (&state)[4][Lanes], uint8_t* out, size_t blocks)
+		{
+			__m256i a0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(&state[0][0]));
+			__m256i a1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(&state[1][0]));
+			__m256i a2 = _mm256_load_si256(reinterpret_cast<const __m256i*>(&state[2][0]));
+			__m256i a3 = _mm256_load_si256(reinterpret_cast<const __m256i*>(&state[3][0]));
+			__m256i b0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(&state[0][4]));
+			__m256i b1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(&state[1][4]));
+			__m256i b2 = _mm256_load_si256(reinterpret_cast<const __m256i*>(&state[2][4]));
+			__m256i b3 = _mm256_load_si256(reinterpret_cast<const __m256i*>(&state[3][4]));
+			for (size_t i = 0; i < blocks; i++)
+			{
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 64), Step(a0, a1, a2, a3));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 64 + 32), Step(b0, b1, b2, b3));
+			}
+			_mm256_store_si256(reinterpret_cast<__m256i*>(&state[0][0]), a0);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(&state[1][0]), a1);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(&state[2][0]), a2);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(&state[3][0]), a3);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(&state[0][4]), b0);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(&state[1][4]), b1);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(&state[2][4]), b2);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(&state[3][4]), b3);
+			return blocks;
+		}
+#endif
+
+	public:
+		explicit ItsRandomLanes(uint64_t seed)
+		{
+			ItsXoshiro256 gen(seed);
+			for (size_t l = 0; l < Lanes; l++)
+			{
+				for (size_t i = 0; i < 4; i++) {
+					this->m_state[i][l] = gen.State[i];
+				}
+				gen.Jump();
+			}
+		}
+
+		//
+		// Writes bytes to out (any alignment). Consumes whole blocks of 8 words; a partial
+		// last block is truncated.
+		//
+		void Next(uint8_t* out, size_t bytes)
+		{
+			size_t blocks = bytes / (Lanes * 8);
+			size_t i = 0;
+#if defined(ITS_X86)
+			if (ItsCpu::HasAVX2()) {
+				i = ItsRandomLanes::NextAVX2(this->m_state, out, blocks);
+			}
+#endif
+			uint64_t block[Lanes];
+			for (; i < blocks; i++)
+			{
+				this->BlockScalar(block);
+				memcpy(out + i * Lanes * 8, block, sizeof(block));
+			}
+			size_t rest = bytes - blocks * Lanes * 8;
+			if (rest > 0)
+			{
+				this->BlockScalar(block);
+				memcpy(out + blocks * Lanes * 8, block, rest);
+			}
+		}
+	};
+
+	//
+	// Function: ItsRandomBytes
+	//
+	// (i): Fills data with random bytes. Pass a seed for reproducible output.
+	//
+	inline void ItsRandomBytes(std::span<std::byte> data, uint64_t seed)
+	{
+		ItsRandomLanes(seed).Next(reinterpret_cast<uint8_t*>(data.data()), data.size());
+	}
+
+	inline void ItsRandomBytes(std::span<std::byte> data)
+	{
+		ItsRandomBytes(data, ItsRandomEngine<ItsXoshiro256>()());
+	}
+
+	//
+	// Function: ItsRandomFill
+	//
+	// (i): Fills data with uniform values in [from, to] (integers and bool) or [from, to)
+	//      (floating point). Pass a seed for reproducible output.
+	//
+	template<typename T>
+	void ItsRandomFill(std::span<T> data, T from, T to, uint64_t seed)
+	{
+		static_assert(std::is_arithmetic_v<T>, "ItsRandomFill requires an arithmetic type");
+		ItsRandomLanes lanes(seed);
+		if (data.empty()) {
+			return;
+		}
+
+		if constexpr (std::is_same_v<T, double>)
+		{
+			// Words become doubles in place: 52 random mantissa bits under exponent 0 give [1, 2).
+			lanes.Next(reinterpret_cast<uint8_t*>(data.data()), data.size() * sizeof(double));
+			const double scale = to - from;
+			const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data.data());
+			for (size_t i = 0; i < data.size(); i++) {
+				uint64_t w = 0;
+				memcpy(&w, bytes + i * sizeof(w), sizeof(w));
+				data[i] = from + (std::bit_cast<double>((w >> 12) | 0x3FF0000000000000ull) - 1.0) * scale;
+			}
+		}
+		else if constexpr (std::is_same_v<T, float>)
+		{
+			lanes.Next(reinterpret_cast<uint8_t*>(data.data()), data.size() * sizeof(float));
+			const float scale = to - from;
+			const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data.data());
+			for (size_t i = 0; i < data.size(); i++) {
+				uint32_t w = 0;
+				memcpy(&w, bytes + i * sizeof(w), sizeof(w));
+				data[i] = from + (std::bit_cast<float>((w >> 9) | 0x3F800000u) - 1.0f) * scale;
+			}
+		}
+		else if constexpr (std::is_same_v<T, bool>)
+		{
+			// One random bit per value.
+			uint64_t buffer[512];
+			constexpr size_t bits = sizeof(buffer) * 8;
+			for (size_t i = 0; i < data.size(); i++)
+			{
+				if (from == to) {
+					data[i] = from;
+					continue;
+				}
+				if (i % bits == 0) {
+					lanes.Next(reinterpret_cast<uint8_t*>(buffer), sizeof(buffer));
+				}
+				data[i] = ((buffer[i % bits / 64] >> (i % 64)) & 1) != 0;
+			}
+		}
+		else if constexpr (std::is_floating_point_v<T>)
+		{
+			vector<double> buffer(data.size());
+			ItsRandomFill<double>(buffer, 0.0, 1.0, seed);
+			for (size_t i = 0; i < data.size(); i++) {
+				data[i] = from + static_cast<T>(buffer[i]) * (to - from);
+			}
+		}
+		else
+		{
+			using U = std::make_unsigned_t<T>;
+			const uint64_t span = static_cast<uint64_t>(static_cast<U>(static_cast<U>(to) - static_cast<U>(from))) + 1;
+			const U base = static_cast<U>(from);
+			auto offset = [base](uint64_t v) { return static_cast<T>(static_cast<U>(base + static_cast<U>(v))); };
+
+			uint64_t buffer[512];
+			size_t pos = sizeof(buffer);
+			uint8_t* bytes = reinterpret_cast<uint8_t*>(buffer);
+
+			if (span <= 0xFFFFFFFFull && span != 0)
+			{
+				// Two 32 bit draws per word, Lemire reduction with a precomputed threshold.
+				const uint32_t s = static_cast<uint32_t>(span);
+				const uint32_t threshold = static_cast<uint32_t>(0 - s) % s;
+				for (size_t i = 0; i < data.size(); i++)
+				{
+					uint64_t m = 0;
+					do
+					{
+						if (pos == sizeof(buffer)) {
+							lanes.Next(bytes, sizeof(buffer));
+							pos = 0;
+						}
+						uint32_t x = 0;
+						memcpy(&x, bytes + pos, sizeof(x));
+						pos += sizeof(x);
+						m = static_cast<uint64_t>(x) * s;
+					} while (static_cast<uint32_t>(m) < threshold);
+					data[i] = offset(m >> 32);
+				}
+			}
+			else
+			{
+				const uint64_t threshold = (span == 0) ? 0 : (0 - span) % span;
+				for (size_t i = 0; i < data.size(); i++)
+				{
+					ItsUInt128 m;
+					do
+					{
+						if (pos == sizeof(buffer)) {
+							lanes.Next(bytes, sizeof(buffer));
+							pos = 0;
+						}
+						uint64_t x = buffer[pos / 8];
+						pos += 8;
+						m = (span == 0) ? ItsUInt128(x, 0) : ItsUInt128::Multiply(x, span);
+					} while (m.Low < threshold);
+					data[i] = offset(m.High);
+				}
+			}
+		}
+	}
+
+	template<typename T>
+	void ItsRandomFill(std::span<T> data, T from, T to)
+	{
+		ItsRandomFill<T>(data, from, to, ItsRandomEngine<ItsXoshiro256>()());
+	}
+
+	//
+	// struct: ItsSecureRandom
+	//
+	// (i): Cryptographically secure random bytes from the operating system
+	//      (BCryptGenRandom on Windows, getrandom on Linux). Small requests are served from a
+	//      per-thread buffer so most calls make no system call. Used bytes are wiped from the
+	//      buffer, and a forked child never reuses its parent's buffer.
+	//
+	struct ItsSecureRandom
+	{
+	private:
+		static constexpr size_t BufferSize = 4096;
+
+		struct Buffer
+		{
+			std::array<uint8_t, BufferSize> Data{};
+			size_t Position{ BufferSize };
+			uint64_t Generation{ 0 };
+		};
+
+		static std::atomic<uint64_t>& ForkGeneration()
+		{
+			static std::atomic<uint64_t> generation{ 1 };
+#if !defined(_WIN32)
+			static bool registered = []() {
+				pthread_atfork(nullptr, nullptr, []() { ItsSecureRandom::ForkGeneration()++; });
+				return true;
+			}();
+			(void)registered;
+#endif
+			return generation;
+		}
+
+	public:
+		//
+		// Unbuffered read straight from the operating system.
+		//
+		static bool SystemRandom(void* data, size_t size)
+		{
+			uint8_t* p = static_cast<uint8_t*>(data);
+#if defined(_WIN32)
+			while (size > 0)
+			{
+				ULONG chunk = static_cast<ULONG>((size > 0x40000000) ? 0x40000000 : size);
+				if (!BCRYPT_SUCCESS(BCryptGenRandom(nullptr, p, chunk, BCRYPT_USE_SYSTEM_PREFERRED_RNG))) {
+					return false;
+				}
+				p += chunk;
+				size -= chunk;
+			}
+#else
+			while (size > 0)
+			{
+				ssize_t n = getrandom(p, size, 0);
+				if (n < 0) {
+					if (errno == EINTR) {
+						continue;
+					}
+					return false;
+				}
+				p += n;
+				size -= static_cast<size_t>(n);
+			}
+#endif
+			return true;
+		}
+
+		static bool Fill(void* data, size_t size)
+		{
+			if (size > BufferSize / 4) {
+				return ItsSecureRandom::SystemRandom(data, size);
+			}
+
+			thread_local static Buffer buffer;
+			uint64_t generation = ItsSecureRandom::ForkGeneration().load(std::memory_order_relaxed);
+			if (buffer.Generation != generation || buffer.Position + size > BufferSize)
+			{
+				if (!ItsSecureRandom::SystemRandom(buffer.Data.data(), BufferSize)) {
+					return false;
+				}
+				buffer.Position = 0;
+				buffer.Generation = generation;
+			}
+
+			memcpy(data, buffer.Data.data() + buffer.Position, size);
+			memset(buffer.Data.data() + buffer.Position, 0, size);
+			buffer.Position += size;
+			return true;
+		}
+
+		static bool Fill(std::span<std::byte> data)
+		{
+			return ItsSecureRandom::Fill(data.data(), data.size());
+		}
+	};
+
+	//
+	// Function: ItsRandomUnit
+	//
+	// (i): Uniform double in the open interval (0, 1) from 53 random bits.
+	//      Generators that do not produce full 32 or 64 bit words (minstd_rand, ranlux24, ...)
+	//      draw the 53 bits through ItsRandomRange.
+	//
+	template<typename Generator>
+	double ItsRandomUnit(Generator& gen)
+	{
+		uint64_t bits = 0;
+		if constexpr (Generator::min() == 0 && Generator::max() == 0xFFFFFFFFFFFFFFFFull) {
+			bits = static_cast<uint64_t>(gen()) >> 11;
+		}
+		else if constexpr (Generator::min() == 0 && Generator::max() == 0xFFFFFFFFull) {
+			bits = ((static_cast<uint64_t>(static_cast<uint32_t>(gen())) << 32) | static_cast<uint32_t>(gen())) >> 11;
+		}
+		else {
+			bits = ItsRandomRange<uint64_t, Generator>::Next(gen, 0, (1ull << 53) - 1);
+		}
+		return (static_cast<double>(bits) + 0.5) * (1.0 / 9007199254740992.0);
+	}
+
+	//
+	// class: ItsReservoirSampler
+	//
+	// (i): Uniform sample of k items from a stream of unknown length in one pass.
+	//      Algorithm L (Li, 1994): the gap to the next accepted item is drawn geometrically,
+	//      so random numbers are only drawn for items that enter the sample.
+	//
+	template<typename T, typename Generator = ItsXoshiro256>
+	class ItsReservoirSampler
+	{
+	private:
+		size_t m_k;
+		Generator m_gen;
+		vector<T> m_sample;
+		uint64_t m_seen{ 0 };
+		uint64_t m_next{ 0 };
+		double m_w{ 0.0 };
+
+		void Advance()
+		{
+			this->m_w *= std::exp(std::log(ItsRandomUnit(this->m_gen)) / static_cast<double>(this->m_k));
+			double gap = std::floor(std::log(ItsRandomUnit(this->m_gen)) / std::log1p(-this->m_w));
+			this->m_next = (gap < 9.0e18 && this->m_next + static_cast<uint64_t>(gap) < 0xFFFFFFFFFFFFFFF0ull)
+				? this->m_next + static_cast<uint64_t>(gap) + 1
+				: 0xFFFFFFFFFFFFFFFFull;
+		}
+
+		void Accept(T&& item)
+		{
+			if (this->m_seen < this->m_k)
+			{
+				this->m_sample.push_back(std::move(item));
+				if (++this->m_seen == this->m_k) {
+					this->m_w = 1.0;
+					this->m_next = this->m_k - 1;
+					this->Advance();
+				}
+				return;
+			}
+			if (this->m_seen++ == this->m_next)
+			{
+				this->m_sample[ItsRandomRange<size_t, Generator>::Next(this->m_gen, 0, this->m_k - 1)] = std::move(item);
+				this->Advance();
+			}
+		}
+
+	public:
+		explicit ItsReservoirSampler(size_t k)
+			: ItsReservoirSampler(k, ItsRandomEngine<ItsXoshiro256>()())
+		{
+		}
+
+		ItsReservoirSampler(size_t k, uint64_t seed)
+			: m_k(k), m_gen(static_cast<typename Generator::result_type>(seed))
+		{
+			this->m_sample.reserve(k);
+		}
+
+		void Add(const T& item)
+		{
+			if (this->m_k > 0 && (this->m_seen < this->m_k || this->m_seen == this->m_next)) {
+				this->Accept(T(item));
+			}
+			else {
+				this->m_seen++;
+			}
+		}
+
+		void Add(T&& item)
+		{
+			if (this->m_k > 0) {
+				this->Accept(std::move(item));
+			}
+			else {
+				this->m_seen++;
+			}
+		}
+
+		//
+		// Number of upcoming items that will not be sampled. Callers reading from a file
+		// may pass them over with Skip() instead of materialising them.
+		//
+		uint64_t ItemsToSkip() const
+		{
+			return (this->m_k == 0) ? 0xFFFFFFFFFFFFFFFFull : (this->m_seen < this->m_k) ? 0 : this->m_next - this->m_seen;
+		}
+
+		void Skip(uint64_t count)
+		{
+			uint64_t skip = this->ItemsToSkip();
+			this->m_seen += (count < skip) ? count : skip;
+		}
+
+		uint64_t Count() const { return this->m_seen; }
+		const vector<T>& Sample() const { return this->m_sample; }
+	};
+
+	//
+	// class: ItsWeightedReservoirSampler
+	//
+	// (i): Weighted sample of k items without replacement in one pass.
+	//      A-ExpJ (Efraimidis and Spirakis, 2006) with keys kept as log(u) / w.
+	//
+	template<typename T, typename Generator = ItsXoshiro256>
+	class ItsWeightedReservoirSampler
+	{
+	private:
+		using Entry = std::pair<double, T>;
+
+		size_t m_k;
+		Generator m_gen;
+		vector<Entry> m_heap;
+		double m_skipWeight{ 0.0 };
+		uint64_t m_seen{ 0 };
+
+		static bool Greater(const Entry& a, const Entry& b)
+		{
+			return a.first > b.first;
+		}
+
+		void NextJump()
+		{
+			this->m_skipWeight = std::log(ItsRandomUnit(this->m_gen)) / this->m_heap.front().first;
+		}
+
+	public:
+		explicit ItsWeightedReservoirSampler(size_t k)
+			: ItsWeightedReservoirSampler(k, ItsRandomEngine<ItsXoshiro256>()())
+		{
+		}
+
+		ItsWeightedReservoirSampler(size_t k, uint64_t seed)
+			: m_k(k), m_gen(static_cast<typename Generator::result_type>(seed))
+		{
+			this->m_heap.reserve(k);
+		}
+
+		//
+		// Items with weight <= 0 are never selected.
+		//
+		void Add(const T& item, double weight)
+		{
+			this->m_seen++;
+			if (this->m_k == 0 || !(weight > 0.0)) {
+				return;
+			}
+			if (this->m_heap.size() < this->m_k)
+			{
+				this->m_heap.emplace_back(std::log(ItsRandomUnit(this->m_gen)) / weight, item);
+				std::push_heap(this->m_heap.begin(), this->m_heap.end(), ItsWeightedReservoirSampler::Greater);
+				if (this->m_heap.size() == this->m_k) {
+					this->NextJump();
+				}
+				return;
+			}
+
+			this->m_skipWeight -= weight;
+			if (this->m_skipWeight > 0.0) {
+				return;
+			}
+
+			// New key is drawn conditioned on beating the current minimum.
+			double tw = std::exp(this->m_heap.front().first * weight);
+			double r = tw + ItsRandomUnit(this->m_gen) * (1.0 - tw);
+			std::pop_heap(this->m_heap.begin(), this->m_heap.end(), ItsWeightedReservoirSampler::Greater);
+			this->m_heap.back() = Entry(std::log(r) / weight, item);
+			std::push_heap(this->m_heap.begin(), this->m_heap.end(), ItsWeightedReservoirSampler::Greater);
+			this->NextJump();
+		}
+
+		uint64_t Count() const { return this->m_seen; }
+
+		vector<T> Sample() const
+		{
+			vector<T> sample;
+			sample.reserve(this->m_heap.size());
+			for (const auto& e : this->m_heap) {
+				sample.push_back(e.second);
+			}
+			return sample;
+		}
+	};
+
+	//
+	// Function: ItsShuffle
+	//
+	// (i): Fisher-Yates shuffle driven by a library generator.
+	//
+	template<typename T, std::uniform_random_bit_generator Generator>
+	void ItsShuffle(std::span<T> data, Generator& gen)
+	{
+		for (size_t i = data.size(); i > 1; i--) {
+			std::swap(data[i - 1], data[ItsRandomRange<size_t, Generator>::Next(gen, 0, i - 1)]);
+		}
+	}
+
+	//
+	// Function: ItsShuffle
+	//
+	// (i): Blocked parallel shuffle for large arrays. Elements are scattered into random
+	//      cache-sized buckets and each bucket is Fisher-Yates shuffled, which gives a uniform
+	//      permutation. Chunks and buckets use their own ItsRandomStream, so the result
+	//      depends only on seed and not on the thread count. T must be default constructible.
+	//
+	template<typename T>
+	void ItsShuffle(std::span<T> data, uint64_t seed, size_t threads = std::thread::hardware_concurrency())
+	{
+		const size_t chunkSize = 1 << 16;
+		const size_t n = data.size();
+		if (n <= chunkSize * 4)
+		{
+			ItsRandomStream stream(seed);
+			ItsShuffle(data, stream);
+			return;
+		}
+
+		const size_t bucketBits = std::min<size_t>(10, std::bit_width(n / chunkSize));
+		const size_t buckets = size_t{ 1 } << bucketBits;
+		const size_t chunks = (n + chunkSize - 1) / chunkSize;
+		threads = std::max<size_t>(1, std::min(threads, chunks));
+
+		vector<uint16_t> bucketOf(n);
+		vector<size_t> counts(chunks * buckets);
+		auto parallel = [threads](size_t jobs, auto&& job) {
+			vector<std::thread> workers;
+			for (size_t t = 1; t < threads; t++) {
+				workers.emplace_back([&job, jobs, t, threads]() {
+					for (size_t j = t; j < jobs; j += threads) {
+						job(j);
+					}
+				});
+			}
+			for (size_t j = 0; j < jobs; j += threads) {
+				job(j);
+			}
+			for (auto& w : workers) {
+				w.join();
+			}
+		};
+
+		// Pass 1: random bucket per element, counted per chunk.
+		parallel(chunks, [&](size_t c) {
+			ItsRandomStream stream(seed, c);
+			size_t end = std::min(n, (c + 1) * chunkSize);
+			size_t* count = counts.data() + c * buckets;
+			uint64_t word = 0;
+			for (size_t i = c * chunkSize, k = 0; i < end; i++, k++)
+			{
+				if (k % 4 == 0) {
+					word = stream();
+				}
+				uint16_t b = static_cast<uint16_t>((word >> ((k % 4) * 16)) & (buckets - 1));
+				bucketOf[i] = b;
+				count[b]++;
+			}
+		});
+
+		// Bucket-major prefix sums: offsets[c][b] is where chunk c writes into bucket b.
+		vector<size_t> bucketStart(buckets + 1);
+		size_t offset = 0;
+		for (size_t b = 0; b < buckets; b++)
+		{
+			bucketStart[b] = offset;
+			for (size_t c = 0; c < chunks; c++)
+			{
+				size_t count = counts[c * buckets + b];
+				counts[c * buckets + b] = offset;
+				offset += count;
+			}
+		}
+		bucketStart[buckets] = n;
+
+		// Pass 2: scatter.
+		vector<T> scattered(n);
+		parallel(chunks, [&](size_t c) {
+			size_t end = std::min(n, (c + 1) * chunkSize);
+			size_t* next = counts.data() + c * buckets;
+			for (size_t i = c * chunkSize; i < end; i++) {
+				scattered[next[bucketOf[i]]++] = std::move(data[i]);
+			}
+		});
+
+		// Pass 3: shuffle each bucket and move it back.
+		parallel(buckets, [&](size_t b) {
+			ItsRandomStream stream(seed, chunks + b);
+			std::span<T> bucket(scattered.data() + bucketStart[b], bucketStart[b + 1] - bucketStart[b]);
+			ItsShuffle(bucket, stream);
+			std::move(bucket.begin(), bucket.end(), data.begin() + bucketStart[b]);
+		});
+	}
+
+	template<typename T>
+	void ItsShuffle(std::span<T> data)
+	{
+		ItsShuffle(data, ItsRandomEngine<ItsXoshiro256>()());
+	}
+
+	//
+	// struct: ItsTsc
+	//
+	// (i): Raw CPU cycle counter (rdtsc on x86, cntvct_el0 on ARM64) and its conversion
+	//      to nanoseconds. The rate is calibrated once against steady_clock (about 10 ms
+	//      on first use).
+	//
+	struct ItsTsc
+	{
+	private:
+		static uint64_t SteadyNanoseconds()
+		{
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+
+		//
+		// Nanoseconds per tick in 32.32 fixed point.
+		//
+		static uint64_t Calibrate()
+		{
+			if (!ItsTsc::IsAvailable()) {
+				return 1ull << 32;
+			}
+
+			uint64_t ns0 = ItsTsc::SteadyNanoseconds();
+			uint64_t tick0 = ItsTsc::Read();
+			uint64_t ns1 = ns0;
+			uint64_t tick1 = tick0;
+			while (ns1 - ns0 < 10'000'000)
+			{
+				ns1 = ItsTsc::SteadyNanoseconds();
+				tick1 = ItsTsc::Read();
+			}
+
+			if (tick1 == tick0) {
+				return 1ull << 32;
+			}
+			return static_cast<uint64_t>(static_cast<double>(ns1 - ns0) / static_cast<double>(tick1 - tick0) * 4294967296.0 + 0.5);
+		}
+
+		static uint64_t Scale()
+		{
+			static const uint64_t scale = ItsTsc::Calibrate();
+			return scale;
+		}
+
+	public:
+		//
+		// True when the counter ticks at a constant rate and can be used for timing.
+		//
+		static bool IsAvailable()
+		{
+#if defined(ITS_X86)
+			return ItsCpu::HasInvariantTSC();
+#elif defined(_M_ARM64) || defined(__aarch64__)
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		//
+		// Current counter value. Falls back to steady_clock nanoseconds when there is no usable
+		// counter, so ToNanoseconds always converts correctly.
+		//
+		static uint64_t Read()
+		{
+#if defined(ITS_X86)
+			static const bool available = ItsTsc::IsAvailable();
+			return available ? __rdtsc() : ItsTsc::SteadyNanoseconds();
+#elif defined(_M_ARM64)
+			return static_cast<uint64_t>(_ReadStatusReg(ARM64_CNTVCT));
+#elif defined(__aarch64__)
+			uint64_t value = 0;
+			__asm__ volatile("mrs %0, cntvct_el0" : "=r"(value));
+			return value;
+#else
+			return ItsTsc::SteadyNanoseconds();
+#endif
+		}
+
+		static double NanosecondsPerTick()
+		{
+			return static_cast<double>(ItsTsc::Scale()) / 4294967296.0;
+		}
+
+		static uint64_t ToNanoseconds(uint64_t ticks)
+		{
+			ItsUInt128 r = ItsUInt128::Multiply(ticks, ItsTsc::Scale());
+			return (r.High << 32) | (r.Low >> 32);
+		}
+	};
+
+	//
+	// enum: ItsPerfCounter
+	//
+	// (i): Hardware and software event counters read by ItsPerfCounters.
+	//
+	enum class ItsPerfCounter
+	{
+		Cycles,
+		Instructions,
+		CacheMisses,
+		BranchMisses,
+		PageFaults
+	};
+
+	//
+	// struct: ItsPerfCounterValues
+	//
+	// (i): One reading of the counter group. Counters that could not be opened are
+	//      marked unavailable and read as 0.
+	//
+	struct ItsPerfCounterValues
+	{
+		static constexpr size_t Count = 5;
+
+		std::array<uint64_t, Count> Values{};
+		std::array<bool, Count> Available{};
+
+		uint64_t operator[](ItsPerfCounter counter) const
+		{
+			return this->Values[static_cast<size_t>(counter)];
+		}
+
+		bool Has(ItsPerfCounter counter) const
+		{
+			return this->Available[static_cast<size_t>(counter)];
+		}
+
+		bool Any() const
+		{
+			return std::find(this->Available.begin(), this->Available.end(), true) != this->Available.end();
+		}
+
+		//
+		// Instructions per cycle, 0 when either counter is unavailable.
+		//
+		double IPC() const
+		{
+			if (!this->Has(ItsPerfCounter::Cycles) || !this->Has(ItsPerfCounter::Instructions) || (*this)[ItsPerfCounter::Cycles] == 0) {
+				return 0.0;
+			}
+			return static_cast<double>((*this)[ItsPerfCounter::Instructions]) / static_cast<double>((*this)[ItsPerfCounter::Cycles]);
+		}
+
+		ItsPerfCounterValues& operator+=(const ItsPerfCounterValues& other)
+		{
+			for (size_t i = 0; i < Count; i++)
+			{
+				this->Values[i] += other.Values[i];
+				this->Available[i] = this->Available[i] || other.Available[i];
+			}
+			return *this;
+		}
+	};
+
+	//
+	// struct: ItsPerfCounters
+	//
+	// (i): Cycles, instructions, cache misses, branch misses and page faults of the calling
+	//      thread, counted in user mode through perf_event_open on Linux. Counters the
+	//      kernel refuses (no PMU in a VM, perf_event_paranoid, other platforms) are simply
+	//      unavailable. Values are scaled when the kernel multiplexes the counters.
+	//
+	struct ItsPerfCounters
+	{
+	private:
+		std::array<int, ItsPerfCounterValues::Count> m_fds;
+		int m_leader = -1;
+
+#if defined(__linux__)
+		static int Open(uint32_t type, uint64_t config, int leader)
+		{
+			perf_event_attr attr{};
+			attr.size = sizeof(attr);
+			attr.type = type;
+			attr.config = config;
+			attr.disabled = (leader == -1) ? 1 : 0;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+			return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0));
+		}
+#endif
+
+		void Control([[maybe_unused]] unsigned long request)
+		{
+#if defined(__linux__)
+			if (this->m_leader != -1) {
+				ioctl(this->m_leader, request, PERF_IOC_FLAG_GROUP);
+			}
+#endif
+		}
+
+	public:
+		ItsPerfCounters()
+		{
+			this->m_fds.fill(-1);
+#if defined(__linux__)
+			const std::array<std::pair<uint32_t, uint64_t>, ItsPerfCounterValues::Count> events{ {
+				{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+				{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+				{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+				{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+				{ PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS }
+			} };
+			for (size_t i = 0; i < events.size(); i++)
+			{
+				this->m_fds[i] = ItsPerfCounters::Open(events[i].first, events[i].second, this->m_leader);
+				if (this->m_leader == -1) {
+					this->m_leader = this->m_fds[i];
+				}
+			}
+#endif
+		}
+
+		ItsPerfCounters(const ItsPerfCounters&) = delete;
+		ItsPerfCounters& operator=(const ItsPerfCounters&) = delete;
+
+		~ItsPerfCounters()
+		{
+#if defined(__linux__)
+			for (int fd : this->m_fds)
+			{
+				if (fd != -1) {
+					close(fd);
+				}
+			}
+#endif
+		}
+
+		bool IsAvailable() const
+		{
+			return this->m_leader != -1;
+		}
+
+		bool IsAvailable(ItsPerfCounter counter) const
+		{
+			return this->m_fds[static_cast<size_t>(counter)] != -1;
+		}
+
+		//
+		// Zeroes the counters and starts counting.
+		//
+		void Start()
+		{
+#if defined(__linux__)
+			this->Control(PERF_EVENT_IOC_RESET);
+			this->Control(PERF_EVENT_IOC_ENABLE);
+#endif
+		}
+
+		void Stop()
+		{
+#if defined(__linux__)
+			this->Control(PERF_EVENT_IOC_DISABLE);
+#endif
+		}
+
+		void Resume()
+		{
+#if defined(__linux__)
+			this->Control(PERF_EVENT_IOC_ENABLE);
+#endif
+		}
+
+		ItsPerfCounterValues Read() const
+		{
+			ItsPerfCounterValues result;
+#if defined(__linux__)
+			if (this->m_leader == -1) {
+				return result;
+			}
+
+			// nr, time_enabled, time_running, value[nr] in open order.
+			std::array<uint64_t, 3 + ItsPerfCounterValues::Count> data{};
+			if (read(this->m_leader, data.data(), sizeof(data)) < static_cast<ssize_t>(3 * sizeof(uint64_t))) {
+				return result;
+			}
+
+			double scale = (data[2] != 0 && data[2] < data[1]) ? static_cast<double>(data[1]) / static_cast<double>(data[2]) : 1.0;
+			size_t value = 3;
+			for (size_t i = 0; i < ItsPerfCounterValues::Count && value < 3 + data[0]; i++)
+			{
+				if (this->m_fds[i] != -1)
+				{
+					result.Values[i] = static_cast<uint64_t>(static_cast<double>(data[value++]) * scale);
+					result.Available[i] = true;
+				}
+			}
+#endif
+			return result;
+		}
+	};
+
+	//
+	// enum: ItsTimerMode
+	//
+	// (i): Clock used by ItsTimer. Tsc reads the cycle counter directly (about 10 ns per
+	//      read) and falls back to Steady on CPUs without a constant rate counter.
+	//
+	enum class ItsTimerMode
+	{
+		Steady,
+		Tsc
+	};
+
+	//
+	// struct: ItsTimer
+	//
+	// (i): Stopwatch on a monotonic nanosecond clock. Pause/Resume exclude intervals
+	//      from the measured time. Lap* reads a running timer, Get* a stopped one.
+	//
+	struct ItsTimer
+	{
+	private:
+		ItsTimerMode m_mode;
+		ItsPerfCounters* m_counters = nullptr;
+		uint64_t m_start = 0;
+		uint64_t m_elapsed = 0;
+		bool m_isRunning = false;
+		bool m_isPaused = false;
+
+		uint64_t Now() const
+		{
+			if (this->m_mode == ItsTimerMode::Tsc) {
+				return ItsTsc::Read();
+			}
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+
+		std::chrono::nanoseconds ToDuration(uint64_t ticks) const
+		{
+			if (this->m_mode == ItsTimerMode::Tsc) {
+				ticks = ItsTsc::ToNanoseconds(ticks);
+			}
+			return std::chrono::nanoseconds(static_cast<int64_t>(ticks));
+		}
+
+		uint64_t ElapsedTicks() const
+		{
+			if (this->m_isRunning && !this->m_isPaused) {
+				return this->m_elapsed + (this->Now() - this->m_start);
+			}
+			return this->m_elapsed;
+		}
+
+	public:
+		ItsTimer()
+			: m_mode(ItsTimerMode::Steady)
+		{
+		}
+
+		//
+		// counters (optional) count only while the timer runs and is not paused.
+		//
+		explicit ItsTimer(ItsTimerMode mode, ItsPerfCounters* counters = nullptr)
+			: m_mode((mode == ItsTimerMode::Tsc && !ItsTsc::IsAvailable()) ? ItsTimerMode::Steady : mode),
+			m_counters(counters)
+		{
+			if (this->m_mode == ItsTimerMode::Tsc) {
+				ItsTsc::NanosecondsPerTick();
+			}
+		}
+
+		ItsTimerMode Mode() const
+		{
+			return this->m_mode;
+		}
+
+		void Start()
+		{
+			if (!this->IsRunning())
+			{
+				this->m_elapsed = 0;
+				this->m_isPaused = false;
+				this->m_isRunning = true;
+				if (this->m_counters != nullptr) {
+					this->m_counters->Start();
+				}
+				this->m_start = this->Now();
+			}
+		}
+
+		void Stop()
+		{
+			if (this->IsRunning())
+			{
+				this->m_elapsed = this->ElapsedTicks();
+				if (this->m_counters != nullptr && !this->m_isPaused) {
+					this->m_counters->Stop();
+				}
+				this->m_isRunning = false;
+				this->m_isPaused = false;
+			}
+		}
+
+		void Pause()
+		{
+			if (this->IsRunning() && !this->IsPaused())
+			{
+				this->m_elapsed = this->ElapsedTicks();
+				if (this->m_counters != nullptr) {
+					this->m_counters->Stop();
+				}
+				this->m_isPaused = true;
+			}
+		}
+
+		void Resume()
+		{
+			if (this->IsRunning() && this->IsPaused())
+			{
+				this->m_isPaused = false;
+				if (this->m_counters != nullptr) {
+					this->m_counters->Resume();
+				}
+				this->m_start = this->Now();
+			}
+		}
+
+		bool IsRunning() const
+		{
+			return this->m_isRunning;
+		}
+
+		bool IsPaused() const
+		{
+			return this->m_isPaused;
+		}
+
+		//
+		// Counter values since Start. Empty when no counters are attached.
+		//
+		ItsPerfCounterValues Counters() const
+		{
+			if (this->m_counters == nullptr) {
+				return ItsPerfCounterValues();
+			}
+			return this->m_counters->Read();
+		}
+
+		//
+		// Time so far, excluding paused intervals. Zero when not running.
+		//
+		std::chrono::nanoseconds Lap() const
+		{
+			if (!this->IsRunning()) {
+				return std::chrono::nanoseconds::zero();
+			}
+			return this->ToDuration(this->ElapsedTicks());
+		}
+
+		std::chrono::seconds LapSeconds() const
+		{
+			return std::chrono::duration_cast<std::chrono::seconds>(this->Lap());
+		}
+
+		std::chrono::milliseconds LapMilliseconds() const
+		{
+			return std::chrono::duration_cast<std::chrono::milliseconds>(this->Lap());
+		}
+
+		std::chrono::microseconds LapMicroseconds() const
+		{
+			return std::chrono::duration_cast<std::chrono::microseconds>(this->Lap());
+		}
+
+		std::chrono::nanoseconds LapNanoseconds() const
+		{
+			return this->Lap();
+		}
+
+		//
+		// Raw clock ticks: nanoseconds in Steady mode, counter ticks in Tsc mode.
+		//
+		uint64_t LapTicks() const
+		{
+			if (!this->IsRunning()) {
+				return 0;
+			}
+			return this->ElapsedTicks();
+		}
+
+		//
+		// Measured time of a stopped timer. Zero while running.
+		//
+		std::chrono::nanoseconds Get() const
+		{
+			if (this->IsRunning()) {
+				return std::chrono::nanoseconds::zero();
+			}
+			return this->ToDuration(this->m_elapsed);
+		}
+
+		std::chrono::seconds GetSeconds() const
+		{
+			return std::chrono::duration_cast<std::chrono::seconds>(this->Get());
+		}
+
+		std::chrono::milliseconds GetMilliseconds() const
+		{
+			return std::chrono::duration_cast<std::chrono::milliseconds>(this->Get());
+		}
+
+		std::chrono::microseconds GetMicroseconds() const
+		{
+			return std::chrono::duration_cast<std::chrono::microseconds>(this->Get());
+		}
+
+		std::chrono::nanoseconds GetNanoseconds() const
+		{
+			return this->Get();
+		}
+
+		uint64_t GetTicks() const
+		{
+			if (this->IsRunning()) {
+				return 0;
+			}
+			return this->m_elapsed;
+		}
+
+		//
+		// Records the current lap into a histogram (ItsHistogram or ItsConcurrentHistogram)
+		// and starts the next lap. Does nothing when not running.
+		//
+		template<typename Histogram>
+		void Record(Histogram& histogram)
+		{
+			if (!this->IsRunning()) {
+				return;
+			}
+
+			uint64_t ticks = this->m_elapsed;
+			if (!this->IsPaused())
+			{
+				uint64_t now = this->Now();
+				ticks += now - this->m_start;
+				this->m_start = now;
+			}
+			this->m_elapsed = 0;
+			histogram.Record(this->ToDuration(ticks));
+		}
+	};
+
+	//
+	// struct: ItsHistogram
+	//
+	// (i): HdrHistogram style latency histogram. Values are counted in log-linear buckets
+	//      that keep the given number of significant decimal digits, so memory is fixed and
+	//      Record is O(1). Values above the highest trackable value are clamped.
+	//      Not thread safe; see ItsConcurrentHistogram.
+	//
+	struct ItsHistogram
+	{
+		friend struct ItsConcurrentHistogram;
+	private:
+		uint64_t m_highestTrackable;
+		int m_significantDigits;
+		int m_subBucketHalfCountMagnitude;
+		uint64_t m_subBucketHalfCount;
+		uint64_t m_subBucketMask;
+		int m_leadingZeroCountBase;
+		vector<uint64_t> m_counts;
+		uint64_t m_totalCount = 0;
+		uint64_t m_min = UINT64_MAX;
+		uint64_t m_max = 0;
+
+		size_t IndexOf(uint64_t value) const
+		{
+			if (value > this->m_highestTrackable) {
+				value = this->m_highestTrackable;
+			}
+			int bucket = this->m_leadingZeroCountBase - std::countl_zero(value | this->m_subBucketMask);
+			uint64_t subBucket = value >> bucket;
+			return static_cast<size_t>((static_cast<uint64_t>(bucket + 1) << this->m_subBucketHalfCountMagnitude) + (subBucket - this->m_subBucketHalfCount));
+		}
+
+		uint64_t LowestValueAt(size_t index) const
+		{
+			int bucket = static_cast<int>(index >> this->m_subBucketHalfCountMagnitude) - 1;
+			uint64_t subBucket = (index & (this->m_subBucketHalfCount - 1)) + this->m_subBucketHalfCount;
+			if (bucket < 0) {
+				subBucket -= this->m_subBucketHalfCount;
+				bucket = 0;
+			}
+			return subBucket << bucket;
+		}
+
+		uint64_t HighestValueAt(size_t index) const
+		{
+			int bucket = static_cast<int>(index >> this->m_subBucketHalfCountMagnitude) - 1;
+			if (bucket < 0) {
+				bucket = 0;
+			}
+			return this->LowestValueAt(index) + (1ull << bucket) - 1;
+		}
+
+		bool SameLayout(const ItsHistogram& other) const
+		{
+			return this->m_highestTrackable == other.m_highestTrackable && this->m_significantDigits == other.m_significantDigits;
+		}
+
+		//
+		// Min/Max from the buckets, used when exact values are not known.
+		//
+		void RangeFromCounts()
+		{
+			this->m_min = UINT64_MAX;
+			this->m_max = 0;
+			for (size_t i = 0; i < this->m_counts.size(); i++)
+			{
+				if (this->m_counts[i] != 0)
+				{
+					if (this->m_min == UINT64_MAX) {
+						this->m_min = this->LowestValueAt(i);
+					}
+					this->m_max = this->HighestValueAt(i);
+				}
+			}
+		}
+
+	public:
+		//
+		// Defaults to nanoseconds up to one hour with 3 significant digits (about 270 KB).
+		//
+		explicit ItsHistogram(uint64_t highestTrackable = 3'600'000'000'000, int significantDigits = 3)
+		{
+			if (significantDigits < 1 || significantDigits > 5) {
+				throw std::invalid_argument("ItsHistogram: significantDigits must be 1 to 5");
+			}
+			if (highestTrackable < 2) {
+				throw std::invalid_argument("ItsHistogram: highestTrackable must be at least 2");
+			}
+
+			this->m_highestTrackable = highestTrackable;
+			this->m_significantDigits = significantDigits;
+
+			uint64_t largestWithSingleUnitResolution = 2;
+			for (int i = 0; i < significantDigits; i++) {
+				largestWithSingleUnitResolution *= 10;
+			}
+			int subBucketCountMagnitude = std::bit_width(largestWithSingleUnitResolution - 1);
+			this->m_subBucketHalfCountMagnitude = subBucketCountMagnitude - 1;
+			this->m_subBucketHalfCount = 1ull << this->m_subBucketHalfCountMagnitude;
+			this->m_subBucketMask = (1ull << subBucketCountMagnitude) - 1;
+			this->m_leadingZeroCountBase = 64 - this->m_subBucketHalfCountMagnitude - 1;
+
+			uint64_t smallestUntrackable = 1ull << subBucketCountMagnitude;
+			size_t bucketCount = 1;
+			while (smallestUntrackable <= highestTrackable && bucketCount < static_cast<size_t>(64 - this->m_subBucketHalfCountMagnitude))
+			{
+				smallestUntrackable <<= 1;
+				bucketCount++;
+			}
+			this->m_counts.assign((bucketCount + 1) * this->m_subBucketHalfCount, 0);
+		}
+
+		void Record(uint64_t value, uint64_t count = 1)
+		{
+			this->m_counts[this->IndexOf(value)] += count;
+			this->m_totalCount += count;
+			if (value < this->m_min) {
+				this->m_min = value;
+			}
+			if (value > this->m_max) {
+				this->m_max = value;
+			}
+		}
+
+		void Record(std::chrono::nanoseconds value)
+		{
+			this->Record(static_cast<uint64_t>((value.count() < 0) ? 0 : value.count()));
+		}
+
+		//
+		// Adds the counts of another histogram. Histograms with a different layout are
+		// re-recorded bucket by bucket.
+		//
+		void Merge(const ItsHistogram& other)
+		{
+			if (other.m_totalCount == 0) {
+				return;
+			}
+
+			if (this->SameLayout(other))
+			{
+				for (size_t i = 0; i < this->m_counts.size(); i++) {
+					this->m_counts[i] += other.m_counts[i];
+				}
+				this->m_totalCount += other.m_totalCount;
+			}
+			else
+			{
+				for (size_t i = 0; i < other.m_counts.size(); i++)
+				{
+					if (other.m_counts[i] != 0) {
+						this->m_counts[this->IndexOf(other.LowestValueAt(i))] += other.m_counts[i];
+						this->m_totalCount += other.m_counts[i];
+					}
+				}
+			}
+			this->m_min = (std::min)(this->m_min, other.m_min);
+			this->m_max = (std::max)(this->m_max, other.m_max);
+		}
+
+		void Reset()
+		{
+			std::fill(this->m_counts.begin(), this->m_counts.end(), 0);
+			this->m_totalCount = 0;
+			this->m_min = UINT64_MAX;
+			this->m_max = 0;
+		}
+
+		uint64_t TotalCount() const
+		{
+			return this->m_totalCount;
+		}
+
+		uint64_t Min() const
+		{
+			return (this->m_totalCount == 0) ? 0 : this->m_min;
+		}
+
+		uint64_t Max() const
+		{
+			return this->m_max;
+		}
+
+		double Mean() const
+		{
+			if (this->m_totalCount == 0) {
+				return 0.0;
+			}
+
+			double sum = 0.0;
+			for (size_t i = 0; i < this->m_counts.size(); i++)
+			{
+				if (this->m_counts[i] != 0) {
+					double middle = (static_cast<double>(this->LowestValueAt(i)) + static_cast<double>(this->HighestValueAt(i))) / 2.0;
+					sum += middle * static_cast<double>(this->m_counts[i]);
+				}
+			}
+			return sum / static_cast<double>(this->m_totalCount);
+		}
+
+		//
+		// Highest value such that the given percent (0-100) of all values are at or below it,
+		// within the histogram's precision.
+		//
+		uint64_t ValueAtPercentile(double percentile) const
+		{
+			if (this->m_totalCount == 0) {
+				return 0;
+			}
+
+			percentile = (std::min)((std::max)(percentile, 0.0), 100.0);
+			uint64_t target = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(this->m_totalCount)));
+			if (target == 0) {
+				target = 1;
+			}
+
+			uint64_t cumulative = 0;
+			for (size_t i = 0; i < this->m_counts.size(); i++)
+			{
+				cumulative += this->m_counts[i];
+				if (cumulative >= target) {
+					return (std::min)(this->HighestValueAt(i), this->m_max);
+				}
+			}
+			return this->m_max;
+		}
+
+		uint64_t P50() const
+		{
+			return this->ValueAtPercentile(50.0);
+		}
+
+		uint64_t P90() const
+		{
+			return this->ValueAtPercentile(90.0);
+		}
+
+		uint64_t P99() const
+		{
+			return this->ValueAtPercentile(99.0);
+		}
+
+		uint64_t P999() const
+		{
+			return this->ValueAtPercentile(99.9);
+		}
+
+		//
+		// One line summary: count, min, mean, p50, p90, p99, p99.9 and max.
+		//
+		wstring ToString() const
+		{
+			wstringstream ss;
+			ss << L"count=" << this->TotalCount();
+			ss << L" min=" << this->Min();
+			ss << L" mean=" << std::fixed << std::setprecision(1) << this->Mean();
+			ss << L" p50=" << this->P50();
+			ss << L" p90=" << this->P90();
+			ss << L" p99=" << this->P99();
+			ss << L" p99.9=" << this->P999();
+			ss << L" max=" << this->Max();
+			return ss.str();
+		}
+
+		//
+		// Percentile distribution, one row per non-empty bucket:
+		// Value,Count,TotalCount,Percentile
+		//
+		wstring ToCsv() const
+		{
+			wstringstream ss;
+			ss << L"Value,Count,TotalCount,Percentile" << endl;
+
+			uint64_t cumulative = 0;
+			for (size_t i = 0; i < this->m_counts.size(); i++)
+			{
+				if (this->m_counts[i] != 0)
+				{
+					cumulative += this->m_counts[i];
+					ss << (std::min)(this->HighestValueAt(i), this->m_max) << L"," << this->m_counts[i] << L"," << cumulative << L",";
+					ss << std::fixed << std::setprecision(6) << static_cast<double>(cumulative) * 100.0 / static_cast<double>(this->m_totalCount) << endl;
+				}
+			}
+			return ss.str();
+		}
+	};
+
+	//
+	// struct: ItsConcurrentHistogram
+	//
+	// (i): ItsHistogram recorded from many threads. Each thread writes its own shard with
+	//      plain relaxed stores, so Record takes no lock and no locked instruction.
+	//      Snapshot merges all shards; Interval returns what was recorded since the
+	//      previous Interval call.
+	//
+	struct ItsConcurrentHistogram
+	{
+	private:
+		struct Shard
+		{
+			std::unique_ptr<std::atomic<uint64_t>[]> Counts;
+			std::atomic<uint64_t> TotalCount{ 0 };
+			std::atomic<uint64_t> Min{ UINT64_MAX };
+			std::atomic<uint64_t> Max{ 0 };
+			std::thread::id Owner;
+			Shard* Next{ nullptr };
+		};
+
+		struct CacheEntry
+		{
+			uint64_t Id{ 0 };
+			Shard* Value{ nullptr };
+		};
+
+		static constexpr size_t CacheSize = 8;
+
+		ItsHistogram m_layout;
+		uint64_t m_id;
+		std::atomic<Shard*> m_shards{ nullptr };
+		ItsHistogram m_previous;
+
+		static uint64_t NextId()
+		{
+			static std::atomic<uint64_t> id{ 1 };
+			return id.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		static void Add(std::atomic<uint64_t>& target, uint64_t value)
+		{
+			target.store(target.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+		}
+
+		Shard& LocalShard()
+		{
+			thread_local static std::array<CacheEntry, CacheSize> cache{};
+			thread_local static size_t victim = 0;
+
+			for (auto& entry : cache)
+			{
+				if (entry.Id == this->m_id) {
+					return *entry.Value;
+				}
+			}
+
+			std::thread::id self = std::this_thread::get_id();
+			Shard* shard = this->m_shards.load(std::memory_order_acquire);
+			while (shard != nullptr && shard->Owner != self) {
+				shard = shard->Next;
+			}
+
+			if (shard == nullptr)
+			{
+				shard = new Shard();
+				shard->Counts = std::make_unique<std::atomic<uint64_t>[]>(this->m_layout.m_counts.size());
+				shard->Owner = self;
+				shard->Next = this->m_shards.load(std::memory_order_relaxed);
+				while (!this->m_shards.compare_exchange_weak(shard->Next, shard, std::memory_order_release, std::memory_order_relaxed)) {
+				}
+			}
+
+			cache[victim] = CacheEntry{ this->m_id, shard };
+			victim = (victim + 1) % CacheSize;
+			return *shard;
+		}
+
+	public:
+		explicit ItsConcurrentHistogram(uint64_t highestTrackable = 3'600'000'000'000, int significantDigits = 3)
+			: m_layout(highestTrackable, significantDigits),
+			m_id(ItsConcurrentHistogram::NextId()),
+			m_previous(highestTrackable, significantDigits)
+		{
+		}
+
+		ItsConcurrentHistogram(const ItsConcurrentHistogram&) = delete;
+		ItsConcurrentHistogram& operator=(const ItsConcurrentHistogram&) = delete;
+
+		~ItsConcurrentHistogram()
+		{
+			Shard* shard = this->m_shards.load(std::memory_order_acquire);
+			while (shard != nullptr)
+			{
+				Shard* next = shard->Next;
+				delete shard;
+				shard = next;
+			}
+		}
+
+		void Record(uint64_t value, uint64_t count = 1)
+		{
+			Shard& shard = this->LocalShard();
+			ItsConcurrentHistogram::Add(shard.Counts[this->m_layout.IndexOf(value)], count);
+			ItsConcurrentHistogram::Add(shard.TotalCount, count);
+			if (value < shard.Min.load(std::memory_order_relaxed)) {
+				shard.Min.store(value, std::memory_order_relaxed);
+			}
+			if (value > shard.Max.load(std::memory_order_relaxed)) {
+				shard.Max.store(value, std::memory_order_relaxed);
+			}
+		}
+
+		void Record(std::chrono::nanoseconds value)
+		{
+			this->Record(static_cast<uint64_t>((value.count() < 0) ? 0 : value.count()));
+		}
+
+		//
+		// Everything recorded so far, from all threads.
+		//
+		ItsHistogram Snapshot() const
+		{
+			ItsHistogram result(this->m_layout.m_highestTrackable, this->m_layout.m_significantDigits);
+			for (Shard* shard = this->m_shards.load(std::memory_order_acquire); shard != nullptr; shard = shard->Next)
+			{
+				for (size_t i = 0; i < result.m_counts.size(); i++) {
+					result.m_counts[i] += shard->Counts[i].load(std::memory_order_relaxed);
+				}
+				result.m_min = (std::min)(result.m_min, shard->Min.load(std::memory_order_relaxed));
+				result.m_max = (std::max)(result.m_max, shard->Max.load(std::memory_order_relaxed));
+			}
+
+			// Sum the buckets so the total matches the counts read above.
+			for (uint64_t count : result.m_counts) {
+				result.m_totalCount += count;
+			}
+			return result;
+		}
+
+		//
+		// What was recorded since the previous call. Min/Max come from the buckets.
+		// Call from one thread only.
+		//
+		ItsHistogram Interval()
+		{
+			ItsHistogram current = this->Snapshot();
+			ItsHistogram result(this->m_layout.m_highestTrackable, this->m_layout.m_significantDigits);
+			for (size_t i = 0; i < result.m_counts.size(); i++)
+			{
+				result.m_counts[i] = current.m_counts[i] - this->m_previous.m_counts[i];
+				result.m_totalCount += result.m_counts[i];
+			}
+			result.RangeFromCounts();
+			this->m_previous = std::move(current);
+			return result;
+		}
+	};
+
+	//
+	// struct: ItsProfiler
+	//
+	// (i): Collects ITS_PROFILE_SCOPE events. Every thread writes completed scopes into its
+	//      own ring buffer (the oldest events are overwritten when it is full); readers merge
+	//      the buffers without stopping the writers. Reports a call tree with inclusive and
+	//      exclusive time, and Chrome trace JSON for chrome://tracing or Perfetto.
+	//
+	struct ItsProfiler
+	{
+		friend struct ItsProfileScope;
+	public:
+		//
+		// Id numbers the scopes of a thread in the order they were entered; Parent is the Id
+		// of the enclosing scope, 0 at the top level.
+		//
+		struct Event
+		{
+			const char* Name;
+			uint64_t Start;
+			uint64_t End;
+			uint32_t Depth;
+			uint32_t Thread;
+			uint64_t Id;
+			uint64_t Parent;
+		};
+
+		static constexpr size_t Capacity = 1 << 16;
+
+	private:
+		struct ThreadBuffer
+		{
+			std::unique_ptr<Event[]> Events{ std::make_unique<Event[]>(Capacity) };
+			std::atomic<uint64_t> Head{ 0 };
+			std::atomic<uint64_t> Tail{ 0 };
+			uint32_t Depth{ 0 };
+			uint32_t Thread{ 0 };
+			uint64_t Entered{ 0 };
+			uint64_t Current{ 0 };
+			std::atomic<bool> InUse{ true };
+			ThreadBuffer* Next{ nullptr };
+		};
+
+		//
+		// Releases the thread's buffer for reuse when the thread exits.
+		//
+		struct ThreadOwner
+		{
+			ThreadBuffer* Buffer;
+
+			~ThreadOwner()
+			{
+				this->Buffer->InUse.store(false, std::memory_order_release);
+			}
+		};
+
+		struct Node
+		{
+			const char* Name{ nullptr };
+			uint64_t Calls{ 0 };
+			uint64_t Inclusive{ 0 };
+			vector<std::unique_ptr<Node>> Children;
+
+			Node& Child(const char* name)
+			{
+				for (auto& child : this->Children)
+				{
+					if (child->Name == name || strcmp(child->Name, name) == 0) {
+						return *child;
+					}
+				}
+				this->Children.push_back(std::make_unique<Node>());
+				this->Children.back()->Name = name;
+				return *this->Children.back();
+			}
+		};
+
+		static std::atomic<ThreadBuffer*>& Threads()
+		{
+			static std::atomic<ThreadBuffer*> threads{ nullptr };
+			return threads;
+		}
+
+		//
+		// Takes over the buffer of an exited thread, or registers a new one. A buffer keeps the
+		// events of its earlier threads (each event carries its thread id) until they are
+		// overwritten, so the number of buffers is bounded by the peak number of live threads.
+		//
+		static ThreadBuffer* Register()
+		{
+			static std::atomic<uint32_t> nextThread{ 1 };
+			uint32_t thread = nextThread.fetch_add(1, std::memory_order_relaxed);
+			for (ThreadBuffer* buffer = ItsProfiler::Threads().load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->Next)
+			{
+				bool inUse = false;
+				if (!buffer->InUse.load(std::memory_order_relaxed) && buffer->InUse.compare_exchange_strong(inUse, true, std::memory_order_acquire, std::memory_order_relaxed)) {
+					buffer->Depth = 0;
+					buffer->Current = 0;
+					buffer->Thread = thread;
+					return buffer;
+				}
+			}
+
+			ThreadBuffer* buffer = new ThreadBuffer();
+			buffer->Thread = thread;
+			buffer->Next = ItsProfiler::Threads().load(std::memory_order_relaxed);
+			while (!ItsProfiler::Threads().compare_exchange_weak(buffer->Next, buffer, std::memory_order_release, std::memory_order_relaxed)) {
+			}
+			return buffer;
+		}
+
+		static void Write(wstringstream& ss, const Node& node, double nsPerTick, int indent)
+		{
+			uint64_t childTicks = 0;
+			for (auto& child : node.Children) {
+				childTicks += child->Inclusive;
+			}
+
+			wstring name(indent * 2, L' ');
+			for (const char* p = node.Name; *p != '\0'; p++) {
+				name += static_cast<wchar_t>(static_cast<unsigned char>(*p));
+			}
+			ss << std::left << std::setw(40) << name << std::right;
+			ss << std::setw(10) << node.Calls;
+			ss << std::setw(14) << std::fixed << std::setprecision(3) << static_cast<double>(node.Inclusive) * nsPerTick / 1'000'000.0;
+			ss << std::setw(14) << std::fixed << std::setprecision(3) << static_cast<double>(node.Inclusive - childTicks) * nsPerTick / 1'000'000.0 << endl;
+
+			for (auto& child : node.Children) {
+				ItsProfiler::Write(ss, *child, nsPerTick, indent + 1);
+			}
+		}
+
+		static ThreadBuffer& Local()
+		{
+			thread_local static ThreadOwner owner{ ItsProfiler::Register() };
+			return *owner.Buffer;
+		}
+
+	public:
+		//
+		// Completed events of all threads, ordered by thread and start time.
+		//
+		static vector<Event> Events()
+		{
+			vector<Event> events;
+			for (ThreadBuffer* buffer = ItsProfiler::Threads().load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->Next)
+			{
+				uint64_t head = buffer->Head.load(std::memory_order_acquire);
+				uint64_t first = (std::max)(buffer->Tail.load(std::memory_order_relaxed), (head > Capacity) ? head - Capacity : 0);
+				size_t count = events.size();
+				for (uint64_t i = first; i < head; i++) {
+					events.push_back(buffer->Events[i & (Capacity - 1)]);
+				}
+
+				// Drop entries the writer may have overwritten while they were copied
+				// (including the slot it may be writing right now).
+				uint64_t unsafeEnd = buffer->Head.load(std::memory_order_acquire) + 1;
+				if (unsafeEnd > Capacity && unsafeEnd - Capacity > first)
+				{
+					size_t overwritten = static_cast<size_t>((std::min)(unsafeEnd - Capacity - first, head - first));
+					events.erase(events.begin() + count, events.begin() + count + overwritten);
+				}
+			}
+
+			std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+				if (a.Thread != b.Thread) {
+					return a.Thread < b.Thread;
+				}
+				if (a.Start != b.Start) {
+					return a.Start < b.Start;
+				}
+				return a.Id < b.Id;
+			});
+			return events;
+		}
+
+		//
+		// Forgets all events recorded so far.
+		//
+		static void Clear()
+		{
+			for (ThreadBuffer* buffer = ItsProfiler::Threads().load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->Next) {
+				buffer->Tail.store(buffer->Head.load(std::memory_order_acquire), std::memory_order_relaxed);
+			}
+		}
+
+		//
+		// Call tree merged over all threads: calls, inclusive and exclusive milliseconds.
+		// Scopes whose enclosing scope has not completed yet are listed under "(unfinished)".
+		//
+		static wstring Report()
+		{
+			vector<Event> events = ItsProfiler::Events();
+
+			// A parent starts before its children, so in start order it is on the stack of
+			// open ancestors when a child is reached, unless it has not completed.
+			Node root;
+			vector<std::pair<Node*, uint64_t>> stack;
+			uint32_t thread = 0;
+			for (const Event& e : events)
+			{
+				if (e.Thread != thread) {
+					stack.clear();
+					thread = e.Thread;
+				}
+				while (!stack.empty() && stack.back().second != e.Parent) {
+					stack.pop_back();
+				}
+
+				Node* parent = &root;
+				if (!stack.empty()) {
+					parent = stack.back().first;
+				}
+				else if (e.Parent != 0) {
+					parent = &root.Child("(unfinished)");
+					parent->Inclusive += e.End - e.Start;
+				}
+				Node& node = parent->Child(e.Name);
+				node.Calls++;
+				node.Inclusive += e.End - e.Start;
+				stack.push_back({ &node, e.Id });
+			}
+
+			wstringstream ss;
+			ss << std::left << std::setw(40) << L"Scope" << std::right << std::setw(10) << L"Calls" << std::setw(14) << L"Incl. ms" << std::setw(14) << L"Excl. ms" << endl;
+			double nsPerTick = ItsTsc::NanosecondsPerTick();
+			for (auto& child : root.Children) {
+				ItsProfiler::Write(ss, *child, nsPerTick, 0);
+			}
+			return ss.str();
+		}
+
+		//
+		// Chrome trace event format ("X" complete events, microsecond timestamps).
+		//
+		static string ToChromeTrace()
+		{
+			vector<Event> events = ItsProfiler::Events();
+			uint64_t base = UINT64_MAX;
+			for (const Event& e : events) {
+				base = (std::min)(base, e.Start);
+			}
+
+			stringstream ss;
+			ss << "{\"traceEvents\":[";
+			for (size_t i = 0; i < events.size(); i++)
+			{
+				const Event& e = events[i];
+				ss << ((i == 0) ? "\n" : ",\n") << "{\"name\":\"";
+				for (const char* p = e.Name; *p != '\0'; p++)
+				{
+					if (*p == '"' || *p == '\\') {
+						ss << '\\' << *p;
+					}
+					else if (static_cast<unsigned char>(*p) >= 0x20) {
+						ss << *p;
+					}
+				}
+				ss << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.Thread;
+				ss << ",\"ts\":" << std::fixed << std::setprecision(3) << static_cast<double>(ItsTsc::ToNanoseconds(e.Start - base)) / 1000.0;
+				ss << ",\"dur\":" << std::fixed << std::setprecision(3) << static_cast<double>(ItsTsc::ToNanoseconds(e.End - e.Start)) / 1000.0 << "}";
+			}
+			ss << "\n],\"displayTimeUnit\":\"ns\"}\n";
+			return ss.str();
+		}
+	};
+
+	//
+	// struct: ItsProfileScope
+	//
+	// (i): Records the lifetime of a scope with ItsProfiler. Use through ITS_PROFILE_SCOPE.
+	//      The name must outlive the profiler (a string literal).
+	//
+	struct ItsProfileScope
+	{
+	private:
+		ItsProfiler::ThreadBuffer& m_buffer;
+		const char* m_name;
+		uint64_t m_start;
+		uint64_t m_id;
+		uint64_t m_parent;
+
+	public:
+		explicit ItsProfileScope(const char* name)
+			: m_buffer(ItsProfiler::Local()), m_name(name)
+		{
+			this->m_id = ++this->m_buffer.Entered;
+			this->m_parent = this->m_buffer.Current;
+			this->m_buffer.Current = this->m_id;
+			this->m_buffer.Depth++;
+			this->m_start = ItsTsc::Read();
+		}
+
+		ItsProfileScope(const ItsProfileScope&) = delete;
+		ItsProfileScope& operator=(const ItsProfileScope&) = delete;
+
+		~ItsProfileScope()
+		{
+			uint64_t end = ItsTsc::Read();
+			uint64_t head = this->m_buffer.Head.load(std::memory_order_relaxed);
+			uint32_t depth = --this->m_buffer.Depth;
+			this->m_buffer.Current = this->m_parent;
+			this->m_buffer.Events[head & (ItsProfiler::Capacity - 1)] = ItsProfiler::Event{ this->m_name, this->m_start, end, depth, this->m_buffer.Thread, this->m_id, this->m_parent };
+			this->m_buffer.Head.store(head + 1, std::memory_order_release);
+		}
+	};
+
+	//
+	// ITS_PROFILE_SCOPE("name") profiles the rest of the enclosing scope when ITS_PROFILE
+	// is defined, and compiles to nothing otherwise.
+	//
+#define ITS_PROFILE_CONCAT2(a, b) a##b
+#define ITS_PROFILE_CONCAT1(a, b) ITS_PROFILE_CONCAT2(a, b)
+#if defined(ITS_PROFILE)
+#define ITS_PROFILE_SCOPE(name) ItSoftware::ItsProfileScope ITS_PROFILE_CONCAT1(itsProfileScope, __LINE__)(name)
+#else
+#define ITS_PROFILE_SCOPE(name) ((void)0)
+#endif
+
+	//
+	// struct: ItsBenchResult
+	//
+	// (i): Statistics of one benchmark. Times are nanoseconds per operation over the
+	//      samples that survived outlier rejection; counters cover all samples.
+	//
+	struct ItsBenchResult
+	{
+		wstring Name;
+		uint64_t Iterations{ 0 };
+		size_t Samples{ 0 };
+		size_t Outliers{ 0 };
+		double Median{ 0.0 };
+		double MAD{ 0.0 };
+		double Mean{ 0.0 };
+		double Min{ 0.0 };
+		double Max{ 0.0 };
+		double OpsPerSecond{ 0.0 };
+		uint64_t Operations{ 0 };
+		ItsPerfCounterValues Counters;
+
+		//
+		// Counter value per operation over all samples, 0 when unavailable.
+		//
+		double PerOp(ItsPerfCounter counter) const
+		{
+			if (this->Operations == 0) {
+				return 0.0;
+			}
+			return static_cast<double>(this->Counters[counter]) / static_cast<double>(this->Operations);
+		}
+	};
+
+	//
+	// struct: ItsBench
+	//
+	// (i): Microbenchmark harness on ItsTimer. Each Run warms up, picks an iteration count
+	//      so one sample takes about SampleTime, times Samples batches and rejects samples
+	//      further than 3 scaled MADs from the median.
+	//
+	struct ItsBench
+	{
+	private:
+		size_t m_samples;
+		std::chrono::nanoseconds m_sampleTime;
+		std::chrono::nanoseconds m_warmup;
+		std::unique_ptr<ItsPerfCounters> m_counters;
+		vector<ItsBenchResult> m_results;
+
+		static double Median(vector<double> values)
+		{
+			if (values.empty()) {
+				return 0.0;
+			}
+			size_t middle = values.size() / 2;
+			std::nth_element(values.begin(), values.begin() + middle, values.end());
+			double median = values[middle];
+			if (values.size() % 2 == 0) {
+				median = (median + *std::max_element(values.begin(), values.begin() + middle)) / 2.0;
+			}
+			return median;
+		}
+
+		static double MedianAbsoluteDeviation(const vector<double>& values, double median)
+		{
+			vector<double> deviations;
+			deviations.reserve(values.size());
+			for (double v : values) {
+				deviations.push_back(std::abs(v - median));
+			}
+			return ItsBench::Median(std::move(deviations));
+		}
+
+		template<typename Fn>
+		std::chrono::nanoseconds Time(Fn& fn, uint64_t iterations, ItsPerfCounterValues* counters)
+		{
+			ItsTimer timer(ItsTimerMode::Steady, (counters != nullptr) ? this->m_counters.get() : nullptr);
+			timer.Start();
+			for (uint64_t i = 0; i < iterations; i++) {
+				fn();
+			}
+			timer.Stop();
+			if (counters != nullptr) {
+				*counters += timer.Counters();
+			}
+			return timer.Get();
+		}
+
+		bool HasCounters() const
+		{
+			for (const auto& r : this->m_results)
+			{
+				if (r.Counters.Any()) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		static wstring JsonEscape(const wstring& text)
+		{
+			wstring result;
+			for (wchar_t c : text)
+			{
+				if (c == L'"' || c == L'\\') {
+					result += L'\\';
+				}
+				result += c;
+			}
+			return result;
+		}
+
+		static wstring CsvEscape(const wstring& text)
+		{
+			wstring result;
+			for (wchar_t c : text)
+			{
+				if (c == L'"') {
+					result += L'"';
+				}
+				result += c;
+			}
+			return result;
+		}
+
+	public:
+		explicit ItsBench(size_t samples = 30, std::chrono::nanoseconds sampleTime = std::chrono::milliseconds(10), std::chrono::nanoseconds warmup = std::chrono::milliseconds(100))
+			: m_samples((samples < 3) ? 3 : samples), m_sampleTime(sampleTime), m_warmup(warmup)
+		{
+		}
+
+		//
+		// Reads hardware counters (ItsPerfCounters) during the samples of later runs.
+		// Returns false when no counter is available.
+		//
+		bool EnableCounters()
+		{
+			if (this->m_counters == nullptr) {
+				this->m_counters = std::make_unique<ItsPerfCounters>();
+			}
+			return this->m_counters->IsAvailable();
+		}
+
+		//
+		// Keeps the compiler from discarding a computed value.
+		//
+		template<typename T>
+		static void DoNotOptimize(const T& value)
+		{
+#if defined(_MSC_VER) && !defined(__clang__)
+			const volatile char* volatile sink = &reinterpret_cast<const volatile char&>(value);
+			(void)sink;
+			_ReadWriteBarrier();
+#else
+			__asm__ volatile("" : : "r,m"(value) : "memory");
+#endif
+		}
+
+		//
+		// Forces pending writes to memory to be considered observable.
+		//
+		static void ClobberMemory()
+		{
+#if defined(_MSC_VER) && !defined(__clang__)
+			_ReadWriteBarrier();
+#else
+			__asm__ volatile("" : : : "memory");
+#endif
+		}
+
+		//
+		// Benchmarks fn, which performs one operation per call.
+		//
+		template<typename Fn>
+		const ItsBenchResult& Run(const wstring& name, Fn&& fn)
+		{
+			// Warm up and estimate the time per operation.
+			uint64_t iterations = 1;
+			std::chrono::nanoseconds spent{ 0 };
+			std::chrono::nanoseconds last{ 0 };
+			while (spent < this->m_warmup || last.count() == 0)
+			{
+				last = this->Time(fn, iterations, nullptr);
+				spent += last;
+				if (last < this->m_sampleTime / 2) {
+					iterations *= 2;
+				}
+			}
+			double perOp = static_cast<double>(last.count()) / static_cast<double>(iterations);
+			iterations = static_cast<uint64_t>((std::max)(1.0, static_cast<double>(this->m_sampleTime.count()) / (std::max)(perOp, 0.01)));
+
+			ItsPerfCounterValues counters;
+			vector<double> samples;
+			samples.reserve(this->m_samples);
+			for (size_t i = 0; i < this->m_samples; i++) {
+				samples.push_back(static_cast<double>(this->Time(fn, iterations, (this->m_counters != nullptr) ? &counters : nullptr).count()) / static_cast<double>(iterations));
+			}
+
+			// Reject outliers: further than 3 * 1.4826 MAD (3 sigma for normal data).
+			double median = ItsBench::Median(samples);
+			double limit = 3.0 * 1.4826 * ItsBench::MedianAbsoluteDeviation(samples, median);
+			vector<double> kept;
+			for (double s : samples)
+			{
+				if (limit == 0.0 || std::abs(s - median) <= limit) {
+					kept.push_back(s);
+				}
+			}
+
+			ItsBenchResult result;
+			result.Name = name;
+			result.Iterations = iterations;
+			result.Samples = kept.size();
+			result.Outliers = samples.size() - kept.size();
+			result.Median = ItsBench::Median(kept);
+			result.MAD = ItsBench::MedianAbsoluteDeviation(kept, result.Median);
+			result.Min = *std::min_element(kept.begin(), kept.end());
+			result.Max = *std::max_element(kept.begin(), kept.end());
+			for (double s : kept) {
+				result.Mean += s;
+			}
+			result.Mean /= static_cast<double>(kept.size());
+			result.OpsPerSecond = (result.Median > 0.0) ? 1'000'000'000.0 / result.Median : 0.0;
+			result.Operations = iterations * samples.size();
+			result.Counters = counters;
+
+			this->m_results.push_back(std::move(result));
+			return this->m_results.back();
+		}
+
+		const vector<ItsBenchResult>& Results() const
+		{
+			return this->m_results;
+		}
+
+		//
+		// Human readable table.
+		//
+		wstring ToString() const
+		{
+			wstringstream ss;
+			bool counters = this->HasCounters();
+			ss << std::left << std::setw(40) << L"Benchmark" << std::right << std::setw(14) << L"Median ns" << std::setw(12) << L"MAD ns" << std::setw(16) << L"ops/s" << std::setw(10) << L"Outliers";
+			if (counters) {
+				ss << std::setw(8) << L"IPC" << std::setw(14) << L"Instr/op" << std::setw(16) << L"Cache miss/op" << std::setw(16) << L"Branch miss/op" << std::setw(12) << L"Faults/op";
+			}
+			ss << endl;
+			for (const auto& r : this->m_results)
+			{
+				ss << std::left << std::setw(40) << r.Name << std::right << std::fixed << std::setprecision(2);
+				ss << std::setw(14) << r.Median << std::setw(12) << r.MAD << std::setw(16) << std::setprecision(0) << r.OpsPerSecond;
+				ss << std::setw(10) << r.Outliers;
+				if (counters)
+				{
+					ss << std::setprecision(2) << std::setw(8) << r.Counters.IPC() << std::setw(14) << r.PerOp(ItsPerfCounter::Instructions);
+					ss << std::setprecision(4) << std::setw(16) << r.PerOp(ItsPerfCounter::CacheMisses) << std::setw(16) << r.PerOp(ItsPerfCounter::BranchMisses);
+					ss << std::setw(12) << r.PerOp(ItsPerfCounter::PageFaults);
+				}
+				ss << endl;
+			}
+			return ss.str();
+		}
+
+		wstring ToJson() const
+		{
+			wstringstream ss;
+			ss << L"{\"benchmarks\":[";
+			for (size_t i = 0; i < this->m_results.size(); i++)
+			{
+				const auto& r = this->m_results[i];
+				ss << ((i == 0) ? L"\n" : L",\n") << L"{\"name\":\"" << ItsBench::JsonEscape(r.Name) << L"\"";
+				ss << L",\"iterations\":" << r.Iterations << L",\"samples\":" << r.Samples << L",\"outliers\":" << r.Outliers;
+				ss << std::fixed << std::setprecision(3);
+				ss << L",\"median_ns\":" << r.Median << L",\"mad_ns\":" << r.MAD << L",\"mean_ns\":" << r.Mean;
+				ss << L",\"min_ns\":" << r.Min << L",\"max_ns\":" << r.Max << L",\"ops_per_second\":" << r.OpsPerSecond;
+				if (r.Counters.Any())
+				{
+					if (r.Counters.Has(ItsPerfCounter::Cycles) && r.Counters.Has(ItsPerfCounter::Instructions)) {
+						ss << L",\"ipc\":" << r.Counters.IPC();
+					}
+					const wchar_t* names[] = { L"cycles_per_op", L"instructions_per_op", L"cache_misses_per_op", L"branch_misses_per_op", L"page_faults_per_op" };
+					for (size_t c = 0; c < ItsPerfCounterValues::Count; c++)
+					{
+						if (r.Counters.Available[c]) {
+							ss << L",\"" << names[c] << L"\":" << r.PerOp(static_cast<ItsPerfCounter>(c));
+						}
+					}
+				}
+				ss << L"}";
+			}
+			ss << L"\n]}" << endl;
+			return ss.str();
+		}
+
+		wstring ToCsv() const
+		{
+			wstringstream ss;
+			ss << L"Name,Iterations,Samples,Outliers,MedianNs,MADNs,MeanNs,MinNs,MaxNs,OpsPerSecond,IPC,CyclesPerOp,InstructionsPerOp,CacheMissesPerOp,BranchMissesPerOp,PageFaultsPerOp" << endl;
+			for (const auto& r : this->m_results)
+			{
+				ss << L"\"" << ItsBench::CsvEscape(r.Name) << L"\"," << r.Iterations << L"," << r.Samples << L"," << r.Outliers;
+				ss << std::fixed << std::setprecision(3);
+				ss << L"," << r.Median << L"," << r.MAD << L"," << r.Mean << L"," << r.Min << L"," << r.Max << L"," << r.OpsPerSecond << L",";
+				if (r.Counters.Has(ItsPerfCounter::Cycles) && r.Counters.Has(ItsPerfCounter::Instructions)) {
+					ss << r.Counters.IPC();
+				}
+				for (size_t c = 0; c < ItsPerfCounterValues::Count; c++)
+				{
+					ss << L",";
+					if (r.Counters.Available[c]) {
+						ss << r.PerOp(static_cast<ItsPerfCounter>(c));
+					}
+				}
+				ss << endl;
+			}
+			return ss.str();
+		}
+	};
+
+	//
+	// enum: ItsClockMode
+	//
+	// (i): Precise reads the system clock at full resolution. Coarse reads the clock the
+	//      kernel updates once per tick (CLOCK_REALTIME_COARSE, GetSystemTimeAsFileTime),
+	//      which is several times cheaper at 1-16 ms resolution.
+	//
+	enum class ItsClockMode
+	{
+		Precise,
+		Coarse
+	};
+
+	//
+	// struct: ItsClock
+	//
+	// (i): Wall clock as UTC nanoseconds since 1970-01-01 and the local UTC offset.
+	//      The offset is looked up with localtime_s at most once per second and shared
+	//      by all threads through a single atomic.
+	//
+	struct ItsClock
+	{
+	private:
+		static constexpr int64_t NanosecondsPerSecond = 1'000'000'000LL;
+		static constexpr int OffsetBits = 20;
+		static constexpr int64_t OffsetBias = 1LL << (OffsetBits - 1);
+		static constexpr uint64_t OffsetMask = (1ULL << OffsetBits) - 1;
+
+		//
+		// (second << OffsetBits) | (offset + OffsetBias). 0 is empty; offsets stay far above -OffsetBias.
+		//
+		static std::atomic<uint64_t>& OffsetCache()
+		{
+			static std::atomic<uint64_t> cache{ 0 };
+			return cache;
+		}
+
+	public:
+		static int64_t UtcNanoseconds(ItsClockMode mode = ItsClockMode::Precise)
+		{
+#if defined(_WIN32)
+			FILETIME ft;
+			if (mode == ItsClockMode::Coarse) {
+				::GetSystemTimeAsFileTime(&ft);
+			}
+			else {
+				::GetSystemTimePreciseAsFileTime(&ft);
+			}
+			int64_t ticks = static_cast<int64_t>((static_cast<uint64_t>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime);
+			return (ticks - 116'444'736'000'000'000LL) * 100;
+#elif defined(CLOCK_REALTIME_COARSE)
+			timespec ts;
+			clock_gettime((mode == ItsClockMode::Coarse) ? CLOCK_REALTIME_COARSE : CLOCK_REALTIME, &ts);
+			return static_cast<int64_t>(ts.tv_sec) * NanosecondsPerSecond + ts.tv_nsec;
+#else
+			(void)mode;
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+#endif
+		}
+
+		//
+		// Seconds east of UTC in the process time zone at the given instant.
+		//
+		static int32_t LocalOffsetSeconds(int64_t utcNanoseconds)
+		{
+			int64_t second = (utcNanoseconds >= 0) ? utcNanoseconds / NanosecondsPerSecond : -((-utcNanoseconds + NanosecondsPerSecond - 1) / NanosecondsPerSecond);
+			uint64_t cached = ItsClock::OffsetCache().load(std::memory_order_relaxed);
+			if (cached != 0 && (static_cast<int64_t>(cached) >> OffsetBits) == second) {
+				return static_cast<int32_t>(static_cast<int64_t>(cached & OffsetMask) - OffsetBias);
+			}
+
+			time_t t = static_cast<time_t>(second);
+			tm local{ 0 };
+			localtime_s(&local, &t);
+			int64_t wall = ItsCivil::DaysFromCivil(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday) * 86'400 + local.tm_hour * 3'600 + local.tm_min * 60 + local.tm_sec;
+			int32_t offset = static_cast<int32_t>(wall - second);
+
+			ItsClock::OffsetCache().store((static_cast<uint64_t>(second) << OffsetBits) | static_cast<uint64_t>(offset + OffsetBias), std::memory_order_relaxed);
+			return offset;
+		}
+	};
+
+	//
+	// struct: ItsDateTimeFormat
+	//
+	// (i): Date and time pattern compiled once into a token program, then formatted in a
+	//      single pass into a caller supplied buffer, or used to parse text.
+	//      Tokens: d dd M MM y yy yyyy H HH m mm s ss f..fffffffff z zz zzz.
+	//      Longer d/M/H/m/s runs repeat the two digit field (ddd = dd + d).
+	//      Any other character is literal; 'quoted text' and \x are always literal.
+	//      Literal patterns compile at compile time: constexpr ItsDateTimeFormat f(L"dd.MM.yyyy");
+	//
+	struct ItsDateTimeFormat
+	{
+	public:
+		static constexpr size_t MaxLength = 320;
+		static constexpr size_t MaxTokens = 48;
+		static constexpr size_t MaxLiteral = 128;
+
+	private:
+		enum class Kind : uint8_t
+		{
+			Literal,
+			Year,
+			Month,
+			Day,
+			Hour,
+			Minute,
+			Second,
+			Fraction,
+			Offset
+		};
+
+		struct Token
+		{
+			Kind Type{ Kind::Literal };
+			uint8_t Width{ 0 };
+			uint8_t Start{ 0 };
+			uint8_t Length{ 0 };
+		};
+
+		struct Fields
+		{
+			int Year{ 1970 };
+			int Month{ 1 };
+			int Day{ 1 };
+			int Hour{ 0 };
+			int Minute{ 0 };
+			int Second{ 0 };
+			int Nanosecond{ 0 };
+			int32_t Offset{ 0 };
+		};
+
+		Token m_tokens[MaxTokens]{};
+		wchar_t m_literal[MaxLiteral]{};
+		size_t m_tokenCount{ 0 };
+		size_t m_literalCount{ 0 };
+		size_t m_maxLength{ 0 };
+		bool m_valid{ false };
+
+		static constexpr int64_t NanosecondsPerSecond = 1'000'000'000LL;
+		static constexpr int64_t NanosecondsPerDay = 86'400LL * NanosecondsPerSecond;
+
+		constexpr bool Add(Kind type, size_t width)
+		{
+			if (this->m_tokenCount == MaxTokens) {
+				return false;
+			}
+			size_t length = 0;
+			switch (type)
+			{
+			case Kind::Year:
+				length = std::max<size_t>(width, 4);
+				break;
+			case Kind::Fraction:
+				length = width;
+				break;
+			case Kind::Offset:
+				length = (width == 3) ? 6 : 3;
+				break;
+			default:
+				length = 2;
+				break;
+			}
+			this->m_maxLength += length;
+			Token& token = this->m_tokens[this->m_tokenCount++];
+			token.Type = type;
+			token.Width = static_cast<uint8_t>(width);
+			return true;
+		}
+
+		constexpr bool AddLiteral(wchar_t c)
+		{
+			if (this->m_literalCount == MaxLiteral) {
+				return false;
+			}
+			if (this->m_tokenCount == 0 || this->m_tokens[this->m_tokenCount - 1].Type != Kind::Literal) {
+				if (this->m_tokenCount == MaxTokens) {
+					return false;
+				}
+				Token& token = this->m_tokens[this->m_tokenCount++];
+				token.Type = Kind::Literal;
+				token.Start = static_cast<uint8_t>(this->m_literalCount);
+				token.Length = 0;
+			}
+			this->m_literal[this->m_literalCount++] = c;
+			this->m_tokens[this->m_tokenCount - 1].Length++;
+			this->m_maxLength++;
+			return true;
+		}
+
+		constexpr bool Compile(std::wstring_view pattern)
+		{
+			size_t i = 0;
+			while (i < pattern.size())
+			{
+				wchar_t c = pattern[i];
+				if (c == L'\\') {
+					if (i + 1 == pattern.size() || !this->AddLiteral(pattern[i + 1])) {
+						return false;
+					}
+					i += 2;
+					continue;
+				}
+				if (c == L'\'') {
+					i++;
+					while (true)
+					{
+						if (i == pattern.size()) {
+							return false;
+						}
+						if (pattern[i] == L'\'') {
+							if (i + 1 < pattern.size() && pattern[i + 1] == L'\'') {
+								if (!this->AddLiteral(L'\'')) {
+									return false;
+								}
+								i += 2;
+								continue;
+							}
+							i++;
+							break;
+						}
+						if (!this->AddLiteral(pattern[i++])) {
+							return false;
+						}
+					}
+					continue;
+				}
+
+				size_t run = 1;
+				while (i + run < pattern.size() && pattern[i + run] == c) {
+					run++;
+				}
+
+				Kind type = Kind::Literal;
+				switch (c)
+				{
+				case L'y': type = Kind::Year; break;
+				case L'M': type = Kind::Month; break;
+				case L'd': type = Kind::Day; break;
+				case L'H': type = Kind::Hour; break;
+				case L'm': type = Kind::Minute; break;
+				case L's': type = Kind::Second; break;
+				case L'f': type = Kind::Fraction; break;
+				case L'z': type = Kind::Offset; break;
+				default: break;
+				}
+
+				if (type == Kind::Literal) {
+					if (!this->AddLiteral(c)) {
+						return false;
+					}
+					i++;
+					continue;
+				}
+
+				if (type == Kind::Year || type == Kind::Fraction || type == Kind::Offset) {
+					size_t limit = (type == Kind::Offset) ? 3 : 9;
+					if (run > limit || !this->Add(type, run)) {
+						return false;
+					}
+				}
+				else {
+					for (size_t left = run; left > 0; left -= std::min<size_t>(left, 2)) {
+						if (!this->Add(type, std::min<size_t>(left, 2))) {
+							return false;
+						}
+					}
+				}
+				i += run;
+			}
+			return this->m_maxLength <= MaxLength;
+		}
+
+		static constexpr Fields Split(int64_t unixNanoseconds, int32_t offsetSeconds)
+		{
+			int64_t local = unixNanoseconds + static_cast<int64_t>(offsetSeconds) * NanosecondsPerSecond;
+			int64_t days = local / NanosecondsPerDay - ((local % NanosecondsPerDay < 0) ? 1 : 0);
+			int64_t timeOfDay = local % NanosecondsPerDay + ((local % NanosecondsPerDay < 0) ? NanosecondsPerDay : 0);
+			ItsCivil::Date date = ItsCivil::CivilFromDays(days);
+			int64_t seconds = timeOfDay / NanosecondsPerSecond;
+
+			Fields fields;
+			fields.Year = date.Year;
+			fields.Month = date.Month;
+			fields.Day = date.Day;
+			fields.Hour = static_cast<int>(seconds / 3'600);
+			fields.Minute = static_cast<int>(seconds / 60 % 60);
+			fields.Second = static_cast<int>(seconds % 60);
+			fields.Nanosecond = static_cast<int>(timeOfDay % NanosecondsPerSecond);
+			fields.Offset = offsetSeconds;
+			return fields;
+		}
+
+		template<typename Char>
+		static constexpr Char* PutNumber(Char* p, unsigned int value, size_t minDigits)
+		{
+			Char digits[10]{};
+			size_t count = 0;
+			do {
+				digits[count++] = static_cast<Char>('0' + value % 10);
+				value /= 10;
+			} while (value != 0);
+			while (count < minDigits) {
+				digits[count++] = static_cast<Char>('0');
+			}
+			while (count > 0) {
+				*p++ = digits[--count];
+			}
+			return p;
+		}
+
+		template<typename Char>
+		static constexpr bool GetNumber(const Char* text, size_t length, size_t& i, size_t minDigits, size_t maxDigits, int& value)
+		{
+			size_t count = 0;
+			value = 0;
+			while (count < maxDigits && i < length && text[i] >= static_cast<Char>('0') && text[i] <= static_cast<Char>('9')) {
+				value = value * 10 + static_cast<int>(text[i] - static_cast<Char>('0'));
+				i++;
+				count++;
+			}
+			return count >= minDigits;
+		}
+
+	public:
+		constexpr ItsDateTimeFormat() = default;
+
+		//
+		// Runtime pattern; check IsValid().
+		//
+		explicit constexpr ItsDateTimeFormat(std::wstring_view pattern)
+		{
+			this->m_valid = this->Compile(pattern);
+		}
+
+		//
+		// Literal pattern; an invalid pattern fails to compile.
+		//
+		template<size_t N>
+		explicit consteval ItsDateTimeFormat(const wchar_t(&pattern)[N])
+		{
+			this->m_valid = this->Compile(std::wstring_view(pattern, N - 1));
+			if (!this->m_valid) {
+				throw std::invalid_argument("ItsDateTimeFormat: invalid pattern");
+			}
+		}
+
+		constexpr bool IsValid() const
+		{
+			return this->m_valid;
+		}
+
+		//
+		// Upper bound on the characters Format writes for this pattern (at most MaxLength).
+		//
+		constexpr size_t MaxFormattedLength() const
+		{
+			return this->m_maxLength;
+		}
+
+		//
+		// Writes the wall clock time at offsetSeconds. Returns characters written; no terminator.
+		//
+		template<typename Char>
+		constexpr size_t Format(int64_t unixNanoseconds, int32_t offsetSeconds, Char* buffer) const
+		{
+			if (!this->m_valid) {
+				return 0;
+			}
+
+			Fields f = ItsDateTimeFormat::Split(unixNanoseconds, offsetSeconds);
+			Char* p = buffer;
+			for (size_t t = 0; t < this->m_tokenCount; t++)
+			{
+				const Token& token = this->m_tokens[t];
+				switch (token.Type)
+				{
+				case Kind::Literal:
+					for (size_t c = 0; c < token.Length; c++) {
+						*p++ = static_cast<Char>(this->m_literal[token.Start + c]);
+					}
+					break;
+				case Kind::Year:
+					if (token.Width <= 2) {
+						p = ItsDateTimeFormat::PutNumber(p, static_cast<unsigned int>(f.Year % 100), token.Width);
+					}
+					else {
+						p = ItsDateTimeFormat::PutNumber(p, static_cast<unsigned int>(f.Year), token.Width);
+					}
+					break;
+				case Kind::Month:
+					p = ItsDateTimeFormat::PutNumber(p, static_cast<unsigned int>(f.Month), token.Width);
+					break;
+				case Kind::Day:
+					p = ItsDateTimeFormat::PutNumber(p, static_cast<unsigned int>(f.Day), token.Width);
+					break;
+				case Kind::Hour:
+					p = ItsDateTimeFormat::PutNumber(p, static_cast<unsigned int>(f.Hour), token.Width);
+					break;
+				case Kind::Minute:
+					p = ItsDateTimeFormat::PutNumber(p, static_cast<unsigned int>(f.Minute), token.Width);
+					break;
+				case Kind::Second:
+					p = ItsDateTimeFormat::PutNumber(p, static_cast<unsigned int>(f.Second), token.Width);
+					break;
+				case Kind::Fraction:
+				{
+					unsigned int fraction = static_cast<unsigned int>(f.Nanosecond);
+					for (size_t d = token.Width; d < 9; d++) {
+						fraction /= 10;
+					}
+					p = ItsDateTimeFormat::PutNumber(p, fraction, token.Width);
+					break;
+				}
+				case Kind::Offset:
+				{
+					int32_t offset = f.Offset;
+					*p++ = static_cast<Char>((offset < 0) ? '-' : '+');
+					unsigned int magnitude = static_cast<unsigned int>((offset < 0) ? -offset : offset);
+					p = ItsDateTimeFormat::PutNumber(p, magnitude / 3'600, (token.Width == 1) ? 1 : 2);
+					if (token.Width == 3) {
+						*p++ = static_cast<Char>(':');
+						p = ItsDateTimeFormat::PutNumber(p, magnitude / 60 % 60, 2);
+					}
+					break;
+				}
+				}
+			}
+			return static_cast<size_t>(p - buffer);
+		}
+
+		//
+		// Parses text that matches the pattern exactly. Fields absent from the pattern default
+		// to 1970-01-01 00:00:00; yy is taken as 20yy; without z the offset is 0.
+		//
+		template<typename Char>
+		constexpr bool Parse(const Char* text, size_t length, int64_t* unixNanoseconds, int32_t* offsetSeconds) const
+		{
+			if (!this->m_valid || unixNanoseconds == nullptr || offsetSeconds == nullptr) {
+				return false;
+			}
+
+			Fields f;
+			size_t i = 0;
+			for (size_t t = 0; t < this->m_tokenCount; t++)
+			{
+				const Token& token = this->m_tokens[t];
+				size_t minDigits = token.Width;
+				size_t maxDigits = (token.Width == 1) ? 2 : token.Width;
+				int value = 0;
+				switch (token.Type)
+				{
+				case Kind::Literal:
+					for (size_t c = 0; c < token.Length; c++, i++) {
+						if (i >= length || text[i] != static_cast<Char>(this->m_literal[token.Start + c])) {
+							return false;
+						}
+					}
+					break;
+				case Kind::Year:
+					if (token.Width <= 2) {
+						if (!ItsDateTimeFormat::GetNumber(text, length, i, minDigits, 2, value)) {
+							return false;
+						}
+						f.Year = 2000 + value;
+					}
+					else {
+						if (!ItsDateTimeFormat::GetNumber(text, length, i, minDigits, std::max<size_t>(token.Width, 4), f.Year)) {
+							return false;
+						}
+					}
+					break;
+				case Kind::Month:
+					if (!ItsDateTimeFormat::GetNumber(text, length, i, minDigits, maxDigits, f.Month)) {
+						return false;
+					}
+					break;
+				case Kind::Day:
+					if (!ItsDateTimeFormat::GetNumber(text, length, i, minDigits, maxDigits, f.Day)) {
+						return false;
+					}
+					break;
+				case Kind::Hour:
+					if (!ItsDateTimeFormat::GetNumber(text, length, i, minDigits, maxDigits, f.Hour)) {
+						return false;
+					}
+					break;
+				case Kind::Minute:
+					if (!ItsDateTimeFormat::GetNumber(text, length, i, minDigits, maxDigits, f.Minute)) {
+						return false;
+					}
+					break;
+				case Kind::Second:
+					if (!ItsDateTimeFormat::GetNumber(text, length, i, minDigits, maxDigits, f.Second)) {
+						return false;
+					}
+					break;
+				case Kind::Fraction:
+					if (!ItsDateTimeFormat::GetNumber(text, length, i, token.Width, token.Width, value)) {
+						return false;
+					}
+					for (size_t d = token.Width; d < 9; d++) {
+						value *= 10;
+					}
+					f.Nanosecond = value;
+					break;
+				case Kind::Offset:
+				{
+					if (i >= length || (text[i] != static_cast<Char>('+') && text[i] != static_cast<Char>('-'))) {
+						return false;
+					}
+					bool negative = text[i++] == static_cast<Char>('-');
+					int hours = 0;
+					int minutes = 0;
+					if (!ItsDateTimeFormat::GetNumber(text, length, i, (token.Width == 1) ? 1 : 2, 2, hours) || hours > 18) {
+						return false;
+					}
+					if (token.Width == 3) {
+						if (i >= length || text[i++] != static_cast<Char>(':') || !ItsDateTimeFormat::GetNumber(text, length, i, 2, 2, minutes) || minutes > 59) {
+							return false;
+						}
+					}
+					f.Offset = (hours * 3'600 + minutes * 60) * (negative ? -1 : 1);
+					break;
+				}
+				}
+			}
+
+			if (i != length ||
+				f.Month < 1 || f.Month > 12 ||
+				f.Day < 1 || f.Day > ItsCivil::DaysInMonth(f.Year, f.Month) ||
+				f.Hour > 23 || f.Minute > 59 || f.Second > 59) {
+				return false;
+			}
+
+			int64_t seconds = ItsCivil::DaysFromCivil(f.Year, f.Month, f.Day) * 86'400 + f.Hour * 3'600 + f.Minute * 60 + f.Second - f.Offset;
+			if (seconds < -9'223'372'035LL || seconds > 9'223'372'035LL) {
+				return false;
+			}
+			*unixNanoseconds = seconds * NanosecondsPerSecond + f.Nanosecond;
+			*offsetSeconds = f.Offset;
+			return true;
+		}
+	};
+
+	//
+	// struct: ItsDateTime
+	//
+	// (i): Represents a date and time as UTC nanoseconds since 1970-01-01 plus an offset
+	//      in seconds east of UTC. Calendar fields are derived on demand with ItsCivil.
+	//      Range is 1677-09-22 00:00:00 to 2262-04-10 23:59:59.999999999 UTC with offsets
+	//      up to +/-18 hours, so the wall clock time always fits in int64 nanoseconds.
+	//      Construction outside the range throws std::invalid_argument; arithmetic that
+	//      leaves it throws std::overflow_error. Equality, ordering and hashing use the instant.
+	//
+	struct ItsDateTime
+	{
+	private:
+		int64_t m_ns{ 0 };
+		int32_t m_offset{ 0 };
 
+		static constexpr int64_t NanosecondsPerSecond = 1'000'000'000LL;
+		static constexpr int64_t NanosecondsPerDay = 86'400LL * NanosecondsPerSecond;
+
+	public:
+		static constexpr int64_t MinUnixNanoseconds = ItsCivil::DaysFromCivil(1677, 9, 22) * NanosecondsPerDay;
+		static constexpr int64_t MaxUnixNanoseconds = ItsCivil::DaysFromCivil(2262, 4, 11) * NanosecondsPerDay - 1;
+		static constexpr int32_t MaxOffsetSeconds = 18 * 3'600;
+
+		static constexpr bool IsInRange(int64_t unixNanoseconds, int32_t offsetSeconds)
+		{
+			return unixNanoseconds >= MinUnixNanoseconds && unixNanoseconds <= MaxUnixNanoseconds &&
+				offsetSeconds >= -MaxOffsetSeconds && offsetSeconds <= MaxOffsetSeconds;
+		}
+
+	private:
+		static constexpr int64_t FloorDivide(int64_t value, int64_t divisor)
+		{
+			return value / divisor - ((value % divisor < 0) ? 1 : 0);
+		}
+
+		//
+		// Wall clock fields at offsetSeconds to UTC nanoseconds. Out of range months, days and
+		// times are normalized. Throws std::invalid_argument when the result is out of range.
+		//
+		static constexpr int64_t WallToNanoseconds(int64_t year, int64_t month, int64_t day, int64_t hour, int64_t minute, int64_t second, int64_t nanosecond, int32_t offsetSeconds)
+		{
+			int64_t months = year * 12 + (month - 1);
+			int64_t y = ItsDateTime::FloorDivide(months, 12);
+			int64_t m = months - y * 12 + 1;
+
+			// Normalizing int days and times moves the date by less than 6'000'000 years.
+			if (y < -10'000'000 || y > 10'000'000 || offsetSeconds < -MaxOffsetSeconds || offsetSeconds > MaxOffsetSeconds) {
+				throw std::invalid_argument("ItsDateTime: date, time or offset out of range");
+			}
+			int64_t days = ItsCivil::DaysFromCivil(static_cast<int>(y), static_cast<int>(m), 1) + (day - 1);
+			int64_t carry = ItsDateTime::FloorDivide(nanosecond, NanosecondsPerSecond);
+			int64_t seconds = days * 86'400 + (hour * 60 + minute) * 60 + second + carry - offsetSeconds;
+			if (seconds < MinUnixNanoseconds / NanosecondsPerSecond || seconds > MaxUnixNanoseconds / NanosecondsPerSecond) {
+				throw std::invalid_argument("ItsDateTime: date, time or offset out of range");
+			}
+			return seconds * NanosecondsPerSecond + (nanosecond - carry * NanosecondsPerSecond);
+		}
+
+		//
+		// Checked arithmetic on in range instants. Throws std::overflow_error when the result
+		// is out of range.
+		//
+		static constexpr int64_t CheckedMultiply(int64_t count, int64_t unit)
+		{
+			if (count > std::numeric_limits<int64_t>::max() / unit || count < std::numeric_limits<int64_t>::min() / unit) {
+				throw std::overflow_error("ItsDateTime: result out of range");
+			}
+			return count * unit;
+		}
+
+		static constexpr int64_t CheckedAdd(int64_t ns, int64_t delta)
+		{
+			if ((delta > 0 && ns > MaxUnixNanoseconds - delta) || (delta < 0 && ns < MinUnixNanoseconds - delta)) {
+				throw std::overflow_error("ItsDateTime: result out of range");
+			}
+			return ns + delta;
+		}
+
+		static constexpr int64_t CheckedSubtract(int64_t ns, int64_t delta)
+		{
+			if ((delta < 0 && ns > MaxUnixNanoseconds + delta) || (delta > 0 && ns < MinUnixNanoseconds + delta)) {
+				throw std::overflow_error("ItsDateTime: result out of range");
+			}
+			return ns - delta;
+		}
+
+		constexpr int64_t LocalNanoseconds() const
+		{
+			return this->m_ns + static_cast<int64_t>(this->m_offset) * NanosecondsPerSecond;
+		}
+
+		constexpr int64_t LocalDays() const
+		{
+			return ItsDateTime::FloorDivide(this->LocalNanoseconds(), NanosecondsPerDay);
+		}
+
+		constexpr int64_t LocalTimeOfDay() const
+		{
+			int64_t timeOfDay = this->LocalNanoseconds() % NanosecondsPerDay;
+			return (timeOfDay < 0) ? timeOfDay + NanosecondsPerDay : timeOfDay;
+		}
+
+		constexpr ItsCivil::Date LocalDate() const
+		{
+			return ItsCivil::CivilFromDays(this->LocalDays());
+		}
+
+		constexpr void AddCalendarMonths(int64_t month)
+		{
+			ItsCivil::Date date = this->LocalDate();
+			int64_t months = static_cast<int64_t>(date.Year) * 12 + (date.Month - 1) + month;
+			int64_t year = ItsDateTime::FloorDivide(months, 12);
+			if (year < 1677 || year > 2262) {
+				throw std::overflow_error("ItsDateTime: result out of range");
+			}
+			int mon = static_cast<int>(months - year * 12 + 1);
+			int day = std::min(date.Day, ItsCivil::DaysInMonth(static_cast<int>(year), mon));
+			int64_t days = ItsCivil::DaysFromCivil(static_cast<int>(year), mon, day);
+			this->m_ns = ItsDateTime::CheckedAdd(this->m_ns, (days - this->LocalDays()) * NanosecondsPerDay);
+		}
+
+	public:
+		constexpr ItsDateTime() = default;
+
+		//
+		// tm holds the wall clock time at offsetSeconds. tm_wday, tm_yday and tm_isdst are ignored.
+		//
+		explicit ItsDateTime(const tm& timeDate, int32_t offsetSeconds = 0)
+			: m_ns(ItsDateTime::WallToNanoseconds(timeDate.tm_year + 1900LL, timeDate.tm_mon + 1LL, timeDate.tm_mday, timeDate.tm_hour, timeDate.tm_min, timeDate.tm_sec, 0, offsetSeconds)),
+			  m_offset(offsetSeconds)
+		{
+		}
+
+		constexpr ItsDateTime(int year, int month, int day, int hour = 0, int minute = 0, int second = 0, int nanosecond = 0, int32_t offsetSeconds = 0)
+			: m_ns(ItsDateTime::WallToNanoseconds(year, month, day, hour, minute, second, nanosecond, offsetSeconds)),
+			  m_offset(offsetSeconds)
+		{
+		}
+
+		static constexpr ItsDateTime FromUnixNanoseconds(int64_t nanoseconds, int32_t offsetSeconds = 0)
+		{
+			if (!ItsDateTime::IsInRange(nanoseconds, offsetSeconds)) {
+				throw std::invalid_argument("ItsDateTime: date, time or offset out of range");
+			}
+			ItsDateTime dateTime;
+			dateTime.m_ns = nanoseconds;
+			dateTime.m_offset = offsetSeconds;
+			return dateTime;
+		}
+
+		static ItsDateTime FromSYSTEMTIME(const SYSTEMTIME& st, int32_t offsetSeconds = 0)
+		{
+			return ItsDateTime(st.wYear, st.wMonth, st.wDay, st.wHour, st.wMinute, st.wSecond, st.wMilliseconds * 1'000'000, offsetSeconds);
+		}
+
+		//
+		// Local time; the offset is that of the process time zone at this instant.
+		//
+		static ItsDateTime Now(ItsClockMode mode = ItsClockMode::Precise)
+		{
+			int64_t ns = ItsClock::UtcNanoseconds(mode);
+			return ItsDateTime::FromUnixNanoseconds(ns, ItsClock::LocalOffsetSeconds(ns));
+		}
+
+		static ItsDateTime UtcNow(ItsClockMode mode = ItsClockMode::Precise)
+		{
+			return ItsDateTime::FromUnixNanoseconds(ItsClock::UtcNanoseconds(mode));
+		}
+
+		constexpr bool operator==(const ItsDateTime& other) const
+		{
+			return this->m_ns == other.m_ns;
+		}
+
+		constexpr std::strong_ordering operator<=>(const ItsDateTime& other) const
+		{
+			return this->m_ns <=> other.m_ns;
+		}
+
+		constexpr ItsDateTime operator+(ItsDuration duration) const
+		{
+			return ItsDateTime::FromUnixNanoseconds(ItsDateTime::CheckedAdd(this->m_ns, duration.TotalNanoseconds()), this->m_offset);
+		}
+
+		constexpr ItsDateTime operator-(ItsDuration duration) const
+		{
+			return ItsDateTime::FromUnixNanoseconds(ItsDateTime::CheckedSubtract(this->m_ns, duration.TotalNanoseconds()), this->m_offset);
+		}
+
+		//
+		// Throws std::overflow_error when the instants are more than ItsDuration can hold apart.
+		//
+		constexpr ItsDuration operator-(const ItsDateTime& other) const
+		{
+			if ((other.m_ns < 0 && this->m_ns > std::numeric_limits<int64_t>::max() + other.m_ns) ||
+				(other.m_ns > 0 && this->m_ns < std::numeric_limits<int64_t>::min() + other.m_ns)) {
+				throw std::overflow_error("ItsDateTime: result out of range");
+			}
+			return ItsDuration(this->m_ns - other.m_ns);
+		}
+
+		constexpr ItsDateTime& operator+=(ItsDuration duration)
+		{
+			this->m_ns = ItsDateTime::CheckedAdd(this->m_ns, duration.TotalNanoseconds());
+			return *this;
+		}
+
+		constexpr ItsDateTime& operator-=(ItsDuration duration)
+		{
+			this->m_ns = ItsDateTime::CheckedSubtract(this->m_ns, duration.TotalNanoseconds());
+			return *this;
+		}
+
+		size_t Hash() const
+		{
+			return std::hash<int64_t>{}(this->m_ns);
+		}
+
+		explicit operator wstring() const {
+			return this->ToString(L"s");
+		}
+
+		wstring ToString() const
+		{
+			static constexpr ItsDateTimeFormat format(L"yyyy-MM-dd HH:mm:ss");
+			return this->ToString(format);
+		}
+
+		//
+		// "s" or "S" gives ISO-8601; anything else is an ItsDateTimeFormat pattern.
+		//
+		wstring ToString(const wstring& option) const
+		{
+			if (option == L"s" || option == L"S")
+			{
+				return ItsConvert::ToString(this->TM());
+			}
+
+			ItsDateTimeFormat format(option);
+			if (!format.IsValid()) {
+				throw std::invalid_argument("ItsDateTime: invalid format pattern");
+			}
+			return this->ToString(format);
+		}
+
+		wstring ToString(const ItsDateTimeFormat& format) const
+		{
+			wchar_t buffer[ItsDateTimeFormat::MaxLength];
+			size_t length = format.Format(this->m_ns, this->m_offset, buffer);
+			return wstring(buffer, length);
+		}
+
+		//
+		// Allocation free; buffer must hold format.MaxFormattedLength() characters.
+		//
+		template<typename Char>
+		constexpr size_t Format(const ItsDateTimeFormat& format, Char* buffer) const
+		{
+			return format.Format(this->m_ns, this->m_offset, buffer);
+		}
+
+		static constexpr bool Parse(const ItsDateTimeFormat& format, std::wstring_view text, ItsDateTime* dateTime)
+		{
+			int64_t ns = 0;
+			int32_t offset = 0;
+			if (dateTime == nullptr || !format.Parse(text.data(), text.size(), &ns, &offset) || !ItsDateTime::IsInRange(ns, offset)) {
+				return false;
 			}
+			*dateTime = ItsDateTime::FromUnixNanoseconds(ns, offset);
+			return true;
+		}
 
-			txt = ss.str();
-			wstringstream ss2;
-			for (auto itr = txt.rbegin(); itr < txt.rend(); itr++)
-			{
-				ss2 << *itr;
+		static bool Parse(std::wstring_view pattern, std::wstring_view text, ItsDateTime* dateTime)
+		{
+			return ItsDateTime::Parse(ItsDateTimeFormat(pattern), text, dateTime);
+		}
+
+		static ItsDateTime Parse(const wstring& pattern, const wstring& text)
+		{
+			ItsDateTime dateTime;
+			if (!ItsDateTime::Parse(std::wstring_view(pattern), std::wstring_view(text), &dateTime)) {
+				throw std::invalid_argument("ItsDateTime: text does not match the format pattern");
 			}
+			return dateTime;
+		}
 
-			wstring retVal = ss2.str();
+		//
+		// Wall clock fields at the offset. tm_isdst is -1 (unknown).
+		//
+		constexpr tm TM() const
+		{
+			ItsCivil::Date date = this->LocalDate();
+			int64_t seconds = this->LocalTimeOfDay() / NanosecondsPerSecond;
+			tm t{};
+			t.tm_year = date.Year - 1900;
+			t.tm_mon = date.Month - 1;
+			t.tm_mday = date.Day;
+			t.tm_hour = static_cast<int>(seconds / 3600);
+			t.tm_min = static_cast<int>(seconds / 60 % 60);
+			t.tm_sec = static_cast<int>(seconds % 60);
+			t.tm_wday = ItsCivil::WeekdayFromDays(this->LocalDays());
+			t.tm_yday = ItsCivil::DayOfYear(date.Year, date.Month, date.Day);
+			t.tm_isdst = -1;
+			return t;
+		}
 
-			return retVal;
+		SYSTEMTIME ToSYSTEMTIME() const
+		{
+			ItsCivil::Date date = this->LocalDate();
+			int64_t timeOfDay = this->LocalTimeOfDay();
+			int64_t seconds = timeOfDay / NanosecondsPerSecond;
+			SYSTEMTIME st = { 0 };
+			st.wYear = static_cast<WORD>(date.Year);
+			st.wMonth = static_cast<WORD>(date.Month);
+			st.wDayOfWeek = static_cast<WORD>(ItsCivil::WeekdayFromDays(this->LocalDays()));
+			st.wDay = static_cast<WORD>(date.Day);
+			st.wHour = static_cast<WORD>(seconds / 3600);
+			st.wMinute = static_cast<WORD>(seconds / 60 % 60);
+			st.wSecond = static_cast<WORD>(seconds % 60);
+			st.wMilliseconds = static_cast<WORD>(timeOfDay % NanosecondsPerSecond / 1'000'000);
+			return st;
 		}
 
-		template<typename Numeric>
-		static string ToHexString(Numeric number, bool uppercase = true, uint32_t width = 0, wchar_t fillChar = L'0', bool showBase = false)
+		constexpr int64_t UnixNanoseconds() const
 		{
-			wstringstream ss;
-			ss << std::hex;
-			if (showBase)
-			{
-				ss << "0x";
-			}
-			if (uppercase)
-			{
-				ss << std::uppercase;
-			}
-			if (width > 0)
-			{
-				ss << std::setfill(fillChar) << std::setw(width);
-			}
-			ss << number;
+			return this->m_ns;
+		}
 
-			wstring tos = ss.str();
-			return tos;
+		constexpr int32_t OffsetSeconds() const
+		{
+			return this->m_offset;
 		}
 
-		static wstring ToString(tm dateTime) {
-			wstringstream ss;
-			ss << std::setfill(L'0') << std::setw(4) << (dateTime.tm_year + 1900);
-			ss << L"-" << std::setfill(L'0') << std::setw(2) << (dateTime.tm_mon + 1);
-			ss << L"-" << std::setfill(L'0') << std::setw(2) << dateTime.tm_mday;
-			ss << L"T";
-			ss << std::setfill(L'0') << std::setw(2) << dateTime.tm_hour;
-			ss << L":" << std::setfill(L'0') << std::setw(2) << dateTime.tm_min;
-			ss << L":" << std::setfill(L'0') << std::setw(2) << dateTime.tm_sec;
+		//
+		// Same instant viewed at another offset.
+		//
+		constexpr ItsDateTime ToOffset(int32_t offsetSeconds) const
+		{
+			return ItsDateTime::FromUnixNanoseconds(this->m_ns, offsetSeconds);
+		}
 
-			wstring tos = ss.str();
-			return tos;
+		constexpr ItsDateTime ToUtc() const
+		{
+			return ItsDateTime::FromUnixNanoseconds(this->m_ns);
 		}
 
-		static tm ToTM(const wstring& dateTime)
+		//
+		// The Add and Subtract methods throw std::overflow_error when the result is out of range
+		// and leave the value unchanged.
+		//
+		constexpr void AddYears(int year)
 		{
-			tm t = { 0 };
+			this->AddCalendarMonths(year * 12LL);
+		}
 
-			t.tm_year = ItsConvert::ToNumber<int>(dateTime.substr(0, 4)) - 1900;
-			t.tm_mon = ItsConvert::ToNumber<int>(dateTime.substr(5, 2)) - 1;
-			t.tm_mday = ItsConvert::ToNumber<int>(dateTime.substr(8, 2));
-			t.tm_hour = ItsConvert::ToNumber<int>(dateTime.substr(11, 2));
-			t.tm_min = ItsConvert::ToNumber<int>(dateTime.substr(14, 2));
-			t.tm_sec = ItsConvert::ToNumber<int>(dateTime.substr(17, 2));
+		//
+		// Calendar months; the day is clamped to the length of the target month (Jan 31 + 1 = Feb 28/29).
+		//
+		constexpr void AddMonths(int month)
+		{
+			this->AddCalendarMonths(month);
+		}
 
-			return t;
+		constexpr void AddDays(int day)
+		{
+			this->m_ns = ItsDateTime::CheckedAdd(this->m_ns, ItsDateTime::CheckedMultiply(day, NanosecondsPerDay));
 		}
 
-		static bool ToBool(wstring flag) {
+		constexpr void AddHours(int hour)
+		{
+			this->m_ns = ItsDateTime::CheckedAdd(this->m_ns, ItsDateTime::CheckedMultiply(hour * 3'600LL, NanosecondsPerSecond));
+		}
 
-			flag = ItsString::ToLowerCase(flag);
+		constexpr void AddMinutes(int min)
+		{
+			this->m_ns = ItsDateTime::CheckedAdd(this->m_ns, ItsDateTime::CheckedMultiply(min * 60LL, NanosecondsPerSecond));
+		}
 
-			if (!wcscmp(flag.c_str(), L"true")) {
-				return true;
-			}
-			else if (!wcscmp(flag.c_str(), L"1")) {
-				return true;
-			}
-			else if (!wcscmp(flag.c_str(), L"yes")) {
-				return true;
-			}
-			else if (!wcscmp(flag.c_str(), L"on")) {
-				return true;
-			}
-			return false;
+		constexpr void AddSeconds(int sec)
+		{
+			this->m_ns = ItsDateTime::CheckedAdd(this->m_ns, sec * NanosecondsPerSecond);
 		}
 
-		static COLORREF ToRGB(wstring color)
+		constexpr void Add(int year, int month, int day, int hour, int min, int sec)
 		{
-			auto rgb = ItsString::Split(color, L",");
-			return (COLORREF)(RGB(ItsConvert::ToNumber<int>(rgb[0]), ItsConvert::ToNumber<int>(rgb[1]), ItsConvert::ToNumber<int>(rgb[2])));
+			ItsDateTime result = *this;
+			result.AddCalendarMonths(year * 12LL + month);
+			result.m_ns = ItsDateTime::CheckedAdd(result.m_ns, ItsDateTime::CheckedMultiply(((day * 24LL + hour) * 60LL + min) * 60LL + sec, NanosecondsPerSecond));
+			*this = result;
 		}
 
-		static wstring ToString(vector<long long> pks)
+		constexpr void SubtractYears(int year)
 		{
-			wstringstream ss;
-			bool bAddSep = false;
-			for (const auto& pk : pks) {
-				if (bAddSep) {
-					ss << L";";
-				}
-				ss << pk;
-				bAddSep = true;
-			}
-			wstring tos = ss.str();
-			return tos;
+			this->AddCalendarMonths(-(year * 12LL));
 		}
 
-		static vector<long long> ToPK(wstring pks)
+		constexpr void SubtractMonths(int month)
 		{
-			//using convert_typeX = std::codecvt_utf8<wchar_t>;
-			//std::wstring_convert<convert_typeX, wchar_t> converterX;
+			this->AddCalendarMonths(-static_cast<int64_t>(month));
+		}
 
-			stringstream ss;
-			//string s = converterX.to_bytes(pks);
-			std::string s = ItSoftware::Encoding::UTF8::ToString(pks);
-			ss << s;
+		constexpr void SubtractDays(int day)
+		{
+			this->m_ns = ItsDateTime::CheckedSubtract(this->m_ns, ItsDateTime::CheckedMultiply(day, NanosecondsPerDay));
+		}
 
-			string item;
-			vector<long long> topk;
-			while (getline(ss, item, ';'))
-			{
-				if (!item.empty())
-				{
-					topk.push_back(ItsConvert::ToNumber<long long>(wstring(item.begin(), item.end())));
-				}
-			}
+		constexpr void SubtractHours(int hour)
+		{
+			this->m_ns = ItsDateTime::CheckedSubtract(this->m_ns, ItsDateTime::CheckedMultiply(hour * 3'600LL, NanosecondsPerSecond));
+		}
 
-			return topk;
+		constexpr void SubtractMinutes(int min)
+		{
+			this->m_ns = ItsDateTime::CheckedSubtract(this->m_ns, ItsDateTime::CheckedMultiply(min * 60LL, NanosecondsPerSecond));
 		}
 
-		static SYSTEMTIME ToSYSTEMTIME(tm dateTime)
+		constexpr void SubtractSeconds(int sec)
 		{
-			SYSTEMTIME st = { 0 };
+			this->m_ns = ItsDateTime::CheckedSubtract(this->m_ns, sec * NanosecondsPerSecond);
+		}
 
-			st.wYear = static_cast<WORD>(dateTime.tm_year + 1900);
-			st.wMonth = static_cast<WORD>(dateTime.tm_mon + 1);
-			st.wDay = static_cast<WORD>(dateTime.tm_mday);
-			st.wHour = static_cast<WORD>(dateTime.tm_hour);
-			st.wMinute = static_cast<WORD>(dateTime.tm_min);
-			st.wSecond = static_cast<WORD>(dateTime.tm_sec);
+		constexpr void Subtract(int year, int month, int day, int hour, int min, int sec)
+		{
+			ItsDateTime result = *this;
+			result.AddCalendarMonths(-(year * 12LL + month));
+			result.m_ns = ItsDateTime::CheckedSubtract(result.m_ns, ItsDateTime::CheckedMultiply(((day * 24LL + hour) * 60LL + min) * 60LL + sec, NanosecondsPerSecond));
+			*this = result;
+		}
 
-			return st;
+		constexpr int GetYear() const
+		{
+			return this->LocalDate().Year;
 		}
 
-		static tm ToTM(SYSTEMTIME st)
+		constexpr int GetMonth() const
 		{
-			tm t = { 0 };
+			return this->LocalDate().Month;
+		}
 
-			t.tm_year = st.wYear - 1900;
-			t.tm_mon = st.wMonth - 1;
-			t.tm_mday = st.wDay;
-			t.tm_hour = st.wHour;
-			t.tm_min = st.wMinute;
-			t.tm_sec = st.wSecond;
+		constexpr int GetDay() const
+		{
+			return this->LocalDate().Day;
+		}
 
-			return t;
+		constexpr int GetHour() const
+		{
+			return static_cast<int>(this->LocalTimeOfDay() / (3'600LL * NanosecondsPerSecond));
 		}
-	};
 
-	//
-	// Function: ItsRandom
-	//
-	// (i): A random number wrapper.
-	//
-	template<typename Numeric, typename Generator = std::mt19937>
-	Numeric ItsRandom(Numeric from, Numeric to)
-	{
-		thread_local static Generator gen(std::random_device{}());
+		constexpr int GetMinute() const
+		{
+			return static_cast<int>(this->LocalTimeOfDay() / (60LL * NanosecondsPerSecond) % 60);
+		}
 
-		using dist_type = typename std::conditional
-			<
-			std::is_integral<Numeric>::value
-			, std::uniform_int_distribution<Numeric>
-			, std::uniform_real_distribution<Numeric>
-			>::type;
+		constexpr int GetSecond() const
+		{
+			return static_cast<int>(this->LocalTimeOfDay() / NanosecondsPerSecond % 60);
+		}
 
-		thread_local static dist_type dist{};
+		constexpr int GetNanosecond() const
+		{
+			return static_cast<int>(this->LocalTimeOfDay() % NanosecondsPerSecond);
+		}
+
+		//
+		// 0 = Sunday ... 6 = Saturday.
+		//
+		constexpr int GetDayOfWeek() const
+		{
+			return ItsCivil::WeekdayFromDays(this->LocalDays());
+		}
+
+		//
+		// 1 = January 1st.
+		//
+		constexpr int GetDayOfYear() const
+		{
+			ItsCivil::Date date = this->LocalDate();
+			return ItsCivil::DayOfYear(date.Year, date.Month, date.Day) + 1;
+		}
+
+		ItsDateTime& operator=(const tm& timeDate)
+		{
+			*this = ItsDateTime(timeDate);
+			return *this;
+		}
+	};
 
-		return dist(gen, typename dist_type::param_type{ from, to });
-	}
 
 	//
-	// struct: ItsDateTime
+	// struct: ItsTimeZone
 	//
-	// (i): Represents a date and time.
+	// (i): IANA time zone read from a TZif file (RFC 8536) under Directory() or from an embedded
+	//      copy. Transitions after the table are generated from the POSIX TZ footer up to 2262.
+	//      Zones are parsed once, kept in a lock-free list and never freed. Conversions are a
+	//      binary search over UTC seconds behind a shared last-hit index; no locks, no TZ state.
+	//      A default constructed ItsTimeZone is UTC.
 	//
-	struct ItsDateTime
+	struct ItsTimeZone
 	{
 	private:
-		tm m_tm;
+		struct Type
+		{
+			int32_t Offset{ 0 };
+			bool IsDst{ false };
+			uint16_t Abbreviation{ 0 };
+		};
 
-	public:
-		explicit ItsDateTime(tm timeDate)
+		struct Zone
 		{
-			this->m_tm = timeDate;
-		}
+			string Name;
+			vector<int64_t> Times;
+			vector<uint8_t> Types;
+			vector<Type> TypeInfo;
+			string Abbreviations;
+			mutable std::atomic<size_t> LastHit{ 0 };
+			Zone* Next{ nullptr };
+		};
+
+		//
+		// POSIX TZ date: Jn (1-365, no Feb 29), n (0-365) or Mm.w.d.
+		//
+		struct Rule
+		{
+			char Kind{ 'M' };
+			int Month{ 0 };
+			int Week{ 0 };
+			int Day{ 0 };
+			int32_t Time{ 7'200 };
+		};
+
+		struct Posix
+		{
+			string StdName;
+			string DstName;
+			int32_t StdOffset{ 0 };
+			int32_t DstOffset{ 0 };
+			bool HasDst{ false };
+			Rule Start;
+			Rule End;
+		};
+
+		static constexpr int LastYear = 2262;
+		static constexpr size_t MaxFileSize = 1 << 20;
+
+		const Zone* m_zone{ nullptr };
 
-		explicit ItsDateTime(const ItsDateTime& dateTime)
+		explicit ItsTimeZone(const Zone* zone)
+			: m_zone(zone)
 		{
-			this->m_tm = dateTime.m_tm;
 		}
-		
-		static ItsDateTime Now()
+
+		static std::atomic<Zone*>& Zones()
 		{
-			time_t t;
-			time(&t);
-			tm tm2{ 0 };
-			localtime_s(&tm2, &t);
+			static std::atomic<Zone*> zones{ nullptr };
+			return zones;
+		}
 
-			return ItsDateTime(tm2);
+		static std::atomic<const string*>& DirectoryPath()
+		{
+			static std::atomic<const string*> directory{ nullptr };
+			return directory;
 		}
 
-		bool operator==(const ItsDateTime& other)
+		//
+		// Publishes candidate if no directory is fixed yet. Returns the fixed directory.
+		//
+		static const string* FixDirectory(const string* candidate)
 		{
-			if (this->m_tm.tm_year == other.m_tm.tm_year &&
-				this->m_tm.tm_mon == other.m_tm.tm_mon &&
-				this->m_tm.tm_mday == other.m_tm.tm_mday &&
-				this->m_tm.tm_hour == other.m_tm.tm_hour &&
-				this->m_tm.tm_min == other.m_tm.tm_min &&
-				this->m_tm.tm_sec == other.m_tm.tm_sec &&
-				this->m_tm.tm_wday == other.m_tm.tm_wday &&
-				this->m_tm.tm_isdst == other.m_tm.tm_isdst &&
-				this->m_tm.tm_yday == other.m_tm.tm_yday) {
-				return true;
+			const string* expected = nullptr;
+			if (ItsTimeZone::DirectoryPath().compare_exchange_strong(expected, candidate, std::memory_order_acq_rel, std::memory_order_acquire)) {
+				return candidate;
 			}
-			return false;
+			return expected;
 		}
 
-		bool operator!=(const ItsDateTime& other)
+		static const Zone* Lookup(std::string_view name)
 		{
-			if (this->m_tm.tm_year == other.m_tm.tm_year &&
-				this->m_tm.tm_mon == other.m_tm.tm_mon &&
-				this->m_tm.tm_mday == other.m_tm.tm_mday &&
-				this->m_tm.tm_hour == other.m_tm.tm_hour &&
-				this->m_tm.tm_min == other.m_tm.tm_min &&
-				this->m_tm.tm_sec == other.m_tm.tm_sec &&
-				this->m_tm.tm_wday == other.m_tm.tm_wday &&
-				this->m_tm.tm_isdst == other.m_tm.tm_isdst &&
-				this->m_tm.tm_yday == other.m_tm.tm_yday) {
-				return false;
+			for (const Zone* zone = ItsTimeZone::Zones().load(std::memory_order_acquire); zone != nullptr; zone = zone->Next)
+			{
+				if (zone->Name == name) {
+					return zone;
+				}
 			}
-			return true;
+			return nullptr;
 		}
 
-		const ItsDateTime& operator=(const ItsDateTime& other)
+		//
+		// A racing load of the same name may register twice; lookups return the newest.
+		//
+		static const Zone* Register(Zone* zone)
 		{
-			this->m_tm.tm_year = other.m_tm.tm_year;
-			this->m_tm.tm_mon = other.m_tm.tm_mon;
-			this->m_tm.tm_mday = other.m_tm.tm_mday;
-			this->m_tm.tm_hour = other.m_tm.tm_hour;
-			this->m_tm.tm_min = other.m_tm.tm_min;
-			this->m_tm.tm_sec = other.m_tm.tm_sec;
-			this->m_tm.tm_wday = other.m_tm.tm_wday;
-			this->m_tm.tm_isdst = other.m_tm.tm_isdst;
-			this->m_tm.tm_yday = other.m_tm.tm_yday;
-
-			return *this;
+			zone->Next = ItsTimeZone::Zones().load(std::memory_order_relaxed);
+			while (!ItsTimeZone::Zones().compare_exchange_weak(zone->Next, zone, std::memory_order_release, std::memory_order_relaxed)) {
+			}
+			return zone;
 		}
 
-		explicit operator wstring() {
-			return this->ToString(L"s");
+		static int64_t FloorSeconds(int64_t nanoseconds)
+		{
+			return (nanoseconds >= 0) ? nanoseconds / 1'000'000'000LL : -((-nanoseconds + 999'999'999LL) / 1'000'000'000LL);
 		}
 
-		wstring ToString()
+		static uint32_t GetUInt32(const uint8_t* p)
 		{
-			wstringstream ss;
-			ss << std::setfill(L'0') << std::setw(4) << (this->m_tm.tm_year + 1900);
-			ss << L"-" << std::setfill(L'0') << std::setw(2) << (this->m_tm.tm_mon + 1);
-			ss << L"-" << std::setfill(L'0') << std::setw(2) << this->m_tm.tm_mday;
-			ss << L" ";
-			ss << std::setfill(L'0') << std::setw(2) << this->m_tm.tm_hour;
-			ss << L":" << std::setfill(L'0') << std::setw(2) << this->m_tm.tm_min;
-			ss << L":" << std::setfill(L'0') << std::setw(2) << this->m_tm.tm_sec;
-
-			wstring tos = ss.str();
-			return tos;
+			return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) | (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
 		}
 
-		wstring ToString(wstring option)
+		static int64_t GetInt64(const uint8_t* p)
 		{
-			if (option == L"s" || option == L"S")
-			{
-				wstringstream ss;
-				ss << std::setfill(L'0') << std::setw(4) << (this->m_tm.tm_year + 1900);
-				ss << L"-" << std::setfill(L'0') << std::setw(2) << (this->m_tm.tm_mon + 1);
-				ss << L"-" << std::setfill(L'0') << std::setw(2) << this->m_tm.tm_mday;
-				ss << L"T";
-				ss << std::setfill(L'0') << std::setw(2) << this->m_tm.tm_hour;
-				ss << L":" << std::setfill(L'0') << std::setw(2) << this->m_tm.tm_min;
-				ss << L":" << std::setfill(L'0') << std::setw(2) << this->m_tm.tm_sec;
-
-				wstring tos = ss.str();
-				return tos;
-			}
+			return static_cast<int64_t>((static_cast<uint64_t>(ItsTimeZone::GetUInt32(p)) << 32) | ItsTimeZone::GetUInt32(p + 4));
+		}
 
-			// day
-			int d = this->GetDay();
-			wstring str_d = ItsConvert::ToString(d);
-			wstring str_dd;
-			if (d < 10)
-			{
-				str_dd = L"0";
-				str_dd += str_d;
+		static bool IsValidName(std::string_view name)
+		{
+			if (name.empty() || name.front() == '/' || name.find("..") != std::string_view::npos) {
+				return false;
 			}
-			else
+			for (char c : name)
 			{
-				str_dd = str_d;
+				if (!((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '/' || c == '_' || c == '-' || c == '+')) {
+					return false;
+				}
 			}
+			return true;
+		}
 
-			// month
-			int m = this->GetMonth();
-			wstring str_m = ItsConvert::ToString(m);
-			wstring str_mm;
-			if (m < 10)
-			{
-				str_mm = L"0";
-				str_mm += str_m;
-			}
-			else
-			{
-				str_mm = str_m;
+		static bool ParseNumber(std::string_view text, size_t& i, int maxValue, int& value)
+		{
+			size_t start = i;
+			value = 0;
+			while (i < text.size() && text[i] >= '0' && text[i] <= '9') {
+				value = value * 10 + (text[i++] - '0');
+				if (value > maxValue) {
+					return false;
+				}
 			}
+			return i > start;
+		}
 
-			// year
-			int y = this->GetYear();
-			wstring str_yyyy = ItsConvert::ToString(y);
-			wstring str_yy = ItsString::Right(str_yyyy, 2);
-
-			// hour			
-			int h = this->GetHour();
-			wstring str_h = ItsConvert::ToString(h);
-			wstring str_hh;
-			if (h < 10)
-			{
-				str_hh = L"0";
-				str_hh += str_h;
+		static bool ParseAbbreviation(std::string_view text, size_t& i, string& name)
+		{
+			size_t start = i;
+			if (i < text.size() && text[i] == '<') {
+				size_t end = text.find('>', i);
+				if (end == std::string_view::npos) {
+					return false;
+				}
+				name = string(text.substr(i + 1, end - i - 1));
+				i = end + 1;
+				return !name.empty();
 			}
-			else
-			{
-				str_hh = str_h;
+			while (i < text.size() && ((text[i] >= 'A' && text[i] <= 'Z') || (text[i] >= 'a' && text[i] <= 'z'))) {
+				i++;
 			}
+			name = string(text.substr(start, i - start));
+			return name.size() >= 3;
+		}
 
-			// minute
-			int min = this->GetMinute();
-			wstring str_min = ItsConvert::ToString(min);
-			wstring str_minmin;
-			if (min < 10)
-			{
-				str_minmin = L"0";
-				str_minmin += str_min;
-			}
-			else
-			{
-				str_minmin = str_min;
+		//
+		// [+|-]hh[:mm[:ss]] in seconds.
+		//
+		static bool ParseTime(std::string_view text, size_t& i, int maxHours, int32_t& seconds)
+		{
+			bool negative = false;
+			if (i < text.size() && (text[i] == '+' || text[i] == '-')) {
+				negative = text[i++] == '-';
 			}
-
-			// second
-			int s = this->GetSecond();
-			wstring str_s = ItsConvert::ToString(s);
-			wstring str_ss;
-			if (s < 10)
-			{
-				str_ss = L"0";
-				str_ss += str_s;
+			int hours = 0;
+			int minutes = 0;
+			int secs = 0;
+			if (!ItsTimeZone::ParseNumber(text, i, maxHours, hours)) {
+				return false;
 			}
-			else
-			{
-				str_ss = str_s;
+			if (i < text.size() && text[i] == ':') {
+				i++;
+				if (!ItsTimeZone::ParseNumber(text, i, 59, minutes)) {
+					return false;
+				}
+				if (i < text.size() && text[i] == ':') {
+					i++;
+					if (!ItsTimeZone::ParseNumber(text, i, 59, secs)) {
+						return false;
+					}
+				}
 			}
-
-			wstring wdd = wstring(L"dd");
-			wstring wd = wstring(L"d");
-			option = ItsString::Replace(option, wdd, str_dd);
-			option = ItsString::Replace(option, wd, str_d);
-
-			wstring wMM = wstring(L"MM");
-			wstring wM = wstring(L"M");
-			option = ItsString::Replace(option, wMM, str_mm);
-			option = ItsString::Replace(option, wM, str_m);
-
-			wstring wyyyy = wstring(L"yyyy");
-			wstring wyy = wstring(L"yy");
-			option = ItsString::Replace(option, wyyyy, str_yyyy);
-			option = ItsString::Replace(option, wyy, str_yy);
-
-			wstring wHH = wstring(L"HH");
-			wstring wH = wstring(L"H");
-			option = ItsString::Replace(option, wHH, str_hh);
-			option = ItsString::Replace(option, wH, str_h);
-
-			wstring wmm = wstring(L"mm");
-			wstring wm = wstring(L"m");
-			option = ItsString::Replace(option, wmm, str_minmin);
-			option = ItsString::Replace(option, wm, str_min);
-
-			wstring wss = wstring(L"ss");
-			wstring ws = wstring(L"s");
-			option = ItsString::Replace(option, wss, str_ss);
-			option = ItsString::Replace(option, ws, str_s);
-
-			return option;
+			seconds = (hours * 3'600 + minutes * 60 + secs) * (negative ? -1 : 1);
+			return true;
 		}
 
-		const tm& TM()
+		static bool ParseRule(std::string_view text, size_t& i, Rule& rule)
 		{
-			return this->m_tm;
+			if (i >= text.size()) {
+				return false;
+			}
+			if (text[i] == 'M') {
+				i++;
+				rule.Kind = 'M';
+				if (!ItsTimeZone::ParseNumber(text, i, 12, rule.Month) || rule.Month < 1 || i >= text.size() || text[i++] != '.' ||
+					!ItsTimeZone::ParseNumber(text, i, 5, rule.Week) || rule.Week < 1 || i >= text.size() || text[i++] != '.' ||
+					!ItsTimeZone::ParseNumber(text, i, 6, rule.Day)) {
+					return false;
+				}
+			}
+			else if (text[i] == 'J') {
+				i++;
+				rule.Kind = 'J';
+				if (!ItsTimeZone::ParseNumber(text, i, 365, rule.Day) || rule.Day < 1) {
+					return false;
+				}
+			}
+			else {
+				rule.Kind = 'D';
+				if (!ItsTimeZone::ParseNumber(text, i, 365, rule.Day)) {
+					return false;
+				}
+			}
+			rule.Time = 7'200;
+			if (i < text.size() && text[i] == '/') {
+				i++;
+				return ItsTimeZone::ParseTime(text, i, 167, rule.Time);
+			}
+			return true;
 		}
 
-		void AddYears(int year)
+		//
+		// std offset [dst [offset] [,start[/time],end[/time]]]. POSIX offsets are west of UTC.
+		//
+		static bool ParsePosix(std::string_view text, Posix& posix)
 		{
-			this->m_tm.tm_year += year;
+			size_t i = 0;
+			int32_t offset = 0;
+			if (!ItsTimeZone::ParseAbbreviation(text, i, posix.StdName) || !ItsTimeZone::ParseTime(text, i, 24, offset)) {
+				return false;
+			}
+			posix.StdOffset = -offset;
+			if (i == text.size()) {
+				return true;
+			}
 
-			mktime(&this->m_tm);
+			if (!ItsTimeZone::ParseAbbreviation(text, i, posix.DstName)) {
+				return false;
+			}
+			posix.HasDst = true;
+			posix.DstOffset = posix.StdOffset + 3'600;
+			if (i < text.size() && text[i] != ',') {
+				if (!ItsTimeZone::ParseTime(text, i, 24, offset)) {
+					return false;
+				}
+				posix.DstOffset = -offset;
+			}
+			if (i == text.size()) {
+				posix.Start.Month = 3;
+				posix.Start.Week = 2;
+				posix.End.Month = 11;
+				posix.End.Week = 1;
+				return true;
+			}
+			return text[i++] == ',' && ItsTimeZone::ParseRule(text, i, posix.Start) &&
+				i < text.size() && text[i++] == ',' && ItsTimeZone::ParseRule(text, i, posix.End) &&
+				i == text.size();
 		}
 
-		void AddMonths(int month)
+		//
+		// Local midnight of the rule's day in year, as days since 1970-01-01.
+		//
+		static int64_t RuleDay(const Rule& rule, int year)
 		{
-			this->m_tm.tm_mon += month;
-
-			mktime(&this->m_tm);
+			int64_t january1 = ItsCivil::DaysFromCivil(year, 1, 1);
+			if (rule.Kind == 'J') {
+				return january1 + rule.Day - 1 + ((ItsCivil::IsLeapYear(year) && rule.Day >= 60) ? 1 : 0);
+			}
+			if (rule.Kind == 'D') {
+				return january1 + rule.Day;
+			}
+			int64_t first = ItsCivil::DaysFromCivil(year, rule.Month, 1);
+			int day = 1 + (rule.Day - ItsCivil::WeekdayFromDays(first) + 7) % 7 + (rule.Week - 1) * 7;
+			if (day > ItsCivil::DaysInMonth(year, rule.Month)) {
+				day -= 7;
+			}
+			return first + day - 1;
 		}
 
-		void AddDays(int day)
+		static uint8_t FindType(Zone& zone, int32_t offset, bool isDst, const string& name)
 		{
-			this->m_tm.tm_mday += day;
-
-			mktime(&this->m_tm);
+			for (size_t t = 0; t < zone.TypeInfo.size(); t++)
+			{
+				const Type& type = zone.TypeInfo[t];
+				if (type.Offset == offset && type.IsDst == isDst && string(zone.Abbreviations.c_str() + type.Abbreviation) == name) {
+					return static_cast<uint8_t>(t);
+				}
+			}
+			Type type;
+			type.Offset = offset;
+			type.IsDst = isDst;
+			type.Abbreviation = static_cast<uint16_t>(zone.Abbreviations.size());
+			zone.Abbreviations += name;
+			zone.Abbreviations += '\0';
+			zone.TypeInfo.push_back(type);
+			return static_cast<uint8_t>(zone.TypeInfo.size() - 1);
 		}
 
-		void AddHours(int hour)
+		static void Extend(Zone& zone, const Posix& posix)
 		{
-			this->m_tm.tm_hour += hour;
+			if (!posix.HasDst || zone.TypeInfo.size() > 254 ||
+				std::max(std::abs(posix.StdOffset), std::abs(posix.DstOffset)) > ItsDateTime::MaxOffsetSeconds) {
+				return;
+			}
+			uint8_t stdType = ItsTimeZone::FindType(zone, posix.StdOffset, false, posix.StdName);
+			uint8_t dstType = ItsTimeZone::FindType(zone, posix.DstOffset, true, posix.DstName);
 
-			mktime(&this->m_tm);
+			int64_t last = zone.Times.empty() ? std::numeric_limits<int64_t>::min() : zone.Times.back();
+			int firstYear = zone.Times.empty() ? 1970 : ItsCivil::CivilFromDays(last / 86'400).Year;
+			for (int year = firstYear; year <= LastYear; year++)
+			{
+				int64_t start = ItsTimeZone::RuleDay(posix.Start, year) * 86'400 + posix.Start.Time - posix.StdOffset;
+				int64_t end = ItsTimeZone::RuleDay(posix.End, year) * 86'400 + posix.End.Time - posix.DstOffset;
+				int64_t times[2] = { std::min(start, end), std::max(start, end) };
+				uint8_t types[2] = { (start < end) ? dstType : stdType, (start < end) ? stdType : dstType };
+				for (int t = 0; t < 2; t++)
+				{
+					if (times[t] > last) {
+						zone.Times.push_back(times[t]);
+						zone.Types.push_back(types[t]);
+						last = times[t];
+					}
+				}
+			}
 		}
 
-		void AddMinutes(int min)
+		//
+		// RFC 8536: v1 header and 32-bit body, then for v2+ a second header, 64-bit body and footer.
+		//
+		static bool Parse(const uint8_t* data, size_t size, Zone& zone)
 		{
-			this->m_tm.tm_min += min;
-
-			mktime(&this->m_tm);
-		}
+			size_t pos = 0;
+			bool is64 = false;
+			while (true)
+			{
+				if (size - pos < 44 || memcmp(data + pos, "TZif", 4) != 0) {
+					return false;
+				}
+				uint8_t version = data[pos + 4];
+				size_t isutcnt = ItsTimeZone::GetUInt32(data + pos + 20);
+				size_t isstdcnt = ItsTimeZone::GetUInt32(data + pos + 24);
+				size_t leapcnt = ItsTimeZone::GetUInt32(data + pos + 28);
+				size_t timecnt = ItsTimeZone::GetUInt32(data + pos + 32);
+				size_t typecnt = ItsTimeZone::GetUInt32(data + pos + 36);
+				size_t charcnt = ItsTimeZone::GetUInt32(data + pos + 40);
+				size_t timeSize = is64 ? 8 : 4;
+				if (timecnt > MaxFileSize || typecnt == 0 || typecnt > 256 || charcnt == 0 || charcnt > MaxFileSize || leapcnt > MaxFileSize) {
+					return false;
+				}
+				size_t bodySize = timecnt * (timeSize + 1) + typecnt * 6 + charcnt + leapcnt * (timeSize + 4) + isstdcnt + isutcnt;
+				pos += 44;
+				if (size - pos < bodySize) {
+					return false;
+				}
 
-		void AddSeconds(int sec)
-		{
-			this->m_tm.tm_sec += sec;
+				if (version >= '2' && !is64) {
+					pos += bodySize;
+					is64 = true;
+					continue;
+				}
 
-			mktime(&this->m_tm);
+				const uint8_t* p = data + pos;
+				zone.Times.resize(timecnt);
+				zone.Types.resize(timecnt);
+				for (size_t t = 0; t < timecnt; t++, p += timeSize)
+				{
+					zone.Times[t] = is64 ? ItsTimeZone::GetInt64(p) : static_cast<int32_t>(ItsTimeZone::GetUInt32(p));
+					if (t > 0 && zone.Times[t] <= zone.Times[t - 1]) {
+						return false;
+					}
+				}
+				for (size_t t = 0; t < timecnt; t++, p++)
+				{
+					if (*p >= typecnt) {
+						return false;
+					}
+					zone.Types[t] = *p;
+				}
+				zone.TypeInfo.resize(typecnt);
+				for (size_t t = 0; t < typecnt; t++, p += 6)
+				{
+					zone.TypeInfo[t].Offset = static_cast<int32_t>(ItsTimeZone::GetUInt32(p));
+					zone.TypeInfo[t].IsDst = p[4] != 0;
+					zone.TypeInfo[t].Abbreviation = p[5];
+					if (p[5] >= charcnt || zone.TypeInfo[t].Offset < -ItsDateTime::MaxOffsetSeconds || zone.TypeInfo[t].Offset > ItsDateTime::MaxOffsetSeconds) {
+						return false;
+					}
+				}
+				zone.Abbreviations.assign(reinterpret_cast<const char*>(p), charcnt);
+				if (zone.Abbreviations.back() != '\0') {
+					zone.Abbreviations += '\0';
+				}
+				pos += bodySize;
+
+				if (is64 && pos < size && data[pos] == '\n') {
+					const uint8_t* begin = data + pos + 1;
+					const uint8_t* end = static_cast<const uint8_t*>(memchr(begin, '\n', size - pos - 1));
+					Posix posix;
+					if (end != nullptr && end > begin && ItsTimeZone::ParsePosix(std::string_view(reinterpret_cast<const char*>(begin), static_cast<size_t>(end - begin)), posix)) {
+						ItsTimeZone::Extend(zone, posix);
+					}
+				}
+				return true;
+			}
 		}
 
-		void Add(int year, int month, int day, int hour, int min, int sec)
+		const Type& TypeAt(int64_t utcSeconds) const
 		{
-			this->m_tm.tm_year += year;
-			this->m_tm.tm_mon += month;
-			this->m_tm.tm_mday += day;
-			this->m_tm.tm_hour += hour;
-			this->m_tm.tm_min += min;
-			this->m_tm.tm_sec += sec;
-
-			mktime(&this->m_tm);
-		}
+			static const Type utc;
+			if (this->m_zone == nullptr) {
+				return utc;
+			}
+			const Zone& zone = *this->m_zone;
+			const vector<int64_t>& times = zone.Times;
+			if (times.empty() || utcSeconds < times.front()) {
+				return zone.TypeInfo.front();
+			}
 
-		void SubtractYears(int year)
-		{
-			this->m_tm.tm_year -= year;
+			size_t hint = zone.LastHit.load(std::memory_order_relaxed);
+			if (hint < times.size() && times[hint] <= utcSeconds && (hint + 1 == times.size() || utcSeconds < times[hint + 1])) {
+				return zone.TypeInfo[zone.Types[hint]];
+			}
 
-			mktime(&this->m_tm);
+			size_t index = static_cast<size_t>(std::upper_bound(times.begin(), times.end(), utcSeconds) - times.begin()) - 1;
+			zone.LastHit.store(index, std::memory_order_relaxed);
+			return zone.TypeInfo[zone.Types[index]];
 		}
 
-		void SubtractMonths(int month)
-		{
-			this->m_tm.tm_mon -= month;
-
-			mktime(&this->m_tm);
-		}
+	public:
+		ItsTimeZone() = default;
 
-		void SubtractDays(int day)
+		//
+		// Zone files are read from here. The directory is fixed by the first SetDirectory call
+		// or the first read (Directory, or a Load that opens a file) and never changes after
+		// that, so any thread may read it. SetDirectory returns false once it is fixed.
+		//
+		static bool SetDirectory(const string& directory)
 		{
-			this->m_tm.tm_mday -= day;
-
-			mktime(&this->m_tm);
+			std::unique_ptr<const string> candidate = std::make_unique<const string>(directory);
+			if (ItsTimeZone::FixDirectory(candidate.get()) != candidate.get()) {
+				return false;
+			}
+			candidate.release();
+			return true;
 		}
 
-		void SubtractHours(int hour)
+		static const string& Directory()
 		{
-			this->m_tm.tm_hour -= hour;
-
-			mktime(&this->m_tm);
+			static const string defaultDirectory("/usr/share/zoneinfo");
+			return *ItsTimeZone::FixDirectory(&defaultDirectory);
 		}
 
-		void SubtractMinutes(int min)
+		//
+		// Loads name (for example "Europe/Oslo") from Directory(), or returns the cached zone.
+		//
+		static bool Load(std::string_view name, ItsTimeZone* timeZone)
 		{
-			this->m_tm.tm_min -= min;
+			if (timeZone == nullptr || !ItsTimeZone::IsValidName(name)) {
+				return false;
+			}
+			const Zone* cached = ItsTimeZone::Lookup(name);
+			if (cached != nullptr) {
+				*timeZone = ItsTimeZone(cached);
+				return true;
+			}
 
-			mktime(&this->m_tm);
+			std::ifstream file(ItsTimeZone::Directory() + "/" + string(name), std::ios::binary);
+			if (!file) {
+				return false;
+			}
+			vector<uint8_t> data;
+			char buffer[4096];
+			while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0)
+			{
+				data.insert(data.end(), buffer, buffer + file.gcount());
+				if (data.size() > MaxFileSize) {
+					return false;
+				}
+			}
+			return ItsTimeZone::Load(name, data.data(), data.size(), timeZone);
 		}
 
-		void SubtractSeconds(int sec)
+		//
+		// Registers an embedded TZif image under name; a zone already loaded under name is reused.
+		//
+		static bool Load(std::string_view name, const uint8_t* data, size_t size, ItsTimeZone* timeZone)
 		{
-			this->m_tm.tm_sec -= sec;
+			if (timeZone == nullptr || data == nullptr || name.empty()) {
+				return false;
+			}
+			const Zone* cached = ItsTimeZone::Lookup(name);
+			if (cached != nullptr) {
+				*timeZone = ItsTimeZone(cached);
+				return true;
+			}
 
-			mktime(&this->m_tm);
+			auto zone = std::make_unique<Zone>();
+			zone->Name = string(name);
+			if (!ItsTimeZone::Parse(data, size, *zone)) {
+				return false;
+			}
+			*timeZone = ItsTimeZone(ItsTimeZone::Register(zone.release()));
+			return true;
 		}
 
-		void Subtract(int year, int month, int day, int hour, int min, int sec)
+		static ItsTimeZone Find(const wstring& name)
 		{
-			this->m_tm.tm_year -= year;
-			this->m_tm.tm_mon -= month;
-			this->m_tm.tm_mday -= day;
-			this->m_tm.tm_hour -= hour;
-			this->m_tm.tm_min -= min;
-			this->m_tm.tm_sec -= sec;
-
-			mktime(&this->m_tm);
+			string narrow;
+			for (wchar_t c : name) {
+				narrow += (c < 128) ? static_cast<char>(c) : '?';
+			}
+			ItsTimeZone timeZone;
+			if (!ItsTimeZone::Load(narrow, &timeZone)) {
+				throw std::invalid_argument("ItsTimeZone: unknown or malformed time zone");
+			}
+			return timeZone;
 		}
 
-		int GetYear()
+		std::string_view Name() const
 		{
-			return this->m_tm.tm_year + 1900;
+			return (this->m_zone != nullptr) ? std::string_view(this->m_zone->Name) : std::string_view("UTC");
 		}
 
-		int GetMonth()
+		//
+		// Seconds east of UTC at the instant.
+		//
+		int32_t OffsetAt(const ItsDateTime& dateTime) const
 		{
-			return this->m_tm.tm_mon + 1;
+			return this->TypeAt(ItsTimeZone::FloorSeconds(dateTime.UnixNanoseconds())).Offset;
 		}
 
-		int GetDay()
+		bool IsDaylightSavingTime(const ItsDateTime& dateTime) const
 		{
-			return this->m_tm.tm_mday;
+			return this->TypeAt(ItsTimeZone::FloorSeconds(dateTime.UnixNanoseconds())).IsDst;
 		}
 
-		int GetHour()
+		//
+		// For example "CET" or "CEST".
+		//
+		std::string_view Abbreviation(const ItsDateTime& dateTime) const
 		{
-			return this->m_tm.tm_hour;
+			if (this->m_zone == nullptr) {
+				return "UTC";
+			}
+			return std::string_view(this->m_zone->Abbreviations.c_str() + this->TypeAt(ItsTimeZone::FloorSeconds(dateTime.UnixNanoseconds())).Abbreviation);
 		}
 
-		int GetMinute()
+		//
+		// Same instant with this zone's offset.
+		//
+		ItsDateTime ToLocal(const ItsDateTime& dateTime) const
 		{
-			return this->m_tm.tm_min;
+			return dateTime.ToOffset(this->OffsetAt(dateTime));
 		}
 
-		int GetSecond()
+		//
+		// Wall clock time in this zone. In a fold the earlier instant is used; a time in a gap
+		// is moved forward by the gap (02:30 on a spring-forward night becomes 03:30).
+		//
+		ItsDateTime FromLocal(int year, int month, int day, int hour = 0, int minute = 0, int second = 0, int nanosecond = 0) const
 		{
-			return this->m_tm.tm_sec;
+			int64_t wall = ItsDateTime(year, month, day, hour, minute, second, nanosecond).UnixNanoseconds();
+			int64_t wallSeconds = ItsTimeZone::FloorSeconds(wall);
+			int64_t fraction = wall - wallSeconds * 1'000'000'000LL;
+
+			int32_t before = this->TypeAt(wallSeconds - 2 * 86'400).Offset;
+			int32_t after = this->TypeAt(wallSeconds + 2 * 86'400).Offset;
+			int64_t utc = wallSeconds - before;
+			if (this->TypeAt(utc).Offset != before && this->TypeAt(wallSeconds - after).Offset == after) {
+				utc = wallSeconds - after;
+			}
+			return ItsDateTime::FromUnixNanoseconds(utc * 1'000'000'000LL + fraction, this->TypeAt(utc).Offset);
 		}
 
-		ItsDateTime& operator=(const tm& timeDate)
+		ItsDateTime Now(ItsClockMode mode = ItsClockMode::Precise) const
 		{
-			this->m_tm = timeDate;
-			return *this;
+			return this->ToLocal(ItsDateTime::UtcNow(mode));
 		}
 	};
 
@@ -1321,7 +9284,7 @@ namespace ItSoftware
 	{
 		ItsLogType Type{ ItsLogType::Information };
 		wstring	Description{ L"" };
-		tm When{ 0 };
+		ItsDateTime When;
 
 		wstring ToString()
 		{
@@ -1335,7 +9298,7 @@ namespace ItSoftware
 			auto description = ItsString::Replace(this->Description, nl1, rep_nl);
 			description = ItsString::Replace(description, nl2, rep_nl);
 			description = ItsString::Replace(description, s1, rep_s);
-			ss << L"Type=" << ItsLogUtil::LogTypeToString(this->Type) << L" " << L"When=" << ItsDateTime(this->When).ToString(L"s") << L" " << L"Description=" << description;
+			ss << L"Type=" << ItsLogUtil::LogTypeToString(this->Type) << L" " << L"When=" << this->When.ToString(L"s") << L" " << L"Description=" << description;
 
 			wstring retVal = ss.str();
 			return retVal;
@@ -1428,7 +9391,7 @@ namespace ItSoftware
 		void LogInformation(const wstring& description)
 		{
 			ItsLogItem item;
-			item.When = ItsDateTime::Now().TM();
+			item.When = ItsDateTime::Now(ItsClockMode::Coarse);
 			item.Description = description;
 			item.Type = ItsLogType::Information;
 
@@ -1442,7 +9405,7 @@ namespace ItSoftware
 		void LogWarning(const wstring& description)
 		{
 			ItsLogItem item;
-			item.When = ItsDateTime::Now().TM();
+			item.When = ItsDateTime::Now(ItsClockMode::Coarse);
 			item.Description = description;
 			item.Type = ItsLogType::Warning;
 
@@ -1456,7 +9419,7 @@ namespace ItSoftware
 		void LogError(const wstring& description)
 		{
 			ItsLogItem item;
-			item.When = ItsDateTime::Now().TM();
+			item.When = ItsDateTime::Now(ItsClockMode::Coarse);
 			item.Description = description;
 			item.Type = ItsLogType::Error;
 
@@ -1470,7 +9433,7 @@ namespace ItSoftware
 		void LogOther(const wstring& description)
 		{
 			ItsLogItem item;
-			item.When = ItsDateTime::Now().TM();
+			item.When = ItsDateTime::Now(ItsClockMode::Coarse);
 			item.Description = description;
 			item.Type = ItsLogType::Other;
 
@@ -1484,7 +9447,7 @@ namespace ItSoftware
 		void LogDebug(const wstring& description)
 		{
 			ItsLogItem item;
-			item.When = ItsDateTime::Now().TM();
+			item.When = ItsDateTime::Now(ItsClockMode::Coarse);
 			item.Description = description;
 			item.Type = ItsLogType::Debug;
 
@@ -1565,58 +9528,391 @@ namespace ItSoftware
 	//
 	struct ItsID
 	{
+	private:
+		struct Alphabet
+		{
+			std::string_view Chars;
+			size_t PerDraw;
+		};
+
+		//
+		// Characters taken from one 64 bit draw. Each multiply-shift extraction keeps the rest
+		// of the product as the next draw; capping at 2^40 leaves at least 24 bits of slack.
+		//
+		static constexpr size_t CharsPerDraw(uint64_t size)
+		{
+			size_t k = 0;
+			for (uint64_t p = size; p <= (1ull << 40); p *= size) {
+				k++;
+			}
+			return k;
+		}
+
+		static const Alphabet& GetAlphabet(ItsCreateIDOptions options, bool includeNumbers)
+		{
+			static constexpr std::string_view dataMin = "abcdefghijklmnopqrstuvwxyz";
+			static constexpr std::string_view dataMaj = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+			static constexpr std::string_view dataMinMaj = "aAbBcCdDeEfFgGhHiIjJkKlLmMnNoOpPqQrRsStTuUvVwWxXyYzZ";
+			static constexpr std::string_view dataMinNum = "a0b1c2d3e4f5g6h7i8j9k0l1m2n3o4p5q6r7s8t9u0v1w2x3y4z5";
+			static constexpr std::string_view dataMajNum = "A0B1C2D3E4F5G6H7I8J9K0L1M2N3O4P5Q6R7S8T9U0V1W2X3Y4Z5";
+			static constexpr std::string_view dataMinMajNum = "aA0bB1cC2dD3eE4fF5gG6hH7iI8jJ9kK0lL1mM2nN3oO4pP5qQ6rR7sS8tT9uU0vV1wW2xX3yY4zZ5";
+			static constexpr Alphabet alphabets[] = {
+				{ dataMin, CharsPerDraw(dataMin.size()) },
+				{ dataMinNum, CharsPerDraw(dataMinNum.size()) },
+				{ dataMaj, CharsPerDraw(dataMaj.size()) },
+				{ dataMajNum, CharsPerDraw(dataMajNum.size()) },
+				{ dataMinMaj, CharsPerDraw(dataMinMaj.size()) },
+				{ dataMinMajNum, CharsPerDraw(dataMinMajNum.size()) }
+			};
+			return alphabets[static_cast<size_t>(options) * 2 + (includeNumbers ? 1 : 0)];
+		}
+
+		//
+		// Pulls characters from the per-thread generator, several per 64 bit draw.
+		//
+		class Extractor
+		{
+		private:
+			const Alphabet& m_alphabet;
+			ItsXoshiro256& m_gen;
+			uint64_t m_word{ 0 };
+			size_t m_left{ 0 };
+
+		public:
+			explicit Extractor(const Alphabet& alphabet)
+				: m_alphabet(alphabet), m_gen(ItsRandomEngine<ItsXoshiro256>())
+			{
+			}
+
+			template<typename Char>
+			void Fill(Char* out, size_t count)
+			{
+				const uint64_t size = this->m_alphabet.Chars.size();
+				for (size_t i = 0; i < count; i++)
+				{
+					if (this->m_left == 0) {
+						this->m_word = this->m_gen();
+						this->m_left = this->m_alphabet.PerDraw;
+					}
+					ItsUInt128 p = ItsUInt128::Multiply(this->m_word, size);
+					out[i] = static_cast<Char>(this->m_alphabet.Chars[p.High]);
+					this->m_word = p.Low;
+					this->m_left--;
+				}
+			}
+		};
+
+		//
+		// Milliseconds since the Unix epoch.
+		//
+		static uint64_t UnixMilliseconds()
+		{
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+		}
+
+		//
+		// Per-thread state for ULID and UUIDv7: last millisecond and the counter/random bits.
+		//
+		struct TimeOrderedState
+		{
+			uint64_t Time{ 0 };
+			uint64_t High{ 0 };
+			uint64_t Low{ 0 };
+		};
+
+		//
+		// Per-thread Snowflake state. Each thread owns one of 32 slots; slot 0 is shared by
+		// threads that find no free slot and is advanced with a CAS.
+		//
+		struct SnowflakeState
+		{
+			static constexpr int SlotCount = 32;
+			static constexpr uint64_t SequenceMask = 0x7F;
+
+			int Slot{ 0 };
+			uint64_t Time{ 0 };
+			uint64_t Sequence{ 0 };
+
+			static std::atomic<uint32_t>& Slots()
+			{
+				static std::atomic<uint32_t> slots{ 1 };
+				return slots;
+			}
+
+			static std::array<std::atomic<uint64_t>, SlotCount>& LastTime()
+			{
+				static std::array<std::atomic<uint64_t>, SlotCount> lastTime{};
+				return lastTime;
+			}
+
+			SnowflakeState()
+			{
+				uint32_t used = SnowflakeState::Slots().load();
+				while (used != 0xFFFFFFFFu)
+				{
+					int slot = std::countr_one(used);
+					if (SnowflakeState::Slots().compare_exchange_weak(used, used | (1u << slot)))
+					{
+						// Resume after the previous owner so its last IDs are never repeated.
+						this->Slot = slot;
+						this->Time = SnowflakeState::LastTime()[slot].load();
+						this->Sequence = SequenceMask;
+						break;
+					}
+				}
+			}
+
+			~SnowflakeState()
+			{
+				if (this->Slot != 0) {
+					SnowflakeState::LastTime()[this->Slot].store(this->Time);
+					SnowflakeState::Slots().fetch_and(~(1u << this->Slot));
+				}
+			}
+		};
+
+		static std::atomic<uint64_t>& SnowflakeWorker()
+		{
+			static std::atomic<uint64_t> worker{ 0 };
+			return worker;
+		}
+
+		static constexpr std::string_view Crockford = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+
 	public:
-		static wstring CreateID(size_t count, ItsCreateIDOptions options, bool includeNumbers)
+		//
+		// Fills out with random characters from the selected alphabet.
+		//
+		template<typename Char>
+		static void CreateID(std::span<Char> out, ItsCreateIDOptions options, bool includeNumbers)
+		{
+			Extractor(ItsID::GetAlphabet(options, includeNumbers)).Fill(out.data(), out.size());
+		}
+
+		//
+		// String of count characters (16 if count is 0). String may be wstring or string.
+		//
+		template<typename String = wstring>
+		static String CreateID(size_t count, ItsCreateIDOptions options, bool includeNumbers)
+		{
+			if (count == 0)
+			{
+				count = 16;
+			}
+
+			String id(count, typename String::value_type{});
+			ItsID::CreateID(std::span<typename String::value_type>(id.data(), id.size()), options, includeNumbers);
+			return id;
+		}
+
+		//
+		// Fixed size ID without heap allocation.
+		//
+		template<size_t N, typename Char = char>
+		static std::array<Char, N> CreateFixedID(ItsCreateIDOptions options, bool includeNumbers)
+		{
+			std::array<Char, N> id{};
+			ItsID::CreateID(std::span<Char>(id), options, includeNumbers);
+			return id;
+		}
+
+		//
+		// Fills every element of out with an ID of count characters, sharing draws between IDs.
+		//
+		template<typename String>
+		static void CreateIDs(size_t count, std::span<String> out, ItsCreateIDOptions options, bool includeNumbers)
 		{
 			if (count == 0)
 			{
 				count = 16;
 			}
 
-			wstring dataMin = L"abcdefghijklmnopqrstuvwxyz";
-			wstring dataMaj = L"ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-			wstring dataMinMaj = L"aAbBcCdDeEfFgGhHiIjJkKlLmMnNoOpPqQrRsStTuUvVwWxXyYzZ";
-			wstring dataMinNum = L"a0b1c2d3e4f5g6h7i8j9k0l1m2n3o4p5q6r7s8t9u0v1w2x3y4z5";
-			wstring dataMajNum = L"A0B1C2D3E4F5G6G7I8J9K0L1M2N3O4P5Q6R7S8T9U0V1W2X3Y4Z5";
-			wstring dataMinMajNum = L"aA0bB1cC2dD3eE4fF5gG6hH7iI8jJ9kK0lL1mM2nN3oO4pP5qQ6rR7sS8tT9uU0vV1wW2xX3yY4zZ5";
+			Extractor extractor(ItsID::GetAlphabet(options, includeNumbers));
+			for (auto& id : out)
+			{
+				id.resize(count);
+				extractor.Fill(id.data(), count);
+			}
+		}
+
+		//
+		// Snowflake layout: 41 bit milliseconds since SnowflakeEpoch | 10 bit worker | 5 bit thread slot | 7 bit sequence.
+		//
+		static constexpr uint64_t SnowflakeEpoch = 1577836800000;	// 2020-01-01T00:00:00Z
+
+		//
+		// ULID as 16 big-endian bytes: 48 bit Unix milliseconds then 80 random bits.
+		// Within a millisecond the random part is incremented, so IDs are strictly
+		// increasing per thread; on overflow the time borrows the next millisecond.
+		//
+		static std::array<uint8_t, 16> CreateULIDBinary()
+		{
+			thread_local static TimeOrderedState state;
+			auto& gen = ItsRandomEngine<ItsXoshiro256>();
+
+			uint64_t now = ItsID::UnixMilliseconds();
+			if (now > state.Time)
+			{
+				state.Time = now;
+				state.High = gen() & 0x7FFF;	// Top bit clear leaves room to increment.
+				state.Low = gen();
+			}
+			else if (++state.Low == 0 && ++state.High > 0xFFFF)
+			{
+				state.Time++;
+				state.High = gen() & 0x7FFF;
+				state.Low = gen();
+			}
 
-			wstring data = dataMin;
-			if (options == ItsCreateIDOptions::LowerAndUpperCase && includeNumbers)
+			std::array<uint8_t, 16> bytes{};
+			uint64_t high = (state.Time << 16) | state.High;
+			for (int i = 0; i < 8; i++)
 			{
-				data = dataMinMajNum;
+				bytes[i] = static_cast<uint8_t>(high >> (56 - i * 8));
+				bytes[8 + i] = static_cast<uint8_t>(state.Low >> (56 - i * 8));
 			}
-			if (options == ItsCreateIDOptions::LowerAndUpperCase && !includeNumbers)
+			return bytes;
+		}
+
+		//
+		// ULID in its 26 character Crockford base32 form.
+		//
+		template<typename String = wstring>
+		static String CreateULID()
+		{
+			auto bytes = ItsID::CreateULIDBinary();
+			uint64_t high = 0;
+			uint64_t low = 0;
+			for (int i = 0; i < 8; i++)
 			{
-				data = dataMinMaj;
+				high = (high << 8) | bytes[i];
+				low = (low << 8) | bytes[8 + i];
 			}
-			else if (options == ItsCreateIDOptions::LowerCase && includeNumbers)
+
+			String ulid(26, typename String::value_type{});
+			for (int i = 25; i >= 0; i--)
 			{
-				data = dataMinNum;
+				ulid[i] = static_cast<typename String::value_type>(ItsID::Crockford[low & 0x1F]);
+				low = (low >> 5) | (high << 59);
+				high >>= 5;
 			}
-			else if (options == ItsCreateIDOptions::LowerCase && !includeNumbers)
+			return ulid;
+		}
+
+		//
+		// UUIDv7 (RFC 9562) as 16 big-endian bytes. rand_a and the top 30 bits of rand_b form
+		// a per-thread counter seeded randomly each millisecond; the last 32 bits are random.
+		//
+		static std::array<uint8_t, 16> CreateUUIDv7Binary()
+		{
+			thread_local static TimeOrderedState state;
+			auto& gen = ItsRandomEngine<ItsXoshiro256>();
+
+			const uint64_t counterMask = (1ull << 42) - 1;
+			uint64_t now = ItsID::UnixMilliseconds();
+			if (now > state.Time)
 			{
-				data = dataMin;
+				state.Time = now;
+				state.High = gen() & (counterMask >> 1);
 			}
-			else if (options == ItsCreateIDOptions::UpperCase && includeNumbers)
+			else if (++state.High > counterMask)
 			{
-				data = dataMajNum;
+				state.Time++;
+				state.High = gen() & (counterMask >> 1);
 			}
-			else if (options == ItsCreateIDOptions::UpperCase && !includeNumbers)
+
+			uint64_t random = gen();
+			uint64_t high = (state.Time << 16) | 0x7000 | (state.High >> 30);
+			uint64_t low = 0x8000000000000000ull | ((state.High & 0x3FFFFFFF) << 32) | (random & 0xFFFFFFFF);
+			std::array<uint8_t, 16> bytes{};
+			for (int i = 0; i < 8; i++)
 			{
-				data = dataMaj;
+				bytes[i] = static_cast<uint8_t>(high >> (56 - i * 8));
+				bytes[8 + i] = static_cast<uint8_t>(low >> (56 - i * 8));
+			}
+			return bytes;
+		}
+
+		//
+		// UUIDv7 as a GUID whose registry string form matches the RFC byte order.
+		//
+		static GUID CreateUUIDv7()
+		{
+			auto b = ItsID::CreateUUIDv7Binary();
+			GUID guid{};
+			guid.Data1 = (static_cast<unsigned long>(b[0]) << 24) | (static_cast<unsigned long>(b[1]) << 16) | (static_cast<unsigned long>(b[2]) << 8) | b[3];
+			guid.Data2 = static_cast<unsigned short>((b[4] << 8) | b[5]);
+			guid.Data3 = static_cast<unsigned short>((b[6] << 8) | b[7]);
+			for (int i = 0; i < 8; i++) {
+				guid.Data4[i] = b[8 + i];
 			}
+			return guid;
+		}
+
+		static void SetSnowflakeWorker(uint16_t workerId)
+		{
+			ItsID::SnowflakeWorker().store(workerId & 0x3FFu);
+		}
+
+		//
+		// 64 bit Snowflake ID. Strictly increasing per thread and unique across the process
+		// for a given worker id. A thread that exhausts its 128 IDs in a millisecond borrows
+		// the next millisecond rather than waiting.
+		//
+		static uint64_t CreateSnowflake()
+		{
+			thread_local static SnowflakeState state;
 
-			wstringstream id;
-			int i = 0;
-			do
+			uint64_t now = ItsID::UnixMilliseconds() - ItsID::SnowflakeEpoch;
+			uint64_t time = 0;
+			uint64_t sequence = 0;
+			if (state.Slot != 0)
+			{
+				if (now > state.Time) {
+					state.Time = now;
+					state.Sequence = 0;
+				}
+				else if (++state.Sequence > SnowflakeState::SequenceMask) {
+					state.Time++;
+					state.Sequence = 0;
+				}
+				time = state.Time;
+				sequence = state.Sequence;
+			}
+			else
 			{
-				size_t j = ItsRandom<size_t>(0, data.size() - 1);
-				id << data[j];
+				static std::atomic<uint64_t> shared{ 0 };
+				uint64_t current = shared.load();
+				uint64_t next = 0;
+				do
+				{
+					next = std::max(current + 1, now << 7);
+				} while (!shared.compare_exchange_weak(current, next));
+				time = next >> 7;
+				sequence = next & SnowflakeState::SequenceMask;
+			}
 
-			} while (++i < count);
+			return (time << 22) | (ItsID::SnowflakeWorker().load(std::memory_order_relaxed) << 12) | (static_cast<uint64_t>(state.Slot) << 7) | sequence;
+		}
 
-			wstring retVal = id.str();
-			return retVal;
+		//
+		// Unix milliseconds encoded in a Snowflake ID.
+		//
+		static uint64_t SnowflakeTime(uint64_t id)
+		{
+			return (id >> 22) + ItsID::SnowflakeEpoch;
 		}
 	};
 }// namespace ItSoftware
+
+//
+// std::hash for ItsDateTime
+//
+template<>
+struct std::hash<ItSoftware::ItsDateTime>
+{
+	size_t operator()(const ItSoftware::ItsDateTime& dateTime) const noexcept
+	{
+		return dateTime.Hash();
+	}
+};